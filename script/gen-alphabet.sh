@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+set -e
+
+if [[ -z "${1}" || -z "${2}" ]]; then
+  echo "usage: ${0} <alphabet> <min-length> [output.c] [prefix]" >&2
+  exit 1
+fi
+
+# config
+alphabet="${1}"
+min_len="${2}"
+output="${3:-sqids_fixed.c}"
+prefix="${4:-sqids_fixed}"
+
+# fs
+root="$(cd "$(dirname "$(readlink -f "${BASH_SOURCE[0]}")")/.." && pwd)"
+gen="${root}/src/sqids-gen"
+
+if [[ ! -x "${gen}" ]]; then
+  echo "${gen} not found, build the tree first" >&2
+  exit 1
+fi
+
+# generate
+echo "Generating ${prefix} for \"${alphabet}\" (min length ${min_len}) into ${output%.c}.{c,h}" >&2
+"${gen}" -a "${alphabet}" -l "${min_len}" -p "${prefix}" -o "${output}" -H "${output%.c}.h"
+
+# vim:ts=2:sts=2:sw=2:et
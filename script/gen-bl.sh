@@ -18,6 +18,20 @@ for language in "${languages[@]}"; do
   fi
 done
 
+# language masks per word
+declare -A masks
+for language in "${languages[@]}"; do
+  if [[ "${language}" = 'blocklist' ]]; then
+    continue
+  fi
+
+  echo "Collecting ${language}.json" >&2
+
+  while read -r word; do
+    masks["${word}"]="${masks["${word}"]:+${masks["${word}"]} | }SQIDS_BL_${language^^}"
+  done < <(jq -r '.[]' "${tmp}/${language}.json")
+done
+
 # head
 code="/* generated: ${date} */"'
 
@@ -29,54 +43,27 @@ code="/* generated: ${date} */"'
 
 #include "sqids.h"
 
-#ifdef SQIDS_DEFAULT_BLOCKLIST
+/* every default word once, along with the languages it belongs to */
+const sqids_bl_word_t sqids_bl_words[] = {
+#if defined(SQIDS_DEFAULT_BLOCKLIST) && SQIDS_DEFAULT_BLOCKLIST == 1'
 
-#define SQIDS_BL_ADD(bl, s) \
-    if (!sqids_bl_add_tail(bl, s)) { sqids_bl_free(bl); return NULL; }
-'
+# generate, in the order of the combined list - words of no particular
+# language belong to all of them
+echo "Generating sqids_bl_words from blocklist.json" >&2
 
-# generate
-for language in "${languages[@]}"; do
-  if [[ "${language}" = 'blocklist' ]]; then
-    name='all'
-  else
-    name="${language}"
-  fi
-
-  echo "Generating sqids_bl_list_${name} from ${language}.json"
-
-  # shellcheck disable=SC2016
-  code="${code}
-sqids_bl_t *
-sqids_bl_list_${name}(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-"
-
-  while read -r word; do
-    word="${word//\"/\\\"}"
-    word="${word//\\/\\\\}"
-    line=$'\n'"    SQIDS_BL_ADD(result, \"${word}\");"
-    code="${code}${line}"
-  done < <(jq -r '.[]' "${tmp}/${language}.json")
-
-  code="${code}
-
-    return result;
-}
-"
-
-done
+while read -r word; do
+  mask="${masks["${word}"]:-SQIDS_BL_ALL}"
+  word="${word//\\/\\\\}"
+  word="${word//\"/\\\"}"
+  line=$'\n'"    {\"${word}\", ${mask}},"
+  code="${code}${line}"
+done < <(jq -r '.[]' "${tmp}/blocklist.json")
 
 # tail
 code="${code}
-#undef SQIDS_BL_ADD
-
 #endif
+    {NULL, 0},
+};
 
 /* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */"
 
@@ -0,0 +1,184 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ arrow stuff                                                           */
+/*****************************************************************************/
+
+/* test a validity bit (a NULL bitmap means all rows are valid) */
+static inline int
+sqids_arrow_valid(const uint8_t *validity, size_t i)
+{
+    return !validity || (validity[i >> 3] >> (i & 7)) & 1;
+}
+
+/* set or clear a validity bit */
+static inline void
+sqids_arrow_set_valid(uint8_t *validity, size_t i, int valid)
+{
+    if (valid) {
+        validity[i >> 3] |= 1 << (i & 7);
+    } else {
+        validity[i >> 3] &= ~(1 << (i & 7));
+    }
+}
+
+/* data bytes needed to encode a column */
+size_t
+sqids_arrow_encoded_size(sqids_t *sqids, size_t n, const uint8_t *validity,
+    const uint64_t *values)
+{
+    unsigned long long num;
+    size_t i, result;
+
+    for (i = 0, result = 0; i < n; ++i) {
+        if (sqids_arrow_valid(validity, i)) {
+            num = values[i];
+            result += sqids_encoded_len(sqids, 1, &num);
+        }
+    }
+
+    return result;
+}
+
+/* encode a uint64 column into a utf8 column */
+int
+sqids_arrow_encode(sqids_t *sqids, size_t n, const uint8_t *validity,
+    const uint64_t *values, uint8_t *out_validity, int32_t *out_offsets,
+    char *out_data, size_t data_max)
+{
+    char scratch[SQIDS_CANONICAL_MAX + 1], *p;
+    unsigned long long num;
+    size_t i, len, pos;
+    int r;
+
+    out_offsets[0] = 0;
+
+    for (i = 0, pos = 0; i < n; ++i) {
+        if (out_validity) {
+            sqids_arrow_set_valid(out_validity, i,
+                sqids_arrow_valid(validity, i));
+        }
+
+        /* nulls stay empty */
+        if (!sqids_arrow_valid(validity, i)) {
+            out_offsets[i + 1] = pos;
+            continue;
+        }
+
+        num = values[i];
+        len = sqids_encoded_len(sqids, 1, &num);
+
+        if (len > data_max - pos || pos + len > INT32_MAX) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            return -1;
+        }
+
+        /* encode in place when the terminator fits, through scratch
+           space otherwise (the heap for ids padded beyond it) */
+        p = out_data + pos;
+        if (len >= data_max - pos) {
+            p = scratch;
+            if (len > SQIDS_CANONICAL_MAX &&
+                !(p = sqids_mem_alloc(len + 1))) {
+                sqids_errno = SQIDS_ERR_ALLOC;
+                return -1;
+            }
+        }
+
+        r = sqids_encode_buf(sqids, p, 1, &num);
+
+        if (r >= 0 && p != out_data + pos) {
+            memcpy(out_data + pos, p, len);
+        }
+
+        if (p != out_data + pos && p != scratch) {
+            sqids_mem_free(p);
+        }
+
+        if (r < 0) {
+            return -1;
+        }
+
+        pos += len;
+        out_offsets[i + 1] = pos;
+    }
+
+    return 0;
+}
+
+/* decode a utf8 column into a list<uint64> column */
+int
+sqids_arrow_decode(sqids_t *sqids, size_t n, const uint8_t *validity,
+    const int32_t *offsets, const char *data, uint8_t *out_validity,
+    int32_t *out_offsets, uint64_t *out_values, size_t values_max)
+{
+    unsigned long long scratch[SQIDS_CANONICAL_MAX / 2 + 1], *nums;
+    size_t i, len, pos;
+    int j, cnt, err, valid;
+
+    /* per-row failures become nulls, not errors */
+    err = sqids_errno;
+    out_offsets[0] = 0;
+
+    for (i = 0, pos = 0; i < n; ++i) {
+        len = offsets[i + 1] - offsets[i];
+        valid = sqids_arrow_valid(validity, i);
+
+        /* a hash of `len` characters holds at most `len / 2` numbers */
+        if (valid && len / 2 > values_max - pos) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            return -1;
+        }
+
+        /* ids padded beyond canonical ones decode through the heap */
+        nums = scratch;
+        if (valid && len > SQIDS_CANONICAL_MAX &&
+            (len / 2 + 1) * sizeof(*nums) > 0xFFFFFFFFu) {
+            sqids_errno = SQIDS_ERR_OVERFLOW;
+            return -1;
+        }
+
+        if (valid && len > SQIDS_CANONICAL_MAX &&
+            !(nums = sqids_mem_alloc((len / 2 + 1) * sizeof(*nums)))) {
+            sqids_errno = SQIDS_ERR_ALLOC;
+            return -1;
+        }
+
+        /* nulls, invalid and overflowing hashes become nulls */
+        cnt = -1;
+        if (valid) {
+            cnt = sqids_decode_len(sqids, data + offsets[i], len, nums,
+                len / 2 + 1);
+        }
+
+        if (out_validity) {
+            sqids_arrow_set_valid(out_validity, i, cnt >= 0);
+        }
+
+        for (j = 0; j < cnt; ++j) {
+            out_values[pos++] = nums[j];
+        }
+
+        if (nums != scratch) {
+            sqids_mem_free(nums);
+        }
+
+        out_offsets[i + 1] = pos;
+    }
+
+    sqids_errno = err;
+
+    return 0;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
@@ -0,0 +1,359 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define SQIDS_BATCH_X86 1
+#endif
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ batch stuff                                                           */
+/*****************************************************************************/
+
+/* vector lanes only take numbers below 2^32, which have at most 32 digits */
+#define SQIDS_BATCH_DIGITS_MAX 32
+
+/* lookup tables shared by the kernels */
+struct sqids_batch_ctx_s {
+    sqids_t *sqids;
+    int len;
+    int32_t *offsets;   /* number % len -> offset */
+    int32_t *wide;      /* the alphabet, twice */
+};
+typedef struct sqids_batch_ctx_s sqids_batch_ctx_t;
+
+/* a group of lanes, digits least significant first */
+struct sqids_batch_group_s {
+    int32_t offset[8];
+    int32_t digits[8];
+    int32_t chars[SQIDS_BATCH_DIGITS_MAX][8];
+};
+typedef struct sqids_batch_group_s sqids_batch_group_t;
+
+/* encode a single number the regular way */
+static inline int
+sqids_batch_scalar(sqids_t *sqids, char *dst, unsigned long long num)
+{
+    return sqids_encode_buf(sqids, dst, 1, &num) < 0 ? -1 : 0;
+}
+
+/* write out a group of lanes computed by a kernel */
+static int
+sqids_batch_emit(sqids_batch_ctx_t *ctx, sqids_batch_group_t *group,
+    int lanes, const unsigned long long *nums, char *out, size_t stride)
+{
+    sqids_t *sqids = ctx->sqids;
+    int lane, k, offset;
+    char *dst, *p;
+
+    for (lane = 0; lane < lanes; ++lane) {
+        dst = out + lane * stride;
+        offset = group->offset[lane];
+
+        /* prefix, then the digits most significant first */
+        p = dst;
+        *p++ = sqids->alphabet[offset];
+        for (k = group->digits[lane] - 1; k >= 0; --k) {
+            *p++ = group->chars[k][lane];
+        }
+
+        /* precomputed padding, or the regular path when there's none */
+        if (p - dst < sqids->min_len) {
+            if (!sqids->pad_depth) {
+                if (sqids_batch_scalar(sqids, dst, nums[lane]) != 0) {
+                    return -1;
+                }
+
+                continue;
+            }
+
+            memcpy(p, sqids->pad + (size_t)offset * sqids->min_len,
+                sqids->min_len - (p - dst));
+            p = dst + sqids->min_len;
+        }
+
+        *p = 0;
+
+        /* blocked words are retried the regular way */
+        if (sqids->blocklist && sqids_blocked(sqids, dst)) {
+            if (sqids_batch_scalar(sqids, dst, nums[lane]) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+#ifdef SQIDS_BATCH_X86
+
+/* 2^52 as a double - or'ing a 32-bit integer into its mantissa converts it */
+#define SQIDS_BATCH_MAGIC 0x4330000000000000ull
+
+/* AVX-512 kernel: 8 numbers below 2^32 per step, divisions by the base go
+   through a double reciprocal, corrected by one step either way */
+__attribute__((target("avx512f")))
+static size_t
+sqids_batch_avx512(sqids_batch_ctx_t *ctx, size_t n,
+    const unsigned long long *nums, char *out, size_t stride)
+{
+    sqids_batch_group_t group;
+    __m512i v, q, r, idx, base, lim, magic, len, b, zero, one, digits;
+    __m512d inv_len, inv_b, magic_d, d;
+    __mmask8 active, lt, ge;
+    size_t i;
+    int k;
+
+    lim = _mm512_set1_epi64(0xFFFFFFFFull);
+    magic = _mm512_set1_epi64(SQIDS_BATCH_MAGIC);
+    magic_d = _mm512_castsi512_pd(magic);
+    len = _mm512_set1_epi64(ctx->len);
+    b = _mm512_set1_epi64(ctx->len - 1);
+    inv_len = _mm512_set1_pd(1.0 / ctx->len);
+    inv_b = _mm512_set1_pd(1.0 / (ctx->len - 1));
+    zero = _mm512_setzero_si512();
+    one = _mm512_set1_epi64(1);
+
+/* q = v / divisor, r = v % divisor */
+#define SQIDS_BATCH_DIVMOD512(v, divisor, inv) do { \
+        d = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512((v), magic)), \
+            magic_d); \
+        d = _mm512_add_pd(_mm512_mul_pd(d, (inv)), magic_d); \
+        q = _mm512_sub_epi64(_mm512_castpd_si512(d), magic); \
+        r = _mm512_sub_epi64((v), _mm512_mul_epu32(q, (divisor))); \
+        lt = _mm512_cmplt_epi64_mask(r, zero); \
+        q = _mm512_mask_sub_epi64(q, lt, q, one); \
+        r = _mm512_mask_add_epi64(r, lt, r, (divisor)); \
+        ge = _mm512_cmpge_epi64_mask(r, (divisor)); \
+        q = _mm512_mask_add_epi64(q, ge, q, one); \
+        r = _mm512_mask_sub_epi64(r, ge, r, (divisor)); \
+    } while (0)
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        v = _mm512_loadu_si512((const void *)(nums + i));
+
+        /* wide numbers take the regular path */
+        if (_mm512_cmpgt_epu64_mask(v, lim)) {
+            break;
+        }
+
+        /* offset = (alphabet[v % len] + 1) % len */
+        SQIDS_BATCH_DIVMOD512(v, len, inv_len);
+        base = _mm512_cvtepi32_epi64(_mm512_i64gather_epi32(r, ctx->offsets,
+            4));
+        _mm256_storeu_si256((__m256i *)group.offset,
+            _mm512_cvtepi64_epi32(base));
+        base = _mm512_add_epi64(base, _mm512_set1_epi64(ctx->len - 2));
+
+        /* digits, least significant first: digit `d` is the character at
+           `offset + len - 2 - d` in the doubled alphabet */
+        digits = zero;
+        active = 0xFF;
+        for (k = 0; active; ++k) {
+            SQIDS_BATCH_DIVMOD512(v, b, inv_b);
+            idx = _mm512_sub_epi64(base, r);
+            _mm256_storeu_si256((__m256i *)group.chars[k],
+                _mm512_i64gather_epi32(idx, ctx->wide, 4));
+            digits = _mm512_mask_add_epi64(digits, active, digits, one);
+            v = q;
+            active = _mm512_cmpneq_epi64_mask(v, zero);
+        }
+        _mm256_storeu_si256((__m256i *)group.digits,
+            _mm512_cvtepi64_epi32(digits));
+
+        if (sqids_batch_emit(ctx, &group, 8, nums + i, out + i * stride,
+            stride) != 0) {
+            return (size_t)-1;
+        }
+    }
+
+#undef SQIDS_BATCH_DIVMOD512
+
+    return i;
+}
+
+/* AVX2 kernel: the same, 4 numbers per step */
+__attribute__((target("avx2")))
+static size_t
+sqids_batch_avx2(sqids_batch_ctx_t *ctx, size_t n,
+    const unsigned long long *nums, char *out, size_t stride)
+{
+    sqids_batch_group_t group;
+    __m256i v, q, r, idx, base, magic, len, b, zero, one, digits, active;
+    __m256i lt, ge, pack;
+    __m256d inv_len, inv_b, magic_d, d;
+    size_t i;
+    int k;
+
+    magic = _mm256_set1_epi64x(SQIDS_BATCH_MAGIC);
+    magic_d = _mm256_castsi256_pd(magic);
+    len = _mm256_set1_epi64x(ctx->len);
+    b = _mm256_set1_epi64x(ctx->len - 1);
+    inv_len = _mm256_set1_pd(1.0 / ctx->len);
+    inv_b = _mm256_set1_pd(1.0 / (ctx->len - 1));
+    zero = _mm256_setzero_si256();
+    one = _mm256_set1_epi64x(1);
+    pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+/* q = v / divisor, r = v % divisor */
+#define SQIDS_BATCH_DIVMOD256(v, divisor, inv) do { \
+        d = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256((v), magic)), \
+            magic_d); \
+        d = _mm256_add_pd(_mm256_mul_pd(d, (inv)), magic_d); \
+        q = _mm256_sub_epi64(_mm256_castpd_si256(d), magic); \
+        r = _mm256_sub_epi64((v), _mm256_mul_epu32(q, (divisor))); \
+        lt = _mm256_cmpgt_epi64(zero, r); \
+        q = _mm256_add_epi64(q, lt); \
+        r = _mm256_add_epi64(r, _mm256_and_si256(lt, (divisor))); \
+        ge = _mm256_cmpgt_epi64(r, _mm256_sub_epi64((divisor), one)); \
+        q = _mm256_sub_epi64(q, ge); \
+        r = _mm256_sub_epi64(r, _mm256_and_si256(ge, (divisor))); \
+    } while (0)
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        v = _mm256_loadu_si256((const __m256i *)(nums + i));
+
+        /* wide numbers take the regular path */
+        if (!_mm256_testz_si256(_mm256_srli_epi64(v, 32),
+            _mm256_set1_epi64x(0xFFFFFFFFull))) {
+            break;
+        }
+
+        /* offset = (alphabet[v % len] + 1) % len */
+        SQIDS_BATCH_DIVMOD256(v, len, inv_len);
+        base = _mm256_cvtepi32_epi64(_mm256_i64gather_epi32(ctx->offsets, r,
+            4));
+        _mm_storeu_si128((__m128i *)group.offset, _mm256_castsi256_si128(
+            _mm256_permutevar8x32_epi32(base, pack)));
+        base = _mm256_add_epi64(base, _mm256_set1_epi64x(ctx->len - 2));
+
+        /* digits, least significant first */
+        digits = zero;
+        active = _mm256_set1_epi64x(-1);
+        for (k = 0; !_mm256_testz_si256(active, active); ++k) {
+            SQIDS_BATCH_DIVMOD256(v, b, inv_b);
+            idx = _mm256_sub_epi64(base, r);
+            _mm_storeu_si128((__m128i *)group.chars[k],
+                _mm256_i64gather_epi32(ctx->wide, idx, 4));
+            digits = _mm256_sub_epi64(digits, active);
+            v = q;
+            active = _mm256_xor_si256(_mm256_cmpeq_epi64(v, zero),
+                _mm256_set1_epi64x(-1));
+        }
+        _mm_storeu_si128((__m128i *)group.digits, _mm256_castsi256_si128(
+            _mm256_permutevar8x32_epi32(digits, pack)));
+
+        if (sqids_batch_emit(ctx, &group, 4, nums + i, out + i * stride,
+            stride) != 0) {
+            return (size_t)-1;
+        }
+    }
+
+#undef SQIDS_BATCH_DIVMOD256
+
+    return i;
+}
+
+#endif
+
+/* kernel signature - returns how many numbers were handled */
+typedef size_t (*sqids_batch_kernel_t)(sqids_batch_ctx_t *, size_t,
+    const unsigned long long *, char *, size_t);
+
+/* pick the widest kernel the cpu supports */
+static sqids_batch_kernel_t
+sqids_batch_kernel(void)
+{
+#ifdef SQIDS_BATCH_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+        return sqids_batch_avx512;
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        return sqids_batch_avx2;
+    }
+#endif
+
+    return NULL;
+}
+
+/* encode single numbers into fixed-size slots */
+int
+sqids_encode_batch(sqids_t *sqids, size_t n, const unsigned long long *nums,
+    char *out, size_t stride)
+{
+    static sqids_batch_kernel_t kernel;
+    static int kernel_init;
+    sqids_batch_kernel_t fn;
+    sqids_batch_ctx_t ctx;
+    unsigned long long max = ~0ull;
+    size_t i, done;
+    int j, len = sqids->len;
+
+    /* every slot must fit the longest possible id */
+    if (stride < sqids_encoded_len(sqids, 1, &max) + 1) {
+        sqids_errno = SQIDS_ERR_NOSPACE;
+        return -1;
+    }
+
+    /* runtime dispatch, resolved once */
+    if (!__atomic_load_n(&kernel_init, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&kernel, sqids_batch_kernel(), __ATOMIC_RELAXED);
+        __atomic_store_n(&kernel_init, 1, __ATOMIC_RELEASE);
+    }
+
+    fn = __atomic_load_n(&kernel, __ATOMIC_RELAXED);
+
+    /* kernels bypass the counters, and assume a plain ascii alphabet */
+    for (j = 0; j < len && sqids->alphabet[j] >= 0; ++j) {}
+
+    if (j < len || sqids->stats) {
+        fn = NULL;
+    }
+
+    int32_t offsets[len], wide[2 * len];
+    ctx.sqids = sqids;
+    ctx.len = len;
+    ctx.offsets = offsets;
+    ctx.wide = wide;
+
+    for (j = 0; fn && j < len; ++j) {
+        offsets[j] = (sqids->alphabet[j] + 1) % len;
+        wide[j] = wide[j + len] = sqids->alphabet[j];
+    }
+
+    for (i = 0; i < n;) {
+        if (fn) {
+            if ((done = fn(&ctx, n - i, nums + i, out + i * stride,
+                stride)) == (size_t)-1) {
+                return -1;
+            }
+
+            i += done;
+        }
+
+        /* the tail, or a group with wide numbers, one at a time */
+        if (i < n) {
+            if (sqids_batch_scalar(sqids, out + i * stride, nums[i]) != 0) {
+                return -1;
+            }
+
+            ++i;
+        }
+    }
+
+    return 0;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
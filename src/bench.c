@@ -0,0 +1,757 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* pthread_setaffinity_np */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <errno.h>
+#include <pthread.h>
+#ifdef HAVE_LINUX_PERF_EVENT_H
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "sqids.h"
+#include "strerror.h"
+
+/*****************************************************************************/
+/* {{{ histogram stuff                                                       */
+/*****************************************************************************/
+
+/* log-linear buckets, HDR-style: 32 per power of two, so ~3% resolution */
+#define HIST_SUB_BITS   5
+#define HIST_SUB        (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS    ((64 - HIST_SUB_BITS + 1) * HIST_SUB)
+
+struct hist_s {
+    unsigned long long counts[HIST_BUCKETS];
+    unsigned long long total;
+    unsigned long long max;
+};
+typedef struct hist_s hist_t;
+
+static inline unsigned int
+hist_index(unsigned long long v)
+{
+    unsigned int e;
+
+    if (v < HIST_SUB) {
+        return v;
+    }
+
+    e = 63 - __builtin_clzll(v);
+
+    return (e - HIST_SUB_BITS + 1) * HIST_SUB +
+        ((v >> (e - HIST_SUB_BITS)) & (HIST_SUB - 1));
+}
+
+/* the highest value a bucket holds */
+static unsigned long long
+hist_value(unsigned int i)
+{
+    unsigned int e;
+
+    if (i < HIST_SUB) {
+        return i;
+    }
+
+    e = i / HIST_SUB + HIST_SUB_BITS - 1;
+
+    return ((unsigned long long)(HIST_SUB + i % HIST_SUB + 1) <<
+        (e - HIST_SUB_BITS)) - 1;
+}
+
+static inline void
+hist_add(hist_t *hist, unsigned long long v)
+{
+    ++hist->counts[hist_index(v)];
+    ++hist->total;
+    hist->max = v > hist->max ? v : hist->max;
+}
+
+static void
+hist_merge(hist_t *to, const hist_t *from)
+{
+    unsigned int i;
+
+    for (i = 0; i < HIST_BUCKETS; ++i) {
+        to->counts[i] += from->counts[i];
+    }
+
+    to->total += from->total;
+    to->max = from->max > to->max ? from->max : to->max;
+}
+
+/* value at a percentile (0-100) */
+static unsigned long long
+hist_percentile(const hist_t *hist, double p)
+{
+    unsigned long long want, seen = 0;
+    unsigned int i;
+
+    want = (unsigned long long)(hist->total * p / 100.0 + 0.5);
+    want = want ? want : 1;
+
+    for (i = 0; i < HIST_BUCKETS; ++i) {
+        if ((seen += hist->counts[i]) >= want) {
+            return hist_value(i) < hist->max ? hist_value(i) : hist->max;
+        }
+    }
+
+    return hist->max;
+}
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ counter stuff                                                         */
+/*****************************************************************************/
+
+/* hardware counters, each opened on its own so missing ones don't matter */
+#define COUNTER_CYCLES      0
+#define COUNTER_INSTR       1
+#define COUNTER_BRANCH_MISS 2
+#define COUNTER_L1D_MISS    3
+#define COUNTER_LLC_MISS    4
+#define COUNTER_CNT         5
+
+#define COUNTED(mask, i)    (((mask) >> (i)) & 1)
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} counter_defs[COUNTER_CNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+        PERF_COUNT_HW_CACHE_OP_READ << 8 |
+        PERF_COUNT_HW_CACHE_RESULT_MISS << 16},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}
+};
+#endif
+
+/* open the counters of the calling thread, user space only
+   returns a mask of those that opened, and the first error in `err` */
+static unsigned int
+counters_open(int *fds, int *err)
+{
+    unsigned int i, mask = 0;
+
+    *err = 0;
+
+    for (i = 0; i < COUNTER_CNT; ++i) {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = counter_defs[i].type;
+        attr.config = counter_defs[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+            PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        if ((fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1,
+            0)) >= 0) {
+            mask |= 1u << i;
+            continue;
+        }
+
+        *err = *err ? *err : errno;
+#else
+        fds[i] = -1;
+        *err = ENOSYS;
+#endif
+    }
+
+    return mask;
+}
+
+static void
+counters_start(const int *fds, unsigned int mask)
+{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    unsigned int i;
+
+    for (i = 0; i < COUNTER_CNT; ++i) {
+        if (mask & (1u << i)) {
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+/* stop, read and close the counters, scaling those that were multiplexed
+   returns the mask of those that actually counted */
+static unsigned int
+counters_stop(const int *fds, unsigned int mask, unsigned long long *counts)
+{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    unsigned long long val[3];      /* value, time enabled, time running */
+    unsigned int i;
+
+    for (i = 0; i < COUNTER_CNT; ++i) {
+        if (mask & (1u << i)) {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (i = 0; i < COUNTER_CNT; ++i) {
+        if (!(mask & (1u << i))) {
+            continue;
+        }
+
+        if (read(fds[i], val, sizeof(val)) == sizeof(val) && val[2]) {
+            counts[i] = val[2] < val[1] ?
+                (unsigned long long)((double)val[0] * val[1] / val[2]) :
+                val[0];
+        } else {
+            mask &= ~(1u << i);
+        }
+
+        close(fds[i]);
+    }
+
+    return mask;
+#else
+    return 0;
+#endif
+}
+
+/* a counter per operation, or n/a */
+static const char *
+counter_fmt(char *buf, size_t n, int ok, double num, double den)
+{
+    if (!ok || !den) {
+        return "n/a";
+    }
+
+    snprintf(buf, n, "%.2f", num / den);
+
+    return buf;
+}
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ benchmark stuff                                                       */
+/*****************************************************************************/
+
+/* distinct inputs per thread, made up front */
+#define BENCH_POOL 1024
+
+/* what is measured */
+#define BENCH_ENCODE    0
+#define BENCH_DECODE    1
+#define BENCH_BLOCKED   2
+
+/* what every thread does */
+struct bench_s {
+    sqids_t *sqids;
+    unsigned long long ops;
+    unsigned int nums;
+    int op, alloc, pin, counters;
+    int *cpus;
+    unsigned int cpu_cnt;
+    pthread_barrier_t barrier;
+};
+
+/* one thread, kept on cache lines of its own */
+struct worker_s {
+    pthread_t tid;
+    unsigned int id;
+    struct bench_s *bench;
+    unsigned long long start, end;
+    int err;
+    unsigned long long counts[COUNTER_CNT];
+    unsigned int counted;
+    int counters_err;
+    hist_t hist;
+} __attribute__((aligned(64)));
+
+static void
+usage(const char *progname, FILE *out)
+{
+    fputs("\n", out);
+    fputs("Usage:\n", out);
+    fprintf(out, "  %s [options]\n", progname);
+
+    fputs("\n", out);
+    fputs("Options:\n", out);
+    fputs("  -t, --threads             run with 1, 2, 4, ... up to this many "
+        "threads [cpus]\n", out);
+    fputs("  -n, --ops                 set number of operations per thread "
+        "[200000]\n", out);
+    fputs("  -k, --numbers             set number of numbers per id [1]\n",
+        out);
+    fputs("  -d, --decode              decode instead of encode\n", out);
+    fputs("  -x, --blocked             check ids against the blocklist "
+        "instead\n", out);
+    fputs("  -m, --malloc              encode with sqids_encode, allocating "
+        "every id\n", out);
+    fputs("  -s, --stats               enable stats counters\n", out);
+    fputs("  -P, --pin                 pin thread i to the i-th allowed "
+        "cpu\n", out);
+    fputs("  -H, --histogram           print the latency histogram of every "
+        "run\n", out);
+    fputs("  -C, --counters            report hardware counters per "
+        "operation instead\n"
+        "                            of latencies\n", out);
+    fputs("  -a, --alphabet            set alphabet ["
+        SQIDS_DEFAULT_ALPHABET "]\n", out);
+    fputs("  -l, --min-length          set hash minimum length [0]\n", out);
+    fputs("  -b, --default-blocklist   include a default blocklist\n"
+        "                            (de,en,es,fr,hi,it,pt,none,all) "
+        "[all]\n", out);
+    fputs("  -h, --help                print this message and exit\n", out);
+    fputs("  -v, --version             print version information and exit\n",
+        out);
+
+    fputs("\n", out);
+    exit(out == stderr ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+static unsigned long long
+parse_num(const char *s, char **p)
+{
+    int radix = 10;
+
+    if (*s == '0') {
+        radix = 8;
+        ++s;
+
+        if (*s == 'x' || *s == 'X') {
+            radix = 16;
+            ++s;
+        }
+    }
+
+    return strtoull(s, p, radix);
+}
+
+static inline unsigned long long
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* splitmix64, so every thread has its own reproducible numbers */
+static inline unsigned long long
+next_num(unsigned long long *state)
+{
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ull);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+    return z ^ (z >> 31);
+}
+
+static void *
+worker_run(void *arg)
+{
+    struct worker_s *worker = arg;
+    struct bench_s *bench = worker->bench;
+    unsigned long long state = worker->id, *nums, out[32], t, i;
+    size_t offs[BENCH_POOL], len, size = 0, max = 0;
+    char *ids = NULL, *buf = NULL, *s;
+    int fds[COUNTER_CNT], r = 0;
+    unsigned int k;
+
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+    if (bench->pin) {
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(bench->cpus[worker->id % bench->cpu_cnt], &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+
+    /* numbers below 2^40 keep ids the length real ones have, and ids are
+       packed the way they would sit in a buffer of their own */
+    if (!(nums = malloc(BENCH_POOL * bench->nums * sizeof(*nums)))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        r = -1;
+    }
+
+    for (i = 0; r >= 0 && i < BENCH_POOL * bench->nums; ++i) {
+        nums[i] = next_num(&state) >> 24;
+    }
+
+    for (k = 0; r >= 0 && k < BENCH_POOL; ++k) {
+        offs[k] = size;
+        len = sqids_encoded_len(bench->sqids, bench->nums,
+            nums + k * bench->nums);
+        size += len + 1;
+        max = len > max ? len : max;
+    }
+
+    if (r >= 0 && (!(ids = malloc(size)) || !(buf = malloc(max + 1)))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        r = -1;
+    }
+
+    for (k = 0; r >= 0 && k < BENCH_POOL; ++k) {
+        r = sqids_encode_buf(bench->sqids, ids + offs[k], bench->nums,
+            nums + k * bench->nums);
+    }
+
+    if (bench->counters) {
+        worker->counted = counters_open(fds, &worker->counters_err);
+    }
+
+    pthread_barrier_wait(&bench->barrier);
+    counters_start(fds, worker->counted);
+    worker->start = now_ns();
+
+    /* per-op timestamps would show up in the counters, so they go */
+    for (i = 0, k = 0; r >= 0 && i < bench->ops; ++i) {
+        t = bench->counters ? 0 : now_ns();
+
+        switch (bench->op) {
+            case BENCH_DECODE:
+                r = sqids_decode(bench->sqids, ids + offs[k], out, 32);
+                break;
+            case BENCH_BLOCKED:
+                sqids_blocked(bench->sqids, ids + offs[k]);
+                break;
+            default:
+                if (!bench->alloc) {
+                    r = sqids_encode_buf(bench->sqids, buf, bench->nums,
+                        nums + k * bench->nums);
+                } else if ((s = sqids_encode(bench->sqids, bench->nums,
+                    nums + k * bench->nums))) {
+                    sqids_mem_free(s);
+                } else {
+                    r = -1;
+                }
+        }
+
+        if (!bench->counters) {
+            hist_add(&worker->hist, now_ns() - t);
+        }
+
+        k = k + 1 < BENCH_POOL ? k + 1 : 0;
+    }
+
+    worker->end = now_ns();
+    worker->counted = counters_stop(fds, worker->counted, worker->counts);
+    worker->err = r < 0 ? sqids_errno : 0;
+    free(nums);
+    free(ids);
+    free(buf);
+
+    return NULL;
+}
+
+/* a row of counters per operation, for all threads together */
+static void
+bench_counters(struct bench_s *bench, struct worker_s *workers,
+    unsigned int threads, double rate, double base)
+{
+    unsigned long long counts[COUNTER_CNT] = {}, ops;
+    unsigned int mask = ~0u, i, j;
+    char bufs[6][32];
+    int e;
+
+    for (i = 0; i < threads; ++i) {
+        mask &= workers[i].counted;
+        for (j = 0; j < COUNTER_CNT; ++j) {
+            counts[j] += workers[i].counts[j];
+        }
+    }
+
+    /* containers and VMs often have no counters: say so once, carry on */
+    if (!mask && bench->counters == 1) {
+        e = workers[0].counters_err ? workers[0].counters_err : ENOENT;
+        fflush(stdout);
+        fprintf(stderr, "counters: unavailable (%s)%s\n", strerror(e),
+            e == EACCES || e == EPERM ?
+            ", see /proc/sys/kernel/perf_event_paranoid" : "");
+        bench->counters = 2;
+    }
+
+    ops = bench->ops * threads;
+    printf("%7u %12.0f %7.2fx %5.0f%% %6s %10s %10s %10s %10s %10s\n",
+        threads, rate, rate / base, rate / base / threads * 100,
+        counter_fmt(bufs[0], 32, COUNTED(mask, COUNTER_INSTR) &&
+        COUNTED(mask, COUNTER_CYCLES), counts[COUNTER_INSTR],
+        counts[COUNTER_CYCLES]),
+        counter_fmt(bufs[1], 32, COUNTED(mask, COUNTER_CYCLES),
+        counts[COUNTER_CYCLES], ops),
+        counter_fmt(bufs[2], 32, COUNTED(mask, COUNTER_INSTR),
+        counts[COUNTER_INSTR], ops),
+        counter_fmt(bufs[3], 32, COUNTED(mask, COUNTER_BRANCH_MISS),
+        counts[COUNTER_BRANCH_MISS], ops),
+        counter_fmt(bufs[4], 32, COUNTED(mask, COUNTER_L1D_MISS),
+        counts[COUNTER_L1D_MISS], ops),
+        counter_fmt(bufs[5], 32, COUNTED(mask, COUNTER_LLC_MISS),
+        counts[COUNTER_LLC_MISS], ops));
+}
+
+/* run `threads` workers at once, printing a row of the scaling table */
+static int
+bench_run(struct bench_s *bench, unsigned int threads, double *base,
+    int histogram)
+{
+    unsigned long long start = ~0ull, end = 0;
+    struct worker_s *workers;
+    hist_t *all;
+    double rate;
+    unsigned int i;
+    int err = 0;
+
+    if (!(workers = aligned_alloc(64, threads * sizeof(struct worker_s))) ||
+        !(all = calloc(1, sizeof(hist_t)))) {
+        free(workers);
+        fputs("malloc(): out of memory\n", stderr);
+        return -1;
+    }
+
+    memset(workers, 0, threads * sizeof(struct worker_s));
+    pthread_barrier_init(&bench->barrier, NULL, threads);
+
+    for (i = 0; i < threads; ++i) {
+        workers[i].id = i;
+        workers[i].bench = bench;
+        if (pthread_create(&workers[i].tid, NULL, worker_run,
+            &workers[i]) != 0) {
+            fputs("pthread_create(): error\n", stderr);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    for (i = 0; i < threads; ++i) {
+        pthread_join(workers[i].tid, NULL);
+        if (workers[i].err) {
+            fprintf(stderr, "thread %u: %s\n", i,
+                sqids_strerror(workers[i].err));
+            err = -1;
+        }
+        start = workers[i].start < start ? workers[i].start : start;
+        end = workers[i].end > end ? workers[i].end : end;
+        hist_merge(all, &workers[i].hist);
+    }
+
+    pthread_barrier_destroy(&bench->barrier);
+
+    if (!err) {
+        rate = bench->ops * threads * 1e9 / (end - start);
+        *base = *base ? *base : rate;
+
+        if (bench->counters) {
+            bench_counters(bench, workers, threads, rate, *base);
+        } else {
+            printf("%7u %12.0f %7.2fx %5.0f%% %8llu %8llu %8llu %8llu\n",
+                threads, rate, rate / *base, rate / *base / threads * 100,
+                hist_percentile(all, 50), hist_percentile(all, 99),
+                hist_percentile(all, 99.9), all->max);
+        }
+
+        for (i = 0; histogram && i < HIST_BUCKETS; ++i) {
+            if (all->counts[i]) {
+                printf("        %12llu %12llu\n", hist_value(i),
+                    all->counts[i]);
+            }
+        }
+    }
+
+    free(all);
+    free(workers);
+
+    return err;
+}
+
+/* }}}                                                                       */
+
+int
+main(int argc, char **argv)
+{
+    struct bench_s bench;
+    char *alphabet = SQIDS_DEFAULT_ALPHABET, *bl_name = "all", *p;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int min_len = 0, stats = 0, histogram = 0, ch, err = 0;
+    sqids_bl_t *blocklist = NULL;
+    sqids_stats_t snap;
+    unsigned int t, i;
+    double base = 0;
+
+    static const struct option longopts[] = {
+        {"threads", required_argument, NULL, 't'},
+        {"ops", required_argument, NULL, 'n'},
+        {"numbers", required_argument, NULL, 'k'},
+        {"decode", no_argument, NULL, 'd'},
+        {"blocked", no_argument, NULL, 'x'},
+        {"malloc", no_argument, NULL, 'm'},
+        {"stats", no_argument, NULL, 's'},
+        {"pin", no_argument, NULL, 'P'},
+        {"histogram", no_argument, NULL, 'H'},
+        {"counters", no_argument, NULL, 'C'},
+        {"alphabet", required_argument, NULL, 'a'},
+        {"min-length", required_argument, NULL, 'l'},
+        {"default-blocklist", required_argument, NULL, 'b'},
+        {"help", no_argument, NULL, 'h'},
+        {"version", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    memset(&bench, 0, sizeof(bench));
+    bench.ops = 200000;
+    bench.nums = 1;
+    bench.op = BENCH_ENCODE;
+
+    /* parse command line options */
+    while ((ch = getopt_long(argc, argv, "t:n:k:dxmsPHCa:l:b:hv", longopts,
+        NULL)) != -1) {
+        switch (ch) {
+            case 't':
+                threads = parse_num(optarg, &p);
+                err |= p == optarg || *p || threads < 1 || threads > 4096;
+                break;
+            case 'n':
+                bench.ops = parse_num(optarg, &p);
+                err |= p == optarg || *p || !bench.ops;
+                break;
+            case 'k':
+                bench.nums = parse_num(optarg, &p);
+                err |= p == optarg || *p || !bench.nums || bench.nums > 32;
+                break;
+            case 'd':
+                bench.op = BENCH_DECODE;
+                break;
+            case 'x':
+                bench.op = BENCH_BLOCKED;
+                break;
+            case 'm':
+                bench.alloc = 1;
+                break;
+            case 's':
+                stats = 1;
+                break;
+            case 'P':
+                bench.pin = 1;
+                break;
+            case 'H':
+                histogram = 1;
+                break;
+            case 'C':
+                bench.counters = 1;
+                break;
+            case 'a':
+                alphabet = optarg;
+                break;
+            case 'l':
+                min_len = parse_num(optarg, &p);
+                err |= p == optarg || *p;
+                break;
+            case 'b':
+                bl_name = optarg;
+                break;
+            case 'h':
+                usage(argv[0], stdout);
+                break;
+            case 'v':
+                fputs(SQIDS_VERSION_STRING, stdout);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0], stderr);
+        }
+
+        if (err) {
+            fprintf(stderr, "-%c: invalid value \"%s\"\n", ch, optarg);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc) {
+        usage(argv[0], stderr);
+    }
+
+    /* the cpus we may run on, in order */
+    if (bench.pin) {
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+        cpu_set_t set;
+
+        if (sched_getaffinity(0, sizeof(set), &set) != 0 ||
+            !(bench.cpus = malloc(CPU_SETSIZE * sizeof(int)))) {
+            fputs("sched_getaffinity(): error\n", stderr);
+            return EXIT_FAILURE;
+        }
+
+        for (i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &set)) {
+                bench.cpus[bench.cpu_cnt++] = i;
+            }
+        }
+#else
+        fputs("--pin: not supported on this platform\n", stderr);
+        bench.pin = 0;
+#endif
+    }
+
+    if (strcmp(bl_name, "none") != 0 &&
+        !(blocklist = sqids_bl_default(bl_name))) {
+        fprintf(stderr, "sqids_bl_default(%s): %s\n", bl_name,
+            sqids_strerror(sqids_errno));
+        return EXIT_FAILURE;
+    }
+
+    /* one structure, shared by every thread */
+    if (!(bench.sqids = sqids_new(alphabet, min_len, blocklist)) ||
+        (stats && sqids_stats_enable(bench.sqids) != 0)) {
+        fprintf(stderr, "sqids_new(): %s\n", sqids_strerror(sqids_errno));
+        return EXIT_FAILURE;
+    }
+
+    printf("%s: %u numbers per id, min length %d, %llu ops per thread%s%s\n",
+        bench.op == BENCH_DECODE ? "decode" : bench.op == BENCH_BLOCKED ?
+        "blocked" : bench.alloc ? "encode (malloc)" : "encode", bench.nums,
+        min_len, bench.ops, stats ? ", stats" : "", bench.pin ? ", pinned" :
+        "");
+
+    if (bench.counters) {
+        printf("%7s %12s %8s %6s %6s %10s %10s %10s %10s %10s\n", "threads",
+            "ops/s", "speedup", "eff", "IPC", "cycles/op", "instr/op",
+            "brmiss/op", "L1dmiss/op", "LLCmiss/op");
+    } else {
+        printf("%7s %12s %8s %6s %8s %8s %8s %8s\n", "threads", "ops/s",
+            "speedup", "eff", "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+    }
+
+    /* powers of two, then the maximum */
+    for (t = 1; !err && t <= threads;
+        t = t < threads && t * 2 > threads ? threads : t * 2) {
+        err = bench_run(&bench, t, &base, histogram);
+    }
+
+    if (!err && stats && sqids_stats_snapshot(bench.sqids, &snap) == 0) {
+        printf("stats: %llu encodes, %llu decodes\n", snap.encodes,
+            snap.decodes);
+    }
+
+    sqids_free(bench.sqids);
+    free(bench.cpus);
+
+    return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
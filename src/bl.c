@@ -1,4 +1,4 @@
-/* generated: 2023-12-02 14:37:35 +0200 */
+/* generated: Mon Oct 19 07:37:46 2026 */
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -8,1239 +8,571 @@
 
 #include "sqids.h"
 
-#ifdef SQIDS_DEFAULT_BLOCKLIST
-
-#define SQIDS_BL_ADD(bl, s) \
-    if (!sqids_bl_add_tail(bl, s)) { sqids_bl_free(bl); return NULL; }
-
-sqids_bl_t *
-sqids_bl_list_de(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "arsch");
-    SQIDS_BL_ADD(result, "de1ch");
-    SQIDS_BL_ADD(result, "deich");
-    SQIDS_BL_ADD(result, "depp");
-    SQIDS_BL_ADD(result, "f0tze");
-    SQIDS_BL_ADD(result, "f1cker");
-    SQIDS_BL_ADD(result, "ficker");
-    SQIDS_BL_ADD(result, "fotze");
-    SQIDS_BL_ADD(result, "hund1n");
-    SQIDS_BL_ADD(result, "hundin");
-    SQIDS_BL_ADD(result, "m1st");
-    SQIDS_BL_ADD(result, "mist");
-    SQIDS_BL_ADD(result, "musch1");
-    SQIDS_BL_ADD(result, "muschi");
-    SQIDS_BL_ADD(result, "neger");
-    SQIDS_BL_ADD(result, "saugnapf");
-    SQIDS_BL_ADD(result, "sch1ampe");
-    SQIDS_BL_ADD(result, "sche1se");
-    SQIDS_BL_ADD(result, "sche1sse");
-    SQIDS_BL_ADD(result, "scheise");
-    SQIDS_BL_ADD(result, "scheisse");
-    SQIDS_BL_ADD(result, "schlampe");
-    SQIDS_BL_ADD(result, "schwachs1nn1g");
-    SQIDS_BL_ADD(result, "schwachs1nnig");
-    SQIDS_BL_ADD(result, "schwachsinn1g");
-    SQIDS_BL_ADD(result, "schwachsinnig");
-    SQIDS_BL_ADD(result, "schwanz");
-    SQIDS_BL_ADD(result, "verdammt");
-    SQIDS_BL_ADD(result, "w1chsen");
-    SQIDS_BL_ADD(result, "wichsen");
-
-    return result;
-}
-
-sqids_bl_t *
-sqids_bl_list_en(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "0rgasm");
-    SQIDS_BL_ADD(result, "1d10t");
-    SQIDS_BL_ADD(result, "1d1ot");
-    SQIDS_BL_ADD(result, "1di0t");
-    SQIDS_BL_ADD(result, "1diot");
-    SQIDS_BL_ADD(result, "1mbec11e");
-    SQIDS_BL_ADD(result, "1mbec1le");
-    SQIDS_BL_ADD(result, "1mbeci1e");
-    SQIDS_BL_ADD(result, "1mbecile");
-    SQIDS_BL_ADD(result, "ah01e");
-    SQIDS_BL_ADD(result, "ah0le");
-    SQIDS_BL_ADD(result, "aho1e");
-    SQIDS_BL_ADD(result, "ahole");
-    SQIDS_BL_ADD(result, "ana1");
-    SQIDS_BL_ADD(result, "anal");
-    SQIDS_BL_ADD(result, "anus");
-    SQIDS_BL_ADD(result, "arse");
-    SQIDS_BL_ADD(result, "ass");
-    SQIDS_BL_ADD(result, "b00b");
-    SQIDS_BL_ADD(result, "b0ob");
-    SQIDS_BL_ADD(result, "b1tch");
-    SQIDS_BL_ADD(result, "bitch");
-    SQIDS_BL_ADD(result, "bo0b");
-    SQIDS_BL_ADD(result, "boob");
-    SQIDS_BL_ADD(result, "c0ck");
-    SQIDS_BL_ADD(result, "c11t");
-    SQIDS_BL_ADD(result, "c1it");
-    SQIDS_BL_ADD(result, "ch1nk");
-    SQIDS_BL_ADD(result, "chink");
-    SQIDS_BL_ADD(result, "cl1t");
-    SQIDS_BL_ADD(result, "clit");
-    SQIDS_BL_ADD(result, "cock");
-    SQIDS_BL_ADD(result, "cracker");
-    SQIDS_BL_ADD(result, "crap");
-    SQIDS_BL_ADD(result, "cum");
-    SQIDS_BL_ADD(result, "cunt");
-    SQIDS_BL_ADD(result, "d11d0");
-    SQIDS_BL_ADD(result, "d11do");
-    SQIDS_BL_ADD(result, "d1ck");
-    SQIDS_BL_ADD(result, "d1ld0");
-    SQIDS_BL_ADD(result, "d1ldo");
-    SQIDS_BL_ADD(result, "damn");
-    SQIDS_BL_ADD(result, "di1d0");
-    SQIDS_BL_ADD(result, "di1do");
-    SQIDS_BL_ADD(result, "dick");
-    SQIDS_BL_ADD(result, "dild0");
-    SQIDS_BL_ADD(result, "dildo");
-    SQIDS_BL_ADD(result, "dyke");
-    SQIDS_BL_ADD(result, "enema");
-    SQIDS_BL_ADD(result, "fag");
-    SQIDS_BL_ADD(result, "fuck");
-    SQIDS_BL_ADD(result, "id10t");
-    SQIDS_BL_ADD(result, "id1ot");
-    SQIDS_BL_ADD(result, "idi0t");
-    SQIDS_BL_ADD(result, "idiot");
-    SQIDS_BL_ADD(result, "imbec11e");
-    SQIDS_BL_ADD(result, "imbec1le");
-    SQIDS_BL_ADD(result, "imbeci1e");
-    SQIDS_BL_ADD(result, "imbecile");
-    SQIDS_BL_ADD(result, "j1zz");
-    SQIDS_BL_ADD(result, "jerk");
-    SQIDS_BL_ADD(result, "jizz");
-    SQIDS_BL_ADD(result, "k1ke");
-    SQIDS_BL_ADD(result, "kike");
-    SQIDS_BL_ADD(result, "masturbat10n");
-    SQIDS_BL_ADD(result, "masturbat1on");
-    SQIDS_BL_ADD(result, "masturbate");
-    SQIDS_BL_ADD(result, "masturbati0n");
-    SQIDS_BL_ADD(result, "masturbation");
-    SQIDS_BL_ADD(result, "n1gger");
-    SQIDS_BL_ADD(result, "negr0");
-    SQIDS_BL_ADD(result, "negro");
-    SQIDS_BL_ADD(result, "nigger");
-    SQIDS_BL_ADD(result, "orgasm");
-    SQIDS_BL_ADD(result, "p00p");
-    SQIDS_BL_ADD(result, "p0op");
-    SQIDS_BL_ADD(result, "p0rn");
-    SQIDS_BL_ADD(result, "pen1s");
-    SQIDS_BL_ADD(result, "penis");
-    SQIDS_BL_ADD(result, "po0p");
-    SQIDS_BL_ADD(result, "poop");
-    SQIDS_BL_ADD(result, "porn");
-    SQIDS_BL_ADD(result, "pr1ck");
-    SQIDS_BL_ADD(result, "prick");
-    SQIDS_BL_ADD(result, "pussy");
-    SQIDS_BL_ADD(result, "rape");
-    SQIDS_BL_ADD(result, "retard");
-    SQIDS_BL_ADD(result, "s1ut");
-    SQIDS_BL_ADD(result, "sexy");
-    SQIDS_BL_ADD(result, "sh1t");
-    SQIDS_BL_ADD(result, "shit");
-    SQIDS_BL_ADD(result, "slut");
-    SQIDS_BL_ADD(result, "stup1d");
-    SQIDS_BL_ADD(result, "stupid");
-    SQIDS_BL_ADD(result, "sucker");
-    SQIDS_BL_ADD(result, "test1c1e");
-    SQIDS_BL_ADD(result, "test1cle");
-    SQIDS_BL_ADD(result, "testic1e");
-    SQIDS_BL_ADD(result, "testicle");
-    SQIDS_BL_ADD(result, "turd");
-    SQIDS_BL_ADD(result, "twat");
-    SQIDS_BL_ADD(result, "vag1na");
-    SQIDS_BL_ADD(result, "vagina");
-    SQIDS_BL_ADD(result, "wank");
-
-    return result;
-}
-
-sqids_bl_t *
-sqids_bl_list_es(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "cabr0n");
-    SQIDS_BL_ADD(result, "cabron");
-    SQIDS_BL_ADD(result, "cagante");
-    SQIDS_BL_ADD(result, "caracu10");
-    SQIDS_BL_ADD(result, "caracu1o");
-    SQIDS_BL_ADD(result, "caracul0");
-    SQIDS_BL_ADD(result, "caraculo");
-    SQIDS_BL_ADD(result, "ch1ng0");
-    SQIDS_BL_ADD(result, "ch1ngadaz0s");
-    SQIDS_BL_ADD(result, "ch1ngadazos");
-    SQIDS_BL_ADD(result, "ch1ngader1ta");
-    SQIDS_BL_ADD(result, "ch1ngaderita");
-    SQIDS_BL_ADD(result, "ch1ngar");
-    SQIDS_BL_ADD(result, "ch1ngo");
-    SQIDS_BL_ADD(result, "ch1ngues");
-    SQIDS_BL_ADD(result, "ching0");
-    SQIDS_BL_ADD(result, "chingadaz0s");
-    SQIDS_BL_ADD(result, "chingadazos");
-    SQIDS_BL_ADD(result, "chingader1ta");
-    SQIDS_BL_ADD(result, "chingaderita");
-    SQIDS_BL_ADD(result, "chingar");
-    SQIDS_BL_ADD(result, "chingo");
-    SQIDS_BL_ADD(result, "chingues");
-    SQIDS_BL_ADD(result, "cu1er0");
-    SQIDS_BL_ADD(result, "cu1ero");
-    SQIDS_BL_ADD(result, "culer0");
-    SQIDS_BL_ADD(result, "culero");
-    SQIDS_BL_ADD(result, "estup1d0");
-    SQIDS_BL_ADD(result, "estup1do");
-    SQIDS_BL_ADD(result, "estupid0");
-    SQIDS_BL_ADD(result, "estupido");
-    SQIDS_BL_ADD(result, "m1erda");
-    SQIDS_BL_ADD(result, "mam0n");
-    SQIDS_BL_ADD(result, "mamahuev0");
-    SQIDS_BL_ADD(result, "mamahuevo");
-    SQIDS_BL_ADD(result, "mamon");
-    SQIDS_BL_ADD(result, "mierda");
-    SQIDS_BL_ADD(result, "p011a");
-    SQIDS_BL_ADD(result, "p01la");
-    SQIDS_BL_ADD(result, "p0l1a");
-    SQIDS_BL_ADD(result, "p0lla");
-    SQIDS_BL_ADD(result, "pendej0");
-    SQIDS_BL_ADD(result, "pendejo");
-    SQIDS_BL_ADD(result, "po11a");
-    SQIDS_BL_ADD(result, "po1la");
-    SQIDS_BL_ADD(result, "pol1a");
-    SQIDS_BL_ADD(result, "polla");
-    SQIDS_BL_ADD(result, "put1za");
-    SQIDS_BL_ADD(result, "puta");
-    SQIDS_BL_ADD(result, "putiza");
-    SQIDS_BL_ADD(result, "verga");
-
-    return result;
-}
-
-sqids_bl_t *
-sqids_bl_list_fr(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "b1te");
-    SQIDS_BL_ADD(result, "b1tte");
-    SQIDS_BL_ADD(result, "bite");
-    SQIDS_BL_ADD(result, "bitte");
-    SQIDS_BL_ADD(result, "bran1age");
-    SQIDS_BL_ADD(result, "bran1er");
-    SQIDS_BL_ADD(result, "bran1ette");
-    SQIDS_BL_ADD(result, "bran1eur");
-    SQIDS_BL_ADD(result, "bran1euse");
-    SQIDS_BL_ADD(result, "branlage");
-    SQIDS_BL_ADD(result, "branler");
-    SQIDS_BL_ADD(result, "branlette");
-    SQIDS_BL_ADD(result, "branleur");
-    SQIDS_BL_ADD(result, "branleuse");
-    SQIDS_BL_ADD(result, "c0nnard");
-    SQIDS_BL_ADD(result, "c0nnasse");
-    SQIDS_BL_ADD(result, "c0nne");
-    SQIDS_BL_ADD(result, "c0u111es");
-    SQIDS_BL_ADD(result, "c0u11les");
-    SQIDS_BL_ADD(result, "c0u1l1es");
-    SQIDS_BL_ADD(result, "c0u1lles");
-    SQIDS_BL_ADD(result, "c0ui11es");
-    SQIDS_BL_ADD(result, "c0ui1les");
-    SQIDS_BL_ADD(result, "c0uil1es");
-    SQIDS_BL_ADD(result, "c0uilles");
-    SQIDS_BL_ADD(result, "c11t0");
-    SQIDS_BL_ADD(result, "c11to");
-    SQIDS_BL_ADD(result, "c1it0");
-    SQIDS_BL_ADD(result, "c1ito");
-    SQIDS_BL_ADD(result, "caca");
-    SQIDS_BL_ADD(result, "ch1asse");
-    SQIDS_BL_ADD(result, "ch1er");
-    SQIDS_BL_ADD(result, "chatte");
-    SQIDS_BL_ADD(result, "chiasse");
-    SQIDS_BL_ADD(result, "chier");
-    SQIDS_BL_ADD(result, "cl1t0");
-    SQIDS_BL_ADD(result, "cl1to");
-    SQIDS_BL_ADD(result, "clit0");
-    SQIDS_BL_ADD(result, "clito");
-    SQIDS_BL_ADD(result, "connard");
-    SQIDS_BL_ADD(result, "connasse");
-    SQIDS_BL_ADD(result, "conne");
-    SQIDS_BL_ADD(result, "cou111es");
-    SQIDS_BL_ADD(result, "cou11les");
-    SQIDS_BL_ADD(result, "cou1l1es");
-    SQIDS_BL_ADD(result, "cou1lles");
-    SQIDS_BL_ADD(result, "coui11es");
-    SQIDS_BL_ADD(result, "coui1les");
-    SQIDS_BL_ADD(result, "couil1es");
-    SQIDS_BL_ADD(result, "couilles");
-    SQIDS_BL_ADD(result, "encu1e");
-    SQIDS_BL_ADD(result, "encule");
-    SQIDS_BL_ADD(result, "enf01re");
-    SQIDS_BL_ADD(result, "enf0ire");
-    SQIDS_BL_ADD(result, "enfo1re");
-    SQIDS_BL_ADD(result, "enfoire");
-    SQIDS_BL_ADD(result, "etr0n");
-    SQIDS_BL_ADD(result, "etron");
-    SQIDS_BL_ADD(result, "f0utre");
-    SQIDS_BL_ADD(result, "foutre");
-    SQIDS_BL_ADD(result, "g0u1ne");
-    SQIDS_BL_ADD(result, "g0uine");
-    SQIDS_BL_ADD(result, "gou1ne");
-    SQIDS_BL_ADD(result, "gouine");
-    SQIDS_BL_ADD(result, "gr0gnasse");
-    SQIDS_BL_ADD(result, "grognasse");
-    SQIDS_BL_ADD(result, "merde");
-    SQIDS_BL_ADD(result, "negre");
-    SQIDS_BL_ADD(result, "p0uff1asse");
-    SQIDS_BL_ADD(result, "p0uffiasse");
-    SQIDS_BL_ADD(result, "p1p1");
-    SQIDS_BL_ADD(result, "p1pi");
-    SQIDS_BL_ADD(result, "p1sser");
-    SQIDS_BL_ADD(result, "pip1");
-    SQIDS_BL_ADD(result, "pipi");
-    SQIDS_BL_ADD(result, "pisser");
-    SQIDS_BL_ADD(result, "pouff1asse");
-    SQIDS_BL_ADD(result, "pouffiasse");
-    SQIDS_BL_ADD(result, "puta1n");
-    SQIDS_BL_ADD(result, "putain");
-    SQIDS_BL_ADD(result, "pute");
-    SQIDS_BL_ADD(result, "sa10pe");
-    SQIDS_BL_ADD(result, "sa1aud");
-    SQIDS_BL_ADD(result, "sa1ope");
-    SQIDS_BL_ADD(result, "sal0pe");
-    SQIDS_BL_ADD(result, "salaud");
-    SQIDS_BL_ADD(result, "salope");
-    SQIDS_BL_ADD(result, "tapette");
-    SQIDS_BL_ADD(result, "tr1ng1er");
-    SQIDS_BL_ADD(result, "tr1ngler");
-    SQIDS_BL_ADD(result, "tring1er");
-    SQIDS_BL_ADD(result, "tringler");
-    SQIDS_BL_ADD(result, "z1z1");
-    SQIDS_BL_ADD(result, "z1zi");
-    SQIDS_BL_ADD(result, "ziz1");
-    SQIDS_BL_ADD(result, "zizi");
-
-    return result;
-}
-
-sqids_bl_t *
-sqids_bl_list_hi(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "aand");
-    SQIDS_BL_ADD(result, "b00be");
-    SQIDS_BL_ADD(result, "b0obe");
-    SQIDS_BL_ADD(result, "ba1atkar");
-    SQIDS_BL_ADD(result, "balatkar");
-    SQIDS_BL_ADD(result, "bo0be");
-    SQIDS_BL_ADD(result, "boobe");
-    SQIDS_BL_ADD(result, "ch00t1a");
-    SQIDS_BL_ADD(result, "ch00t1ya");
-    SQIDS_BL_ADD(result, "ch00tia");
-    SQIDS_BL_ADD(result, "ch00tiya");
-    SQIDS_BL_ADD(result, "ch0d");
-    SQIDS_BL_ADD(result, "ch0ot1a");
-    SQIDS_BL_ADD(result, "ch0ot1ya");
-    SQIDS_BL_ADD(result, "ch0otia");
-    SQIDS_BL_ADD(result, "ch0otiya");
-    SQIDS_BL_ADD(result, "cho0t1a");
-    SQIDS_BL_ADD(result, "cho0t1ya");
-    SQIDS_BL_ADD(result, "cho0tia");
-    SQIDS_BL_ADD(result, "cho0tiya");
-    SQIDS_BL_ADD(result, "chod");
-    SQIDS_BL_ADD(result, "choot1a");
-    SQIDS_BL_ADD(result, "choot1ya");
-    SQIDS_BL_ADD(result, "chootia");
-    SQIDS_BL_ADD(result, "chootiya");
-    SQIDS_BL_ADD(result, "g00");
-    SQIDS_BL_ADD(result, "g0o");
-    SQIDS_BL_ADD(result, "gandu");
-    SQIDS_BL_ADD(result, "go0");
-    SQIDS_BL_ADD(result, "goo");
-    SQIDS_BL_ADD(result, "haram1");
-    SQIDS_BL_ADD(result, "harami");
-    SQIDS_BL_ADD(result, "haramzade");
-    SQIDS_BL_ADD(result, "kam1ne");
-    SQIDS_BL_ADD(result, "kamine");
-    SQIDS_BL_ADD(result, "patakha");
-    SQIDS_BL_ADD(result, "rand1");
-    SQIDS_BL_ADD(result, "randi");
-
-    return result;
-}
-
-sqids_bl_t *
-sqids_bl_list_it(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "1eccacu10");
-    SQIDS_BL_ADD(result, "1eccacu1o");
-    SQIDS_BL_ADD(result, "1eccacul0");
-    SQIDS_BL_ADD(result, "1eccaculo");
-    SQIDS_BL_ADD(result, "a11upat0");
-    SQIDS_BL_ADD(result, "a11upato");
-    SQIDS_BL_ADD(result, "a1lupat0");
-    SQIDS_BL_ADD(result, "a1lupato");
-    SQIDS_BL_ADD(result, "al1upat0");
-    SQIDS_BL_ADD(result, "al1upato");
-    SQIDS_BL_ADD(result, "allupat0");
-    SQIDS_BL_ADD(result, "allupato");
-    SQIDS_BL_ADD(result, "ana1e");
-    SQIDS_BL_ADD(result, "anale");
-    SQIDS_BL_ADD(result, "arrapat0");
-    SQIDS_BL_ADD(result, "arrapato");
-    SQIDS_BL_ADD(result, "b01ata");
-    SQIDS_BL_ADD(result, "b0iata");
-    SQIDS_BL_ADD(result, "batt0na");
-    SQIDS_BL_ADD(result, "battona");
-    SQIDS_BL_ADD(result, "bo1ata");
-    SQIDS_BL_ADD(result, "boiata");
-    SQIDS_BL_ADD(result, "c0g110ne");
-    SQIDS_BL_ADD(result, "c0g11one");
-    SQIDS_BL_ADD(result, "c0g1i0ne");
-    SQIDS_BL_ADD(result, "c0g1ione");
-    SQIDS_BL_ADD(result, "c0gl10ne");
-    SQIDS_BL_ADD(result, "c0gl1one");
-    SQIDS_BL_ADD(result, "c0gli0ne");
-    SQIDS_BL_ADD(result, "c0glione");
-    SQIDS_BL_ADD(result, "cacca");
-    SQIDS_BL_ADD(result, "cagare");
-    SQIDS_BL_ADD(result, "cagna");
-    SQIDS_BL_ADD(result, "cazz0");
-    SQIDS_BL_ADD(result, "cazz1mma");
-    SQIDS_BL_ADD(result, "cazzata");
-    SQIDS_BL_ADD(result, "cazzimma");
-    SQIDS_BL_ADD(result, "cazzo");
-    SQIDS_BL_ADD(result, "ch1avata");
-    SQIDS_BL_ADD(result, "chiavata");
-    SQIDS_BL_ADD(result, "cog110ne");
-    SQIDS_BL_ADD(result, "cog11one");
-    SQIDS_BL_ADD(result, "cog1i0ne");
-    SQIDS_BL_ADD(result, "cog1ione");
-    SQIDS_BL_ADD(result, "cogl10ne");
-    SQIDS_BL_ADD(result, "cogl1one");
-    SQIDS_BL_ADD(result, "cogli0ne");
-    SQIDS_BL_ADD(result, "coglione");
-    SQIDS_BL_ADD(result, "cu10");
-    SQIDS_BL_ADD(result, "cu1att0ne");
-    SQIDS_BL_ADD(result, "cu1attone");
-    SQIDS_BL_ADD(result, "cu1o");
-    SQIDS_BL_ADD(result, "cul0");
-    SQIDS_BL_ADD(result, "culatt0ne");
-    SQIDS_BL_ADD(result, "culattone");
-    SQIDS_BL_ADD(result, "culo");
-    SQIDS_BL_ADD(result, "f0ttere");
-    SQIDS_BL_ADD(result, "f0tters1");
-    SQIDS_BL_ADD(result, "f0ttersi");
-    SQIDS_BL_ADD(result, "f1ca");
-    SQIDS_BL_ADD(result, "f1ga");
-    SQIDS_BL_ADD(result, "fica");
-    SQIDS_BL_ADD(result, "figa");
-    SQIDS_BL_ADD(result, "fottere");
-    SQIDS_BL_ADD(result, "fotters1");
-    SQIDS_BL_ADD(result, "fottersi");
-    SQIDS_BL_ADD(result, "fr0c10");
-    SQIDS_BL_ADD(result, "fr0c1o");
-    SQIDS_BL_ADD(result, "fr0ci0");
-    SQIDS_BL_ADD(result, "fr0cio");
-    SQIDS_BL_ADD(result, "fr0sc10");
-    SQIDS_BL_ADD(result, "fr0sc1o");
-    SQIDS_BL_ADD(result, "fr0sci0");
-    SQIDS_BL_ADD(result, "fr0scio");
-    SQIDS_BL_ADD(result, "froc10");
-    SQIDS_BL_ADD(result, "froc1o");
-    SQIDS_BL_ADD(result, "froci0");
-    SQIDS_BL_ADD(result, "frocio");
-    SQIDS_BL_ADD(result, "frosc10");
-    SQIDS_BL_ADD(result, "frosc1o");
-    SQIDS_BL_ADD(result, "frosci0");
-    SQIDS_BL_ADD(result, "froscio");
-    SQIDS_BL_ADD(result, "leccacu10");
-    SQIDS_BL_ADD(result, "leccacu1o");
-    SQIDS_BL_ADD(result, "leccacul0");
-    SQIDS_BL_ADD(result, "leccaculo");
-    SQIDS_BL_ADD(result, "m1gn0tta");
-    SQIDS_BL_ADD(result, "m1gnotta");
-    SQIDS_BL_ADD(result, "m1nch1a");
-    SQIDS_BL_ADD(result, "m1nchia");
-    SQIDS_BL_ADD(result, "merd0s0");
-    SQIDS_BL_ADD(result, "merd0so");
-    SQIDS_BL_ADD(result, "merda");
-    SQIDS_BL_ADD(result, "merdos0");
-    SQIDS_BL_ADD(result, "merdoso");
-    SQIDS_BL_ADD(result, "mign0tta");
-    SQIDS_BL_ADD(result, "mignotta");
-    SQIDS_BL_ADD(result, "minch1a");
-    SQIDS_BL_ADD(result, "minchia");
-    SQIDS_BL_ADD(result, "nerch1a");
-    SQIDS_BL_ADD(result, "nerchia");
-    SQIDS_BL_ADD(result, "p0mp1n0");
-    SQIDS_BL_ADD(result, "p0mp1no");
-    SQIDS_BL_ADD(result, "p0mpin0");
-    SQIDS_BL_ADD(result, "p0mpino");
-    SQIDS_BL_ADD(result, "p0rca");
-    SQIDS_BL_ADD(result, "p1r1a");
-    SQIDS_BL_ADD(result, "p1rla");
-    SQIDS_BL_ADD(result, "p1sc10");
-    SQIDS_BL_ADD(result, "p1sc1o");
-    SQIDS_BL_ADD(result, "p1sci0");
-    SQIDS_BL_ADD(result, "p1scio");
-    SQIDS_BL_ADD(result, "pa11e");
-    SQIDS_BL_ADD(result, "pa1le");
-    SQIDS_BL_ADD(result, "pal1e");
-    SQIDS_BL_ADD(result, "palle");
-    SQIDS_BL_ADD(result, "pec0r1na");
-    SQIDS_BL_ADD(result, "pec0rina");
-    SQIDS_BL_ADD(result, "pecor1na");
-    SQIDS_BL_ADD(result, "pecorina");
-    SQIDS_BL_ADD(result, "pir1a");
-    SQIDS_BL_ADD(result, "pirla");
-    SQIDS_BL_ADD(result, "pisc10");
-    SQIDS_BL_ADD(result, "pisc1o");
-    SQIDS_BL_ADD(result, "pisci0");
-    SQIDS_BL_ADD(result, "piscio");
-    SQIDS_BL_ADD(result, "pomp1n0");
-    SQIDS_BL_ADD(result, "pomp1no");
-    SQIDS_BL_ADD(result, "pompin0");
-    SQIDS_BL_ADD(result, "pompino");
-    SQIDS_BL_ADD(result, "porca");
-    SQIDS_BL_ADD(result, "puttana");
-    SQIDS_BL_ADD(result, "r0mp1ba11e");
-    SQIDS_BL_ADD(result, "r0mp1ba1le");
-    SQIDS_BL_ADD(result, "r0mp1bal1e");
-    SQIDS_BL_ADD(result, "r0mp1balle");
-    SQIDS_BL_ADD(result, "r0mpiba11e");
-    SQIDS_BL_ADD(result, "r0mpiba1le");
-    SQIDS_BL_ADD(result, "r0mpibal1e");
-    SQIDS_BL_ADD(result, "r0mpiballe");
-    SQIDS_BL_ADD(result, "recch10ne");
-    SQIDS_BL_ADD(result, "recch1one");
-    SQIDS_BL_ADD(result, "recchi0ne");
-    SQIDS_BL_ADD(result, "recchione");
-    SQIDS_BL_ADD(result, "romp1ba11e");
-    SQIDS_BL_ADD(result, "romp1ba1le");
-    SQIDS_BL_ADD(result, "romp1bal1e");
-    SQIDS_BL_ADD(result, "romp1balle");
-    SQIDS_BL_ADD(result, "rompiba11e");
-    SQIDS_BL_ADD(result, "rompiba1le");
-    SQIDS_BL_ADD(result, "rompibal1e");
-    SQIDS_BL_ADD(result, "rompiballe");
-    SQIDS_BL_ADD(result, "ruff1an0");
-    SQIDS_BL_ADD(result, "ruff1ano");
-    SQIDS_BL_ADD(result, "ruffian0");
-    SQIDS_BL_ADD(result, "ruffiano");
-    SQIDS_BL_ADD(result, "sb0rr0ne");
-    SQIDS_BL_ADD(result, "sb0rra");
-    SQIDS_BL_ADD(result, "sb0rrone");
-    SQIDS_BL_ADD(result, "sbattere");
-    SQIDS_BL_ADD(result, "sbatters1");
-    SQIDS_BL_ADD(result, "sbattersi");
-    SQIDS_BL_ADD(result, "sborr0ne");
-    SQIDS_BL_ADD(result, "sborra");
-    SQIDS_BL_ADD(result, "sborrone");
-    SQIDS_BL_ADD(result, "sc0pare");
-    SQIDS_BL_ADD(result, "sc0pata");
-    SQIDS_BL_ADD(result, "scopare");
-    SQIDS_BL_ADD(result, "scopata");
-    SQIDS_BL_ADD(result, "sp0mp1nare");
-    SQIDS_BL_ADD(result, "sp0mpinare");
-    SQIDS_BL_ADD(result, "spomp1nare");
-    SQIDS_BL_ADD(result, "spompinare");
-    SQIDS_BL_ADD(result, "str0nz0");
-    SQIDS_BL_ADD(result, "str0nza");
-    SQIDS_BL_ADD(result, "str0nzo");
-    SQIDS_BL_ADD(result, "stronz0");
-    SQIDS_BL_ADD(result, "stronza");
-    SQIDS_BL_ADD(result, "stronzo");
-    SQIDS_BL_ADD(result, "succh1am1");
-    SQIDS_BL_ADD(result, "succh1ami");
-    SQIDS_BL_ADD(result, "succhiam1");
-    SQIDS_BL_ADD(result, "succhiami");
-    SQIDS_BL_ADD(result, "t0pa");
-    SQIDS_BL_ADD(result, "tette");
-    SQIDS_BL_ADD(result, "topa");
-    SQIDS_BL_ADD(result, "tr01a");
-    SQIDS_BL_ADD(result, "tr0ia");
-    SQIDS_BL_ADD(result, "tr0mbare");
-    SQIDS_BL_ADD(result, "tro1a");
-    SQIDS_BL_ADD(result, "troia");
-    SQIDS_BL_ADD(result, "trombare");
-    SQIDS_BL_ADD(result, "vaffancu10");
-    SQIDS_BL_ADD(result, "vaffancu1o");
-    SQIDS_BL_ADD(result, "vaffancul0");
-    SQIDS_BL_ADD(result, "vaffanculo");
-    SQIDS_BL_ADD(result, "z0cc01a");
-    SQIDS_BL_ADD(result, "z0cc0la");
-    SQIDS_BL_ADD(result, "z0cco1a");
-    SQIDS_BL_ADD(result, "z0ccola");
-    SQIDS_BL_ADD(result, "zocc01a");
-    SQIDS_BL_ADD(result, "zocc0la");
-    SQIDS_BL_ADD(result, "zocco1a");
-    SQIDS_BL_ADD(result, "zoccola");
-
-    return result;
-}
-
-sqids_bl_t *
-sqids_bl_list_pt(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "b0ceta");
-    SQIDS_BL_ADD(result, "b0sta");
-    SQIDS_BL_ADD(result, "bastard0");
-    SQIDS_BL_ADD(result, "bastardo");
-    SQIDS_BL_ADD(result, "boceta");
-    SQIDS_BL_ADD(result, "bosta");
-    SQIDS_BL_ADD(result, "c0na");
-    SQIDS_BL_ADD(result, "cabra0");
-    SQIDS_BL_ADD(result, "cabrao");
-    SQIDS_BL_ADD(result, "cacete");
-    SQIDS_BL_ADD(result, "cagar");
-    SQIDS_BL_ADD(result, "cara1h0");
-    SQIDS_BL_ADD(result, "cara1ho");
-    SQIDS_BL_ADD(result, "caralh0");
-    SQIDS_BL_ADD(result, "caralho");
-    SQIDS_BL_ADD(result, "cona");
-    SQIDS_BL_ADD(result, "f0da");
-    SQIDS_BL_ADD(result, "f0der");
-    SQIDS_BL_ADD(result, "foda");
-    SQIDS_BL_ADD(result, "foder");
-    SQIDS_BL_ADD(result, "merda");
-    SQIDS_BL_ADD(result, "p0rra");
-    SQIDS_BL_ADD(result, "pane1e1r0");
-    SQIDS_BL_ADD(result, "pane1e1ro");
-    SQIDS_BL_ADD(result, "pane1eir0");
-    SQIDS_BL_ADD(result, "pane1eiro");
-    SQIDS_BL_ADD(result, "panele1r0");
-    SQIDS_BL_ADD(result, "panele1ro");
-    SQIDS_BL_ADD(result, "paneleir0");
-    SQIDS_BL_ADD(result, "paneleiro");
-    SQIDS_BL_ADD(result, "porra");
-    SQIDS_BL_ADD(result, "puta");
-    SQIDS_BL_ADD(result, "queca");
-    SQIDS_BL_ADD(result, "sacanagem");
-    SQIDS_BL_ADD(result, "x0ch0ta");
-    SQIDS_BL_ADD(result, "x0chota");
-    SQIDS_BL_ADD(result, "xana");
-    SQIDS_BL_ADD(result, "xoch0ta");
-    SQIDS_BL_ADD(result, "xochota");
-
-    return result;
-}
-
-sqids_bl_t *
-sqids_bl_list_all(int (*match_func)(char *, char *))
-{
-    sqids_bl_t *result;
-
-    if (!(result = sqids_bl_new(match_func))) {
-        return NULL;
-    }
-
-    SQIDS_BL_ADD(result, "0rgasm");
-    SQIDS_BL_ADD(result, "1d10t");
-    SQIDS_BL_ADD(result, "1d1ot");
-    SQIDS_BL_ADD(result, "1di0t");
-    SQIDS_BL_ADD(result, "1diot");
-    SQIDS_BL_ADD(result, "1eccacu10");
-    SQIDS_BL_ADD(result, "1eccacu1o");
-    SQIDS_BL_ADD(result, "1eccacul0");
-    SQIDS_BL_ADD(result, "1eccaculo");
-    SQIDS_BL_ADD(result, "1mbec11e");
-    SQIDS_BL_ADD(result, "1mbec1le");
-    SQIDS_BL_ADD(result, "1mbeci1e");
-    SQIDS_BL_ADD(result, "1mbecile");
-    SQIDS_BL_ADD(result, "a11upat0");
-    SQIDS_BL_ADD(result, "a11upato");
-    SQIDS_BL_ADD(result, "a1lupat0");
-    SQIDS_BL_ADD(result, "a1lupato");
-    SQIDS_BL_ADD(result, "aand");
-    SQIDS_BL_ADD(result, "ah01e");
-    SQIDS_BL_ADD(result, "ah0le");
-    SQIDS_BL_ADD(result, "aho1e");
-    SQIDS_BL_ADD(result, "ahole");
-    SQIDS_BL_ADD(result, "al1upat0");
-    SQIDS_BL_ADD(result, "al1upato");
-    SQIDS_BL_ADD(result, "allupat0");
-    SQIDS_BL_ADD(result, "allupato");
-    SQIDS_BL_ADD(result, "ana1");
-    SQIDS_BL_ADD(result, "ana1e");
-    SQIDS_BL_ADD(result, "anal");
-    SQIDS_BL_ADD(result, "anale");
-    SQIDS_BL_ADD(result, "anus");
-    SQIDS_BL_ADD(result, "arrapat0");
-    SQIDS_BL_ADD(result, "arrapato");
-    SQIDS_BL_ADD(result, "arsch");
-    SQIDS_BL_ADD(result, "arse");
-    SQIDS_BL_ADD(result, "ass");
-    SQIDS_BL_ADD(result, "b00b");
-    SQIDS_BL_ADD(result, "b00be");
-    SQIDS_BL_ADD(result, "b01ata");
-    SQIDS_BL_ADD(result, "b0ceta");
-    SQIDS_BL_ADD(result, "b0iata");
-    SQIDS_BL_ADD(result, "b0ob");
-    SQIDS_BL_ADD(result, "b0obe");
-    SQIDS_BL_ADD(result, "b0sta");
-    SQIDS_BL_ADD(result, "b1tch");
-    SQIDS_BL_ADD(result, "b1te");
-    SQIDS_BL_ADD(result, "b1tte");
-    SQIDS_BL_ADD(result, "ba1atkar");
-    SQIDS_BL_ADD(result, "balatkar");
-    SQIDS_BL_ADD(result, "bastard0");
-    SQIDS_BL_ADD(result, "bastardo");
-    SQIDS_BL_ADD(result, "batt0na");
-    SQIDS_BL_ADD(result, "battona");
-    SQIDS_BL_ADD(result, "bitch");
-    SQIDS_BL_ADD(result, "bite");
-    SQIDS_BL_ADD(result, "bitte");
-    SQIDS_BL_ADD(result, "bo0b");
-    SQIDS_BL_ADD(result, "bo0be");
-    SQIDS_BL_ADD(result, "bo1ata");
-    SQIDS_BL_ADD(result, "boceta");
-    SQIDS_BL_ADD(result, "boiata");
-    SQIDS_BL_ADD(result, "boob");
-    SQIDS_BL_ADD(result, "boobe");
-    SQIDS_BL_ADD(result, "bosta");
-    SQIDS_BL_ADD(result, "bran1age");
-    SQIDS_BL_ADD(result, "bran1er");
-    SQIDS_BL_ADD(result, "bran1ette");
-    SQIDS_BL_ADD(result, "bran1eur");
-    SQIDS_BL_ADD(result, "bran1euse");
-    SQIDS_BL_ADD(result, "branlage");
-    SQIDS_BL_ADD(result, "branler");
-    SQIDS_BL_ADD(result, "branlette");
-    SQIDS_BL_ADD(result, "branleur");
-    SQIDS_BL_ADD(result, "branleuse");
-    SQIDS_BL_ADD(result, "c0ck");
-    SQIDS_BL_ADD(result, "c0g110ne");
-    SQIDS_BL_ADD(result, "c0g11one");
-    SQIDS_BL_ADD(result, "c0g1i0ne");
-    SQIDS_BL_ADD(result, "c0g1ione");
-    SQIDS_BL_ADD(result, "c0gl10ne");
-    SQIDS_BL_ADD(result, "c0gl1one");
-    SQIDS_BL_ADD(result, "c0gli0ne");
-    SQIDS_BL_ADD(result, "c0glione");
-    SQIDS_BL_ADD(result, "c0na");
-    SQIDS_BL_ADD(result, "c0nnard");
-    SQIDS_BL_ADD(result, "c0nnasse");
-    SQIDS_BL_ADD(result, "c0nne");
-    SQIDS_BL_ADD(result, "c0u111es");
-    SQIDS_BL_ADD(result, "c0u11les");
-    SQIDS_BL_ADD(result, "c0u1l1es");
-    SQIDS_BL_ADD(result, "c0u1lles");
-    SQIDS_BL_ADD(result, "c0ui11es");
-    SQIDS_BL_ADD(result, "c0ui1les");
-    SQIDS_BL_ADD(result, "c0uil1es");
-    SQIDS_BL_ADD(result, "c0uilles");
-    SQIDS_BL_ADD(result, "c11t");
-    SQIDS_BL_ADD(result, "c11t0");
-    SQIDS_BL_ADD(result, "c11to");
-    SQIDS_BL_ADD(result, "c1it");
-    SQIDS_BL_ADD(result, "c1it0");
-    SQIDS_BL_ADD(result, "c1ito");
-    SQIDS_BL_ADD(result, "cabr0n");
-    SQIDS_BL_ADD(result, "cabra0");
-    SQIDS_BL_ADD(result, "cabrao");
-    SQIDS_BL_ADD(result, "cabron");
-    SQIDS_BL_ADD(result, "caca");
-    SQIDS_BL_ADD(result, "cacca");
-    SQIDS_BL_ADD(result, "cacete");
-    SQIDS_BL_ADD(result, "cagante");
-    SQIDS_BL_ADD(result, "cagar");
-    SQIDS_BL_ADD(result, "cagare");
-    SQIDS_BL_ADD(result, "cagna");
-    SQIDS_BL_ADD(result, "cara1h0");
-    SQIDS_BL_ADD(result, "cara1ho");
-    SQIDS_BL_ADD(result, "caracu10");
-    SQIDS_BL_ADD(result, "caracu1o");
-    SQIDS_BL_ADD(result, "caracul0");
-    SQIDS_BL_ADD(result, "caraculo");
-    SQIDS_BL_ADD(result, "caralh0");
-    SQIDS_BL_ADD(result, "caralho");
-    SQIDS_BL_ADD(result, "cazz0");
-    SQIDS_BL_ADD(result, "cazz1mma");
-    SQIDS_BL_ADD(result, "cazzata");
-    SQIDS_BL_ADD(result, "cazzimma");
-    SQIDS_BL_ADD(result, "cazzo");
-    SQIDS_BL_ADD(result, "ch00t1a");
-    SQIDS_BL_ADD(result, "ch00t1ya");
-    SQIDS_BL_ADD(result, "ch00tia");
-    SQIDS_BL_ADD(result, "ch00tiya");
-    SQIDS_BL_ADD(result, "ch0d");
-    SQIDS_BL_ADD(result, "ch0ot1a");
-    SQIDS_BL_ADD(result, "ch0ot1ya");
-    SQIDS_BL_ADD(result, "ch0otia");
-    SQIDS_BL_ADD(result, "ch0otiya");
-    SQIDS_BL_ADD(result, "ch1asse");
-    SQIDS_BL_ADD(result, "ch1avata");
-    SQIDS_BL_ADD(result, "ch1er");
-    SQIDS_BL_ADD(result, "ch1ng0");
-    SQIDS_BL_ADD(result, "ch1ngadaz0s");
-    SQIDS_BL_ADD(result, "ch1ngadazos");
-    SQIDS_BL_ADD(result, "ch1ngader1ta");
-    SQIDS_BL_ADD(result, "ch1ngaderita");
-    SQIDS_BL_ADD(result, "ch1ngar");
-    SQIDS_BL_ADD(result, "ch1ngo");
-    SQIDS_BL_ADD(result, "ch1ngues");
-    SQIDS_BL_ADD(result, "ch1nk");
-    SQIDS_BL_ADD(result, "chatte");
-    SQIDS_BL_ADD(result, "chiasse");
-    SQIDS_BL_ADD(result, "chiavata");
-    SQIDS_BL_ADD(result, "chier");
-    SQIDS_BL_ADD(result, "ching0");
-    SQIDS_BL_ADD(result, "chingadaz0s");
-    SQIDS_BL_ADD(result, "chingadazos");
-    SQIDS_BL_ADD(result, "chingader1ta");
-    SQIDS_BL_ADD(result, "chingaderita");
-    SQIDS_BL_ADD(result, "chingar");
-    SQIDS_BL_ADD(result, "chingo");
-    SQIDS_BL_ADD(result, "chingues");
-    SQIDS_BL_ADD(result, "chink");
-    SQIDS_BL_ADD(result, "cho0t1a");
-    SQIDS_BL_ADD(result, "cho0t1ya");
-    SQIDS_BL_ADD(result, "cho0tia");
-    SQIDS_BL_ADD(result, "cho0tiya");
-    SQIDS_BL_ADD(result, "chod");
-    SQIDS_BL_ADD(result, "choot1a");
-    SQIDS_BL_ADD(result, "choot1ya");
-    SQIDS_BL_ADD(result, "chootia");
-    SQIDS_BL_ADD(result, "chootiya");
-    SQIDS_BL_ADD(result, "cl1t");
-    SQIDS_BL_ADD(result, "cl1t0");
-    SQIDS_BL_ADD(result, "cl1to");
-    SQIDS_BL_ADD(result, "clit");
-    SQIDS_BL_ADD(result, "clit0");
-    SQIDS_BL_ADD(result, "clito");
-    SQIDS_BL_ADD(result, "cock");
-    SQIDS_BL_ADD(result, "cog110ne");
-    SQIDS_BL_ADD(result, "cog11one");
-    SQIDS_BL_ADD(result, "cog1i0ne");
-    SQIDS_BL_ADD(result, "cog1ione");
-    SQIDS_BL_ADD(result, "cogl10ne");
-    SQIDS_BL_ADD(result, "cogl1one");
-    SQIDS_BL_ADD(result, "cogli0ne");
-    SQIDS_BL_ADD(result, "coglione");
-    SQIDS_BL_ADD(result, "cona");
-    SQIDS_BL_ADD(result, "connard");
-    SQIDS_BL_ADD(result, "connasse");
-    SQIDS_BL_ADD(result, "conne");
-    SQIDS_BL_ADD(result, "cou111es");
-    SQIDS_BL_ADD(result, "cou11les");
-    SQIDS_BL_ADD(result, "cou1l1es");
-    SQIDS_BL_ADD(result, "cou1lles");
-    SQIDS_BL_ADD(result, "coui11es");
-    SQIDS_BL_ADD(result, "coui1les");
-    SQIDS_BL_ADD(result, "couil1es");
-    SQIDS_BL_ADD(result, "couilles");
-    SQIDS_BL_ADD(result, "cracker");
-    SQIDS_BL_ADD(result, "crap");
-    SQIDS_BL_ADD(result, "cu10");
-    SQIDS_BL_ADD(result, "cu1att0ne");
-    SQIDS_BL_ADD(result, "cu1attone");
-    SQIDS_BL_ADD(result, "cu1er0");
-    SQIDS_BL_ADD(result, "cu1ero");
-    SQIDS_BL_ADD(result, "cu1o");
-    SQIDS_BL_ADD(result, "cul0");
-    SQIDS_BL_ADD(result, "culatt0ne");
-    SQIDS_BL_ADD(result, "culattone");
-    SQIDS_BL_ADD(result, "culer0");
-    SQIDS_BL_ADD(result, "culero");
-    SQIDS_BL_ADD(result, "culo");
-    SQIDS_BL_ADD(result, "cum");
-    SQIDS_BL_ADD(result, "cunt");
-    SQIDS_BL_ADD(result, "d11d0");
-    SQIDS_BL_ADD(result, "d11do");
-    SQIDS_BL_ADD(result, "d1ck");
-    SQIDS_BL_ADD(result, "d1ld0");
-    SQIDS_BL_ADD(result, "d1ldo");
-    SQIDS_BL_ADD(result, "damn");
-    SQIDS_BL_ADD(result, "de1ch");
-    SQIDS_BL_ADD(result, "deich");
-    SQIDS_BL_ADD(result, "depp");
-    SQIDS_BL_ADD(result, "di1d0");
-    SQIDS_BL_ADD(result, "di1do");
-    SQIDS_BL_ADD(result, "dick");
-    SQIDS_BL_ADD(result, "dild0");
-    SQIDS_BL_ADD(result, "dildo");
-    SQIDS_BL_ADD(result, "dyke");
-    SQIDS_BL_ADD(result, "encu1e");
-    SQIDS_BL_ADD(result, "encule");
-    SQIDS_BL_ADD(result, "enema");
-    SQIDS_BL_ADD(result, "enf01re");
-    SQIDS_BL_ADD(result, "enf0ire");
-    SQIDS_BL_ADD(result, "enfo1re");
-    SQIDS_BL_ADD(result, "enfoire");
-    SQIDS_BL_ADD(result, "estup1d0");
-    SQIDS_BL_ADD(result, "estup1do");
-    SQIDS_BL_ADD(result, "estupid0");
-    SQIDS_BL_ADD(result, "estupido");
-    SQIDS_BL_ADD(result, "etr0n");
-    SQIDS_BL_ADD(result, "etron");
-    SQIDS_BL_ADD(result, "f0da");
-    SQIDS_BL_ADD(result, "f0der");
-    SQIDS_BL_ADD(result, "f0ttere");
-    SQIDS_BL_ADD(result, "f0tters1");
-    SQIDS_BL_ADD(result, "f0ttersi");
-    SQIDS_BL_ADD(result, "f0tze");
-    SQIDS_BL_ADD(result, "f0utre");
-    SQIDS_BL_ADD(result, "f1ca");
-    SQIDS_BL_ADD(result, "f1cker");
-    SQIDS_BL_ADD(result, "f1ga");
-    SQIDS_BL_ADD(result, "fag");
-    SQIDS_BL_ADD(result, "fica");
-    SQIDS_BL_ADD(result, "ficker");
-    SQIDS_BL_ADD(result, "figa");
-    SQIDS_BL_ADD(result, "foda");
-    SQIDS_BL_ADD(result, "foder");
-    SQIDS_BL_ADD(result, "fottere");
-    SQIDS_BL_ADD(result, "fotters1");
-    SQIDS_BL_ADD(result, "fottersi");
-    SQIDS_BL_ADD(result, "fotze");
-    SQIDS_BL_ADD(result, "foutre");
-    SQIDS_BL_ADD(result, "fr0c10");
-    SQIDS_BL_ADD(result, "fr0c1o");
-    SQIDS_BL_ADD(result, "fr0ci0");
-    SQIDS_BL_ADD(result, "fr0cio");
-    SQIDS_BL_ADD(result, "fr0sc10");
-    SQIDS_BL_ADD(result, "fr0sc1o");
-    SQIDS_BL_ADD(result, "fr0sci0");
-    SQIDS_BL_ADD(result, "fr0scio");
-    SQIDS_BL_ADD(result, "froc10");
-    SQIDS_BL_ADD(result, "froc1o");
-    SQIDS_BL_ADD(result, "froci0");
-    SQIDS_BL_ADD(result, "frocio");
-    SQIDS_BL_ADD(result, "frosc10");
-    SQIDS_BL_ADD(result, "frosc1o");
-    SQIDS_BL_ADD(result, "frosci0");
-    SQIDS_BL_ADD(result, "froscio");
-    SQIDS_BL_ADD(result, "fuck");
-    SQIDS_BL_ADD(result, "g00");
-    SQIDS_BL_ADD(result, "g0o");
-    SQIDS_BL_ADD(result, "g0u1ne");
-    SQIDS_BL_ADD(result, "g0uine");
-    SQIDS_BL_ADD(result, "gandu");
-    SQIDS_BL_ADD(result, "go0");
-    SQIDS_BL_ADD(result, "goo");
-    SQIDS_BL_ADD(result, "gou1ne");
-    SQIDS_BL_ADD(result, "gouine");
-    SQIDS_BL_ADD(result, "gr0gnasse");
-    SQIDS_BL_ADD(result, "grognasse");
-    SQIDS_BL_ADD(result, "haram1");
-    SQIDS_BL_ADD(result, "harami");
-    SQIDS_BL_ADD(result, "haramzade");
-    SQIDS_BL_ADD(result, "hund1n");
-    SQIDS_BL_ADD(result, "hundin");
-    SQIDS_BL_ADD(result, "id10t");
-    SQIDS_BL_ADD(result, "id1ot");
-    SQIDS_BL_ADD(result, "idi0t");
-    SQIDS_BL_ADD(result, "idiot");
-    SQIDS_BL_ADD(result, "imbec11e");
-    SQIDS_BL_ADD(result, "imbec1le");
-    SQIDS_BL_ADD(result, "imbeci1e");
-    SQIDS_BL_ADD(result, "imbecile");
-    SQIDS_BL_ADD(result, "j1zz");
-    SQIDS_BL_ADD(result, "jerk");
-    SQIDS_BL_ADD(result, "jizz");
-    SQIDS_BL_ADD(result, "k1ke");
-    SQIDS_BL_ADD(result, "kam1ne");
-    SQIDS_BL_ADD(result, "kamine");
-    SQIDS_BL_ADD(result, "kike");
-    SQIDS_BL_ADD(result, "leccacu10");
-    SQIDS_BL_ADD(result, "leccacu1o");
-    SQIDS_BL_ADD(result, "leccacul0");
-    SQIDS_BL_ADD(result, "leccaculo");
-    SQIDS_BL_ADD(result, "m1erda");
-    SQIDS_BL_ADD(result, "m1gn0tta");
-    SQIDS_BL_ADD(result, "m1gnotta");
-    SQIDS_BL_ADD(result, "m1nch1a");
-    SQIDS_BL_ADD(result, "m1nchia");
-    SQIDS_BL_ADD(result, "m1st");
-    SQIDS_BL_ADD(result, "mam0n");
-    SQIDS_BL_ADD(result, "mamahuev0");
-    SQIDS_BL_ADD(result, "mamahuevo");
-    SQIDS_BL_ADD(result, "mamon");
-    SQIDS_BL_ADD(result, "masturbat10n");
-    SQIDS_BL_ADD(result, "masturbat1on");
-    SQIDS_BL_ADD(result, "masturbate");
-    SQIDS_BL_ADD(result, "masturbati0n");
-    SQIDS_BL_ADD(result, "masturbation");
-    SQIDS_BL_ADD(result, "merd0s0");
-    SQIDS_BL_ADD(result, "merd0so");
-    SQIDS_BL_ADD(result, "merda");
-    SQIDS_BL_ADD(result, "merde");
-    SQIDS_BL_ADD(result, "merdos0");
-    SQIDS_BL_ADD(result, "merdoso");
-    SQIDS_BL_ADD(result, "mierda");
-    SQIDS_BL_ADD(result, "mign0tta");
-    SQIDS_BL_ADD(result, "mignotta");
-    SQIDS_BL_ADD(result, "minch1a");
-    SQIDS_BL_ADD(result, "minchia");
-    SQIDS_BL_ADD(result, "mist");
-    SQIDS_BL_ADD(result, "musch1");
-    SQIDS_BL_ADD(result, "muschi");
-    SQIDS_BL_ADD(result, "n1gger");
-    SQIDS_BL_ADD(result, "neger");
-    SQIDS_BL_ADD(result, "negr0");
-    SQIDS_BL_ADD(result, "negre");
-    SQIDS_BL_ADD(result, "negro");
-    SQIDS_BL_ADD(result, "nerch1a");
-    SQIDS_BL_ADD(result, "nerchia");
-    SQIDS_BL_ADD(result, "nigger");
-    SQIDS_BL_ADD(result, "orgasm");
-    SQIDS_BL_ADD(result, "p00p");
-    SQIDS_BL_ADD(result, "p011a");
-    SQIDS_BL_ADD(result, "p01la");
-    SQIDS_BL_ADD(result, "p0l1a");
-    SQIDS_BL_ADD(result, "p0lla");
-    SQIDS_BL_ADD(result, "p0mp1n0");
-    SQIDS_BL_ADD(result, "p0mp1no");
-    SQIDS_BL_ADD(result, "p0mpin0");
-    SQIDS_BL_ADD(result, "p0mpino");
-    SQIDS_BL_ADD(result, "p0op");
-    SQIDS_BL_ADD(result, "p0rca");
-    SQIDS_BL_ADD(result, "p0rn");
-    SQIDS_BL_ADD(result, "p0rra");
-    SQIDS_BL_ADD(result, "p0uff1asse");
-    SQIDS_BL_ADD(result, "p0uffiasse");
-    SQIDS_BL_ADD(result, "p1p1");
-    SQIDS_BL_ADD(result, "p1pi");
-    SQIDS_BL_ADD(result, "p1r1a");
-    SQIDS_BL_ADD(result, "p1rla");
-    SQIDS_BL_ADD(result, "p1sc10");
-    SQIDS_BL_ADD(result, "p1sc1o");
-    SQIDS_BL_ADD(result, "p1sci0");
-    SQIDS_BL_ADD(result, "p1scio");
-    SQIDS_BL_ADD(result, "p1sser");
-    SQIDS_BL_ADD(result, "pa11e");
-    SQIDS_BL_ADD(result, "pa1le");
-    SQIDS_BL_ADD(result, "pal1e");
-    SQIDS_BL_ADD(result, "palle");
-    SQIDS_BL_ADD(result, "pane1e1r0");
-    SQIDS_BL_ADD(result, "pane1e1ro");
-    SQIDS_BL_ADD(result, "pane1eir0");
-    SQIDS_BL_ADD(result, "pane1eiro");
-    SQIDS_BL_ADD(result, "panele1r0");
-    SQIDS_BL_ADD(result, "panele1ro");
-    SQIDS_BL_ADD(result, "paneleir0");
-    SQIDS_BL_ADD(result, "paneleiro");
-    SQIDS_BL_ADD(result, "patakha");
-    SQIDS_BL_ADD(result, "pec0r1na");
-    SQIDS_BL_ADD(result, "pec0rina");
-    SQIDS_BL_ADD(result, "pecor1na");
-    SQIDS_BL_ADD(result, "pecorina");
-    SQIDS_BL_ADD(result, "pen1s");
-    SQIDS_BL_ADD(result, "pendej0");
-    SQIDS_BL_ADD(result, "pendejo");
-    SQIDS_BL_ADD(result, "penis");
-    SQIDS_BL_ADD(result, "pip1");
-    SQIDS_BL_ADD(result, "pipi");
-    SQIDS_BL_ADD(result, "pir1a");
-    SQIDS_BL_ADD(result, "pirla");
-    SQIDS_BL_ADD(result, "pisc10");
-    SQIDS_BL_ADD(result, "pisc1o");
-    SQIDS_BL_ADD(result, "pisci0");
-    SQIDS_BL_ADD(result, "piscio");
-    SQIDS_BL_ADD(result, "pisser");
-    SQIDS_BL_ADD(result, "po0p");
-    SQIDS_BL_ADD(result, "po11a");
-    SQIDS_BL_ADD(result, "po1la");
-    SQIDS_BL_ADD(result, "pol1a");
-    SQIDS_BL_ADD(result, "polla");
-    SQIDS_BL_ADD(result, "pomp1n0");
-    SQIDS_BL_ADD(result, "pomp1no");
-    SQIDS_BL_ADD(result, "pompin0");
-    SQIDS_BL_ADD(result, "pompino");
-    SQIDS_BL_ADD(result, "poop");
-    SQIDS_BL_ADD(result, "porca");
-    SQIDS_BL_ADD(result, "porn");
-    SQIDS_BL_ADD(result, "porra");
-    SQIDS_BL_ADD(result, "pouff1asse");
-    SQIDS_BL_ADD(result, "pouffiasse");
-    SQIDS_BL_ADD(result, "pr1ck");
-    SQIDS_BL_ADD(result, "prick");
-    SQIDS_BL_ADD(result, "pussy");
-    SQIDS_BL_ADD(result, "put1za");
-    SQIDS_BL_ADD(result, "puta");
-    SQIDS_BL_ADD(result, "puta1n");
-    SQIDS_BL_ADD(result, "putain");
-    SQIDS_BL_ADD(result, "pute");
-    SQIDS_BL_ADD(result, "putiza");
-    SQIDS_BL_ADD(result, "puttana");
-    SQIDS_BL_ADD(result, "queca");
-    SQIDS_BL_ADD(result, "r0mp1ba11e");
-    SQIDS_BL_ADD(result, "r0mp1ba1le");
-    SQIDS_BL_ADD(result, "r0mp1bal1e");
-    SQIDS_BL_ADD(result, "r0mp1balle");
-    SQIDS_BL_ADD(result, "r0mpiba11e");
-    SQIDS_BL_ADD(result, "r0mpiba1le");
-    SQIDS_BL_ADD(result, "r0mpibal1e");
-    SQIDS_BL_ADD(result, "r0mpiballe");
-    SQIDS_BL_ADD(result, "rand1");
-    SQIDS_BL_ADD(result, "randi");
-    SQIDS_BL_ADD(result, "rape");
-    SQIDS_BL_ADD(result, "recch10ne");
-    SQIDS_BL_ADD(result, "recch1one");
-    SQIDS_BL_ADD(result, "recchi0ne");
-    SQIDS_BL_ADD(result, "recchione");
-    SQIDS_BL_ADD(result, "retard");
-    SQIDS_BL_ADD(result, "romp1ba11e");
-    SQIDS_BL_ADD(result, "romp1ba1le");
-    SQIDS_BL_ADD(result, "romp1bal1e");
-    SQIDS_BL_ADD(result, "romp1balle");
-    SQIDS_BL_ADD(result, "rompiba11e");
-    SQIDS_BL_ADD(result, "rompiba1le");
-    SQIDS_BL_ADD(result, "rompibal1e");
-    SQIDS_BL_ADD(result, "rompiballe");
-    SQIDS_BL_ADD(result, "ruff1an0");
-    SQIDS_BL_ADD(result, "ruff1ano");
-    SQIDS_BL_ADD(result, "ruffian0");
-    SQIDS_BL_ADD(result, "ruffiano");
-    SQIDS_BL_ADD(result, "s1ut");
-    SQIDS_BL_ADD(result, "sa10pe");
-    SQIDS_BL_ADD(result, "sa1aud");
-    SQIDS_BL_ADD(result, "sa1ope");
-    SQIDS_BL_ADD(result, "sacanagem");
-    SQIDS_BL_ADD(result, "sal0pe");
-    SQIDS_BL_ADD(result, "salaud");
-    SQIDS_BL_ADD(result, "salope");
-    SQIDS_BL_ADD(result, "saugnapf");
-    SQIDS_BL_ADD(result, "sb0rr0ne");
-    SQIDS_BL_ADD(result, "sb0rra");
-    SQIDS_BL_ADD(result, "sb0rrone");
-    SQIDS_BL_ADD(result, "sbattere");
-    SQIDS_BL_ADD(result, "sbatters1");
-    SQIDS_BL_ADD(result, "sbattersi");
-    SQIDS_BL_ADD(result, "sborr0ne");
-    SQIDS_BL_ADD(result, "sborra");
-    SQIDS_BL_ADD(result, "sborrone");
-    SQIDS_BL_ADD(result, "sc0pare");
-    SQIDS_BL_ADD(result, "sc0pata");
-    SQIDS_BL_ADD(result, "sch1ampe");
-    SQIDS_BL_ADD(result, "sche1se");
-    SQIDS_BL_ADD(result, "sche1sse");
-    SQIDS_BL_ADD(result, "scheise");
-    SQIDS_BL_ADD(result, "scheisse");
-    SQIDS_BL_ADD(result, "schlampe");
-    SQIDS_BL_ADD(result, "schwachs1nn1g");
-    SQIDS_BL_ADD(result, "schwachs1nnig");
-    SQIDS_BL_ADD(result, "schwachsinn1g");
-    SQIDS_BL_ADD(result, "schwachsinnig");
-    SQIDS_BL_ADD(result, "schwanz");
-    SQIDS_BL_ADD(result, "scopare");
-    SQIDS_BL_ADD(result, "scopata");
-    SQIDS_BL_ADD(result, "sexy");
-    SQIDS_BL_ADD(result, "sh1t");
-    SQIDS_BL_ADD(result, "shit");
-    SQIDS_BL_ADD(result, "slut");
-    SQIDS_BL_ADD(result, "sp0mp1nare");
-    SQIDS_BL_ADD(result, "sp0mpinare");
-    SQIDS_BL_ADD(result, "spomp1nare");
-    SQIDS_BL_ADD(result, "spompinare");
-    SQIDS_BL_ADD(result, "str0nz0");
-    SQIDS_BL_ADD(result, "str0nza");
-    SQIDS_BL_ADD(result, "str0nzo");
-    SQIDS_BL_ADD(result, "stronz0");
-    SQIDS_BL_ADD(result, "stronza");
-    SQIDS_BL_ADD(result, "stronzo");
-    SQIDS_BL_ADD(result, "stup1d");
-    SQIDS_BL_ADD(result, "stupid");
-    SQIDS_BL_ADD(result, "succh1am1");
-    SQIDS_BL_ADD(result, "succh1ami");
-    SQIDS_BL_ADD(result, "succhiam1");
-    SQIDS_BL_ADD(result, "succhiami");
-    SQIDS_BL_ADD(result, "sucker");
-    SQIDS_BL_ADD(result, "t0pa");
-    SQIDS_BL_ADD(result, "tapette");
-    SQIDS_BL_ADD(result, "test1c1e");
-    SQIDS_BL_ADD(result, "test1cle");
-    SQIDS_BL_ADD(result, "testic1e");
-    SQIDS_BL_ADD(result, "testicle");
-    SQIDS_BL_ADD(result, "tette");
-    SQIDS_BL_ADD(result, "topa");
-    SQIDS_BL_ADD(result, "tr01a");
-    SQIDS_BL_ADD(result, "tr0ia");
-    SQIDS_BL_ADD(result, "tr0mbare");
-    SQIDS_BL_ADD(result, "tr1ng1er");
-    SQIDS_BL_ADD(result, "tr1ngler");
-    SQIDS_BL_ADD(result, "tring1er");
-    SQIDS_BL_ADD(result, "tringler");
-    SQIDS_BL_ADD(result, "tro1a");
-    SQIDS_BL_ADD(result, "troia");
-    SQIDS_BL_ADD(result, "trombare");
-    SQIDS_BL_ADD(result, "turd");
-    SQIDS_BL_ADD(result, "twat");
-    SQIDS_BL_ADD(result, "vaffancu10");
-    SQIDS_BL_ADD(result, "vaffancu1o");
-    SQIDS_BL_ADD(result, "vaffancul0");
-    SQIDS_BL_ADD(result, "vaffanculo");
-    SQIDS_BL_ADD(result, "vag1na");
-    SQIDS_BL_ADD(result, "vagina");
-    SQIDS_BL_ADD(result, "verdammt");
-    SQIDS_BL_ADD(result, "verga");
-    SQIDS_BL_ADD(result, "w1chsen");
-    SQIDS_BL_ADD(result, "wank");
-    SQIDS_BL_ADD(result, "wichsen");
-    SQIDS_BL_ADD(result, "x0ch0ta");
-    SQIDS_BL_ADD(result, "x0chota");
-    SQIDS_BL_ADD(result, "xana");
-    SQIDS_BL_ADD(result, "xoch0ta");
-    SQIDS_BL_ADD(result, "xochota");
-    SQIDS_BL_ADD(result, "z0cc01a");
-    SQIDS_BL_ADD(result, "z0cc0la");
-    SQIDS_BL_ADD(result, "z0cco1a");
-    SQIDS_BL_ADD(result, "z0ccola");
-    SQIDS_BL_ADD(result, "z1z1");
-    SQIDS_BL_ADD(result, "z1zi");
-    SQIDS_BL_ADD(result, "ziz1");
-    SQIDS_BL_ADD(result, "zizi");
-    SQIDS_BL_ADD(result, "zocc01a");
-    SQIDS_BL_ADD(result, "zocc0la");
-    SQIDS_BL_ADD(result, "zocco1a");
-    SQIDS_BL_ADD(result, "zoccola");
-
-    return result;
-}
-
-#undef SQIDS_BL_ADD
-
+/* every default word once, along with the languages it belongs to */
+const sqids_bl_word_t sqids_bl_words[] = {
+#if defined(SQIDS_DEFAULT_BLOCKLIST) && SQIDS_DEFAULT_BLOCKLIST == 1
+    {"0rgasm", SQIDS_BL_EN},
+    {"1d10t", SQIDS_BL_EN},
+    {"1d1ot", SQIDS_BL_EN},
+    {"1di0t", SQIDS_BL_EN},
+    {"1diot", SQIDS_BL_EN},
+    {"1eccacu10", SQIDS_BL_IT},
+    {"1eccacu1o", SQIDS_BL_IT},
+    {"1eccacul0", SQIDS_BL_IT},
+    {"1eccaculo", SQIDS_BL_IT},
+    {"1mbec11e", SQIDS_BL_EN},
+    {"1mbec1le", SQIDS_BL_EN},
+    {"1mbeci1e", SQIDS_BL_EN},
+    {"1mbecile", SQIDS_BL_EN},
+    {"a11upat0", SQIDS_BL_IT},
+    {"a11upato", SQIDS_BL_IT},
+    {"a1lupat0", SQIDS_BL_IT},
+    {"a1lupato", SQIDS_BL_IT},
+    {"aand", SQIDS_BL_HI},
+    {"ah01e", SQIDS_BL_EN},
+    {"ah0le", SQIDS_BL_EN},
+    {"aho1e", SQIDS_BL_EN},
+    {"ahole", SQIDS_BL_EN},
+    {"al1upat0", SQIDS_BL_IT},
+    {"al1upato", SQIDS_BL_IT},
+    {"allupat0", SQIDS_BL_IT},
+    {"allupato", SQIDS_BL_IT},
+    {"ana1", SQIDS_BL_EN},
+    {"ana1e", SQIDS_BL_IT},
+    {"anal", SQIDS_BL_EN},
+    {"anale", SQIDS_BL_IT},
+    {"anus", SQIDS_BL_EN},
+    {"arrapat0", SQIDS_BL_IT},
+    {"arrapato", SQIDS_BL_IT},
+    {"arsch", SQIDS_BL_DE},
+    {"arse", SQIDS_BL_EN},
+    {"ass", SQIDS_BL_EN},
+    {"b00b", SQIDS_BL_EN},
+    {"b00be", SQIDS_BL_HI},
+    {"b01ata", SQIDS_BL_IT},
+    {"b0ceta", SQIDS_BL_PT},
+    {"b0iata", SQIDS_BL_IT},
+    {"b0ob", SQIDS_BL_EN},
+    {"b0obe", SQIDS_BL_HI},
+    {"b0sta", SQIDS_BL_PT},
+    {"b1tch", SQIDS_BL_EN},
+    {"b1te", SQIDS_BL_FR},
+    {"b1tte", SQIDS_BL_FR},
+    {"ba1atkar", SQIDS_BL_HI},
+    {"balatkar", SQIDS_BL_HI},
+    {"bastard0", SQIDS_BL_PT},
+    {"bastardo", SQIDS_BL_PT},
+    {"batt0na", SQIDS_BL_IT},
+    {"battona", SQIDS_BL_IT},
+    {"bitch", SQIDS_BL_EN},
+    {"bite", SQIDS_BL_FR},
+    {"bitte", SQIDS_BL_FR},
+    {"bo0b", SQIDS_BL_EN},
+    {"bo0be", SQIDS_BL_HI},
+    {"bo1ata", SQIDS_BL_IT},
+    {"boceta", SQIDS_BL_PT},
+    {"boiata", SQIDS_BL_IT},
+    {"boob", SQIDS_BL_EN},
+    {"boobe", SQIDS_BL_HI},
+    {"bosta", SQIDS_BL_PT},
+    {"bran1age", SQIDS_BL_FR},
+    {"bran1er", SQIDS_BL_FR},
+    {"bran1ette", SQIDS_BL_FR},
+    {"bran1eur", SQIDS_BL_FR},
+    {"bran1euse", SQIDS_BL_FR},
+    {"branlage", SQIDS_BL_FR},
+    {"branler", SQIDS_BL_FR},
+    {"branlette", SQIDS_BL_FR},
+    {"branleur", SQIDS_BL_FR},
+    {"branleuse", SQIDS_BL_FR},
+    {"c0ck", SQIDS_BL_EN},
+    {"c0g110ne", SQIDS_BL_IT},
+    {"c0g11one", SQIDS_BL_IT},
+    {"c0g1i0ne", SQIDS_BL_IT},
+    {"c0g1ione", SQIDS_BL_IT},
+    {"c0gl10ne", SQIDS_BL_IT},
+    {"c0gl1one", SQIDS_BL_IT},
+    {"c0gli0ne", SQIDS_BL_IT},
+    {"c0glione", SQIDS_BL_IT},
+    {"c0na", SQIDS_BL_PT},
+    {"c0nnard", SQIDS_BL_FR},
+    {"c0nnasse", SQIDS_BL_FR},
+    {"c0nne", SQIDS_BL_FR},
+    {"c0u111es", SQIDS_BL_FR},
+    {"c0u11les", SQIDS_BL_FR},
+    {"c0u1l1es", SQIDS_BL_FR},
+    {"c0u1lles", SQIDS_BL_FR},
+    {"c0ui11es", SQIDS_BL_FR},
+    {"c0ui1les", SQIDS_BL_FR},
+    {"c0uil1es", SQIDS_BL_FR},
+    {"c0uilles", SQIDS_BL_FR},
+    {"c11t", SQIDS_BL_EN},
+    {"c11t0", SQIDS_BL_FR},
+    {"c11to", SQIDS_BL_FR},
+    {"c1it", SQIDS_BL_EN},
+    {"c1it0", SQIDS_BL_FR},
+    {"c1ito", SQIDS_BL_FR},
+    {"cabr0n", SQIDS_BL_ES},
+    {"cabra0", SQIDS_BL_PT},
+    {"cabrao", SQIDS_BL_PT},
+    {"cabron", SQIDS_BL_ES},
+    {"caca", SQIDS_BL_FR},
+    {"cacca", SQIDS_BL_IT},
+    {"cacete", SQIDS_BL_PT},
+    {"cagante", SQIDS_BL_ES},
+    {"cagar", SQIDS_BL_PT},
+    {"cagare", SQIDS_BL_IT},
+    {"cagna", SQIDS_BL_IT},
+    {"cara1h0", SQIDS_BL_PT},
+    {"cara1ho", SQIDS_BL_PT},
+    {"caracu10", SQIDS_BL_ES},
+    {"caracu1o", SQIDS_BL_ES},
+    {"caracul0", SQIDS_BL_ES},
+    {"caraculo", SQIDS_BL_ES},
+    {"caralh0", SQIDS_BL_PT},
+    {"caralho", SQIDS_BL_PT},
+    {"cazz0", SQIDS_BL_IT},
+    {"cazz1mma", SQIDS_BL_IT},
+    {"cazzata", SQIDS_BL_IT},
+    {"cazzimma", SQIDS_BL_IT},
+    {"cazzo", SQIDS_BL_IT},
+    {"ch00t1a", SQIDS_BL_HI},
+    {"ch00t1ya", SQIDS_BL_HI},
+    {"ch00tia", SQIDS_BL_HI},
+    {"ch00tiya", SQIDS_BL_HI},
+    {"ch0d", SQIDS_BL_HI},
+    {"ch0ot1a", SQIDS_BL_HI},
+    {"ch0ot1ya", SQIDS_BL_HI},
+    {"ch0otia", SQIDS_BL_HI},
+    {"ch0otiya", SQIDS_BL_HI},
+    {"ch1asse", SQIDS_BL_FR},
+    {"ch1avata", SQIDS_BL_IT},
+    {"ch1er", SQIDS_BL_FR},
+    {"ch1ng0", SQIDS_BL_ES},
+    {"ch1ngadaz0s", SQIDS_BL_ES},
+    {"ch1ngadazos", SQIDS_BL_ES},
+    {"ch1ngader1ta", SQIDS_BL_ES},
+    {"ch1ngaderita", SQIDS_BL_ES},
+    {"ch1ngar", SQIDS_BL_ES},
+    {"ch1ngo", SQIDS_BL_ES},
+    {"ch1ngues", SQIDS_BL_ES},
+    {"ch1nk", SQIDS_BL_EN},
+    {"chatte", SQIDS_BL_FR},
+    {"chiasse", SQIDS_BL_FR},
+    {"chiavata", SQIDS_BL_IT},
+    {"chier", SQIDS_BL_FR},
+    {"ching0", SQIDS_BL_ES},
+    {"chingadaz0s", SQIDS_BL_ES},
+    {"chingadazos", SQIDS_BL_ES},
+    {"chingader1ta", SQIDS_BL_ES},
+    {"chingaderita", SQIDS_BL_ES},
+    {"chingar", SQIDS_BL_ES},
+    {"chingo", SQIDS_BL_ES},
+    {"chingues", SQIDS_BL_ES},
+    {"chink", SQIDS_BL_EN},
+    {"cho0t1a", SQIDS_BL_HI},
+    {"cho0t1ya", SQIDS_BL_HI},
+    {"cho0tia", SQIDS_BL_HI},
+    {"cho0tiya", SQIDS_BL_HI},
+    {"chod", SQIDS_BL_HI},
+    {"choot1a", SQIDS_BL_HI},
+    {"choot1ya", SQIDS_BL_HI},
+    {"chootia", SQIDS_BL_HI},
+    {"chootiya", SQIDS_BL_HI},
+    {"cl1t", SQIDS_BL_EN},
+    {"cl1t0", SQIDS_BL_FR},
+    {"cl1to", SQIDS_BL_FR},
+    {"clit", SQIDS_BL_EN},
+    {"clit0", SQIDS_BL_FR},
+    {"clito", SQIDS_BL_FR},
+    {"cock", SQIDS_BL_EN},
+    {"cog110ne", SQIDS_BL_IT},
+    {"cog11one", SQIDS_BL_IT},
+    {"cog1i0ne", SQIDS_BL_IT},
+    {"cog1ione", SQIDS_BL_IT},
+    {"cogl10ne", SQIDS_BL_IT},
+    {"cogl1one", SQIDS_BL_IT},
+    {"cogli0ne", SQIDS_BL_IT},
+    {"coglione", SQIDS_BL_IT},
+    {"cona", SQIDS_BL_PT},
+    {"connard", SQIDS_BL_FR},
+    {"connasse", SQIDS_BL_FR},
+    {"conne", SQIDS_BL_FR},
+    {"cou111es", SQIDS_BL_FR},
+    {"cou11les", SQIDS_BL_FR},
+    {"cou1l1es", SQIDS_BL_FR},
+    {"cou1lles", SQIDS_BL_FR},
+    {"coui11es", SQIDS_BL_FR},
+    {"coui1les", SQIDS_BL_FR},
+    {"couil1es", SQIDS_BL_FR},
+    {"couilles", SQIDS_BL_FR},
+    {"cracker", SQIDS_BL_EN},
+    {"crap", SQIDS_BL_EN},
+    {"cu10", SQIDS_BL_IT},
+    {"cu1att0ne", SQIDS_BL_IT},
+    {"cu1attone", SQIDS_BL_IT},
+    {"cu1er0", SQIDS_BL_ES},
+    {"cu1ero", SQIDS_BL_ES},
+    {"cu1o", SQIDS_BL_IT},
+    {"cul0", SQIDS_BL_IT},
+    {"culatt0ne", SQIDS_BL_IT},
+    {"culattone", SQIDS_BL_IT},
+    {"culer0", SQIDS_BL_ES},
+    {"culero", SQIDS_BL_ES},
+    {"culo", SQIDS_BL_IT},
+    {"cum", SQIDS_BL_EN},
+    {"cunt", SQIDS_BL_EN},
+    {"d11d0", SQIDS_BL_EN},
+    {"d11do", SQIDS_BL_EN},
+    {"d1ck", SQIDS_BL_EN},
+    {"d1ld0", SQIDS_BL_EN},
+    {"d1ldo", SQIDS_BL_EN},
+    {"damn", SQIDS_BL_EN},
+    {"de1ch", SQIDS_BL_DE},
+    {"deich", SQIDS_BL_DE},
+    {"depp", SQIDS_BL_DE},
+    {"di1d0", SQIDS_BL_EN},
+    {"di1do", SQIDS_BL_EN},
+    {"dick", SQIDS_BL_EN},
+    {"dild0", SQIDS_BL_EN},
+    {"dildo", SQIDS_BL_EN},
+    {"dyke", SQIDS_BL_EN},
+    {"encu1e", SQIDS_BL_FR},
+    {"encule", SQIDS_BL_FR},
+    {"enema", SQIDS_BL_EN},
+    {"enf01re", SQIDS_BL_FR},
+    {"enf0ire", SQIDS_BL_FR},
+    {"enfo1re", SQIDS_BL_FR},
+    {"enfoire", SQIDS_BL_FR},
+    {"estup1d0", SQIDS_BL_ES},
+    {"estup1do", SQIDS_BL_ES},
+    {"estupid0", SQIDS_BL_ES},
+    {"estupido", SQIDS_BL_ES},
+    {"etr0n", SQIDS_BL_FR},
+    {"etron", SQIDS_BL_FR},
+    {"f0da", SQIDS_BL_PT},
+    {"f0der", SQIDS_BL_PT},
+    {"f0ttere", SQIDS_BL_IT},
+    {"f0tters1", SQIDS_BL_IT},
+    {"f0ttersi", SQIDS_BL_IT},
+    {"f0tze", SQIDS_BL_DE},
+    {"f0utre", SQIDS_BL_FR},
+    {"f1ca", SQIDS_BL_IT},
+    {"f1cker", SQIDS_BL_DE},
+    {"f1ga", SQIDS_BL_IT},
+    {"fag", SQIDS_BL_EN},
+    {"fica", SQIDS_BL_IT},
+    {"ficker", SQIDS_BL_DE},
+    {"figa", SQIDS_BL_IT},
+    {"foda", SQIDS_BL_PT},
+    {"foder", SQIDS_BL_PT},
+    {"fottere", SQIDS_BL_IT},
+    {"fotters1", SQIDS_BL_IT},
+    {"fottersi", SQIDS_BL_IT},
+    {"fotze", SQIDS_BL_DE},
+    {"foutre", SQIDS_BL_FR},
+    {"fr0c10", SQIDS_BL_IT},
+    {"fr0c1o", SQIDS_BL_IT},
+    {"fr0ci0", SQIDS_BL_IT},
+    {"fr0cio", SQIDS_BL_IT},
+    {"fr0sc10", SQIDS_BL_IT},
+    {"fr0sc1o", SQIDS_BL_IT},
+    {"fr0sci0", SQIDS_BL_IT},
+    {"fr0scio", SQIDS_BL_IT},
+    {"froc10", SQIDS_BL_IT},
+    {"froc1o", SQIDS_BL_IT},
+    {"froci0", SQIDS_BL_IT},
+    {"frocio", SQIDS_BL_IT},
+    {"frosc10", SQIDS_BL_IT},
+    {"frosc1o", SQIDS_BL_IT},
+    {"frosci0", SQIDS_BL_IT},
+    {"froscio", SQIDS_BL_IT},
+    {"fuck", SQIDS_BL_EN},
+    {"g00", SQIDS_BL_HI},
+    {"g0o", SQIDS_BL_HI},
+    {"g0u1ne", SQIDS_BL_FR},
+    {"g0uine", SQIDS_BL_FR},
+    {"gandu", SQIDS_BL_HI},
+    {"go0", SQIDS_BL_HI},
+    {"goo", SQIDS_BL_HI},
+    {"gou1ne", SQIDS_BL_FR},
+    {"gouine", SQIDS_BL_FR},
+    {"gr0gnasse", SQIDS_BL_FR},
+    {"grognasse", SQIDS_BL_FR},
+    {"haram1", SQIDS_BL_HI},
+    {"harami", SQIDS_BL_HI},
+    {"haramzade", SQIDS_BL_HI},
+    {"hund1n", SQIDS_BL_DE},
+    {"hundin", SQIDS_BL_DE},
+    {"id10t", SQIDS_BL_EN},
+    {"id1ot", SQIDS_BL_EN},
+    {"idi0t", SQIDS_BL_EN},
+    {"idiot", SQIDS_BL_EN},
+    {"imbec11e", SQIDS_BL_EN},
+    {"imbec1le", SQIDS_BL_EN},
+    {"imbeci1e", SQIDS_BL_EN},
+    {"imbecile", SQIDS_BL_EN},
+    {"j1zz", SQIDS_BL_EN},
+    {"jerk", SQIDS_BL_EN},
+    {"jizz", SQIDS_BL_EN},
+    {"k1ke", SQIDS_BL_EN},
+    {"kam1ne", SQIDS_BL_HI},
+    {"kamine", SQIDS_BL_HI},
+    {"kike", SQIDS_BL_EN},
+    {"leccacu10", SQIDS_BL_IT},
+    {"leccacu1o", SQIDS_BL_IT},
+    {"leccacul0", SQIDS_BL_IT},
+    {"leccaculo", SQIDS_BL_IT},
+    {"m1erda", SQIDS_BL_ES},
+    {"m1gn0tta", SQIDS_BL_IT},
+    {"m1gnotta", SQIDS_BL_IT},
+    {"m1nch1a", SQIDS_BL_IT},
+    {"m1nchia", SQIDS_BL_IT},
+    {"m1st", SQIDS_BL_DE},
+    {"mam0n", SQIDS_BL_ES},
+    {"mamahuev0", SQIDS_BL_ES},
+    {"mamahuevo", SQIDS_BL_ES},
+    {"mamon", SQIDS_BL_ES},
+    {"masturbat10n", SQIDS_BL_EN},
+    {"masturbat1on", SQIDS_BL_EN},
+    {"masturbate", SQIDS_BL_EN},
+    {"masturbati0n", SQIDS_BL_EN},
+    {"masturbation", SQIDS_BL_EN},
+    {"merd0s0", SQIDS_BL_IT},
+    {"merd0so", SQIDS_BL_IT},
+    {"merda", SQIDS_BL_IT | SQIDS_BL_PT},
+    {"merde", SQIDS_BL_FR},
+    {"merdos0", SQIDS_BL_IT},
+    {"merdoso", SQIDS_BL_IT},
+    {"mierda", SQIDS_BL_ES},
+    {"mign0tta", SQIDS_BL_IT},
+    {"mignotta", SQIDS_BL_IT},
+    {"minch1a", SQIDS_BL_IT},
+    {"minchia", SQIDS_BL_IT},
+    {"mist", SQIDS_BL_DE},
+    {"musch1", SQIDS_BL_DE},
+    {"muschi", SQIDS_BL_DE},
+    {"n1gger", SQIDS_BL_EN},
+    {"neger", SQIDS_BL_DE},
+    {"negr0", SQIDS_BL_EN},
+    {"negre", SQIDS_BL_FR},
+    {"negro", SQIDS_BL_EN},
+    {"nerch1a", SQIDS_BL_IT},
+    {"nerchia", SQIDS_BL_IT},
+    {"nigger", SQIDS_BL_EN},
+    {"orgasm", SQIDS_BL_EN},
+    {"p00p", SQIDS_BL_EN},
+    {"p011a", SQIDS_BL_ES},
+    {"p01la", SQIDS_BL_ES},
+    {"p0l1a", SQIDS_BL_ES},
+    {"p0lla", SQIDS_BL_ES},
+    {"p0mp1n0", SQIDS_BL_IT},
+    {"p0mp1no", SQIDS_BL_IT},
+    {"p0mpin0", SQIDS_BL_IT},
+    {"p0mpino", SQIDS_BL_IT},
+    {"p0op", SQIDS_BL_EN},
+    {"p0rca", SQIDS_BL_IT},
+    {"p0rn", SQIDS_BL_EN},
+    {"p0rra", SQIDS_BL_PT},
+    {"p0uff1asse", SQIDS_BL_FR},
+    {"p0uffiasse", SQIDS_BL_FR},
+    {"p1p1", SQIDS_BL_FR},
+    {"p1pi", SQIDS_BL_FR},
+    {"p1r1a", SQIDS_BL_IT},
+    {"p1rla", SQIDS_BL_IT},
+    {"p1sc10", SQIDS_BL_IT},
+    {"p1sc1o", SQIDS_BL_IT},
+    {"p1sci0", SQIDS_BL_IT},
+    {"p1scio", SQIDS_BL_IT},
+    {"p1sser", SQIDS_BL_FR},
+    {"pa11e", SQIDS_BL_IT},
+    {"pa1le", SQIDS_BL_IT},
+    {"pal1e", SQIDS_BL_IT},
+    {"palle", SQIDS_BL_IT},
+    {"pane1e1r0", SQIDS_BL_PT},
+    {"pane1e1ro", SQIDS_BL_PT},
+    {"pane1eir0", SQIDS_BL_PT},
+    {"pane1eiro", SQIDS_BL_PT},
+    {"panele1r0", SQIDS_BL_PT},
+    {"panele1ro", SQIDS_BL_PT},
+    {"paneleir0", SQIDS_BL_PT},
+    {"paneleiro", SQIDS_BL_PT},
+    {"patakha", SQIDS_BL_HI},
+    {"pec0r1na", SQIDS_BL_IT},
+    {"pec0rina", SQIDS_BL_IT},
+    {"pecor1na", SQIDS_BL_IT},
+    {"pecorina", SQIDS_BL_IT},
+    {"pen1s", SQIDS_BL_EN},
+    {"pendej0", SQIDS_BL_ES},
+    {"pendejo", SQIDS_BL_ES},
+    {"penis", SQIDS_BL_EN},
+    {"pip1", SQIDS_BL_FR},
+    {"pipi", SQIDS_BL_FR},
+    {"pir1a", SQIDS_BL_IT},
+    {"pirla", SQIDS_BL_IT},
+    {"pisc10", SQIDS_BL_IT},
+    {"pisc1o", SQIDS_BL_IT},
+    {"pisci0", SQIDS_BL_IT},
+    {"piscio", SQIDS_BL_IT},
+    {"pisser", SQIDS_BL_FR},
+    {"po0p", SQIDS_BL_EN},
+    {"po11a", SQIDS_BL_ES},
+    {"po1la", SQIDS_BL_ES},
+    {"pol1a", SQIDS_BL_ES},
+    {"polla", SQIDS_BL_ES},
+    {"pomp1n0", SQIDS_BL_IT},
+    {"pomp1no", SQIDS_BL_IT},
+    {"pompin0", SQIDS_BL_IT},
+    {"pompino", SQIDS_BL_IT},
+    {"poop", SQIDS_BL_EN},
+    {"porca", SQIDS_BL_IT},
+    {"porn", SQIDS_BL_EN},
+    {"porra", SQIDS_BL_PT},
+    {"pouff1asse", SQIDS_BL_FR},
+    {"pouffiasse", SQIDS_BL_FR},
+    {"pr1ck", SQIDS_BL_EN},
+    {"prick", SQIDS_BL_EN},
+    {"pussy", SQIDS_BL_EN},
+    {"put1za", SQIDS_BL_ES},
+    {"puta", SQIDS_BL_ES | SQIDS_BL_PT},
+    {"puta1n", SQIDS_BL_FR},
+    {"putain", SQIDS_BL_FR},
+    {"pute", SQIDS_BL_FR},
+    {"putiza", SQIDS_BL_ES},
+    {"puttana", SQIDS_BL_IT},
+    {"queca", SQIDS_BL_PT},
+    {"r0mp1ba11e", SQIDS_BL_IT},
+    {"r0mp1ba1le", SQIDS_BL_IT},
+    {"r0mp1bal1e", SQIDS_BL_IT},
+    {"r0mp1balle", SQIDS_BL_IT},
+    {"r0mpiba11e", SQIDS_BL_IT},
+    {"r0mpiba1le", SQIDS_BL_IT},
+    {"r0mpibal1e", SQIDS_BL_IT},
+    {"r0mpiballe", SQIDS_BL_IT},
+    {"rand1", SQIDS_BL_HI},
+    {"randi", SQIDS_BL_HI},
+    {"rape", SQIDS_BL_EN},
+    {"recch10ne", SQIDS_BL_IT},
+    {"recch1one", SQIDS_BL_IT},
+    {"recchi0ne", SQIDS_BL_IT},
+    {"recchione", SQIDS_BL_IT},
+    {"retard", SQIDS_BL_EN},
+    {"romp1ba11e", SQIDS_BL_IT},
+    {"romp1ba1le", SQIDS_BL_IT},
+    {"romp1bal1e", SQIDS_BL_IT},
+    {"romp1balle", SQIDS_BL_IT},
+    {"rompiba11e", SQIDS_BL_IT},
+    {"rompiba1le", SQIDS_BL_IT},
+    {"rompibal1e", SQIDS_BL_IT},
+    {"rompiballe", SQIDS_BL_IT},
+    {"ruff1an0", SQIDS_BL_IT},
+    {"ruff1ano", SQIDS_BL_IT},
+    {"ruffian0", SQIDS_BL_IT},
+    {"ruffiano", SQIDS_BL_IT},
+    {"s1ut", SQIDS_BL_EN},
+    {"sa10pe", SQIDS_BL_FR},
+    {"sa1aud", SQIDS_BL_FR},
+    {"sa1ope", SQIDS_BL_FR},
+    {"sacanagem", SQIDS_BL_PT},
+    {"sal0pe", SQIDS_BL_FR},
+    {"salaud", SQIDS_BL_FR},
+    {"salope", SQIDS_BL_FR},
+    {"saugnapf", SQIDS_BL_DE},
+    {"sb0rr0ne", SQIDS_BL_IT},
+    {"sb0rra", SQIDS_BL_IT},
+    {"sb0rrone", SQIDS_BL_IT},
+    {"sbattere", SQIDS_BL_IT},
+    {"sbatters1", SQIDS_BL_IT},
+    {"sbattersi", SQIDS_BL_IT},
+    {"sborr0ne", SQIDS_BL_IT},
+    {"sborra", SQIDS_BL_IT},
+    {"sborrone", SQIDS_BL_IT},
+    {"sc0pare", SQIDS_BL_IT},
+    {"sc0pata", SQIDS_BL_IT},
+    {"sch1ampe", SQIDS_BL_DE},
+    {"sche1se", SQIDS_BL_DE},
+    {"sche1sse", SQIDS_BL_DE},
+    {"scheise", SQIDS_BL_DE},
+    {"scheisse", SQIDS_BL_DE},
+    {"schlampe", SQIDS_BL_DE},
+    {"schwachs1nn1g", SQIDS_BL_DE},
+    {"schwachs1nnig", SQIDS_BL_DE},
+    {"schwachsinn1g", SQIDS_BL_DE},
+    {"schwachsinnig", SQIDS_BL_DE},
+    {"schwanz", SQIDS_BL_DE},
+    {"scopare", SQIDS_BL_IT},
+    {"scopata", SQIDS_BL_IT},
+    {"sexy", SQIDS_BL_EN},
+    {"sh1t", SQIDS_BL_EN},
+    {"shit", SQIDS_BL_EN},
+    {"slut", SQIDS_BL_EN},
+    {"sp0mp1nare", SQIDS_BL_IT},
+    {"sp0mpinare", SQIDS_BL_IT},
+    {"spomp1nare", SQIDS_BL_IT},
+    {"spompinare", SQIDS_BL_IT},
+    {"str0nz0", SQIDS_BL_IT},
+    {"str0nza", SQIDS_BL_IT},
+    {"str0nzo", SQIDS_BL_IT},
+    {"stronz0", SQIDS_BL_IT},
+    {"stronza", SQIDS_BL_IT},
+    {"stronzo", SQIDS_BL_IT},
+    {"stup1d", SQIDS_BL_EN},
+    {"stupid", SQIDS_BL_EN},
+    {"succh1am1", SQIDS_BL_IT},
+    {"succh1ami", SQIDS_BL_IT},
+    {"succhiam1", SQIDS_BL_IT},
+    {"succhiami", SQIDS_BL_IT},
+    {"sucker", SQIDS_BL_EN},
+    {"t0pa", SQIDS_BL_IT},
+    {"tapette", SQIDS_BL_FR},
+    {"test1c1e", SQIDS_BL_EN},
+    {"test1cle", SQIDS_BL_EN},
+    {"testic1e", SQIDS_BL_EN},
+    {"testicle", SQIDS_BL_EN},
+    {"tette", SQIDS_BL_IT},
+    {"topa", SQIDS_BL_IT},
+    {"tr01a", SQIDS_BL_IT},
+    {"tr0ia", SQIDS_BL_IT},
+    {"tr0mbare", SQIDS_BL_IT},
+    {"tr1ng1er", SQIDS_BL_FR},
+    {"tr1ngler", SQIDS_BL_FR},
+    {"tring1er", SQIDS_BL_FR},
+    {"tringler", SQIDS_BL_FR},
+    {"tro1a", SQIDS_BL_IT},
+    {"troia", SQIDS_BL_IT},
+    {"trombare", SQIDS_BL_IT},
+    {"turd", SQIDS_BL_EN},
+    {"twat", SQIDS_BL_EN},
+    {"vaffancu10", SQIDS_BL_IT},
+    {"vaffancu1o", SQIDS_BL_IT},
+    {"vaffancul0", SQIDS_BL_IT},
+    {"vaffanculo", SQIDS_BL_IT},
+    {"vag1na", SQIDS_BL_EN},
+    {"vagina", SQIDS_BL_EN},
+    {"verdammt", SQIDS_BL_DE},
+    {"verga", SQIDS_BL_ES},
+    {"w1chsen", SQIDS_BL_DE},
+    {"wank", SQIDS_BL_EN},
+    {"wichsen", SQIDS_BL_DE},
+    {"x0ch0ta", SQIDS_BL_PT},
+    {"x0chota", SQIDS_BL_PT},
+    {"xana", SQIDS_BL_PT},
+    {"xoch0ta", SQIDS_BL_PT},
+    {"xochota", SQIDS_BL_PT},
+    {"z0cc01a", SQIDS_BL_IT},
+    {"z0cc0la", SQIDS_BL_IT},
+    {"z0cco1a", SQIDS_BL_IT},
+    {"z0ccola", SQIDS_BL_IT},
+    {"z1z1", SQIDS_BL_FR},
+    {"z1zi", SQIDS_BL_FR},
+    {"ziz1", SQIDS_BL_FR},
+    {"zizi", SQIDS_BL_FR},
+    {"zocc01a", SQIDS_BL_IT},
+    {"zocc0la", SQIDS_BL_IT},
+    {"zocco1a", SQIDS_BL_IT},
+    {"zoccola", SQIDS_BL_IT},
 #endif
+    {NULL, 0},
+};
 
 /* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
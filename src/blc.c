@@ -0,0 +1,172 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+
+#include "sqids.h"
+#include "strerror.h"
+
+static void
+usage(const char *progname, FILE *out)
+{
+    fputs("\n", out);
+    fputs("Usage:\n", out);
+    fprintf(out, "  %s [options] -o <file>\n", progname);
+
+    fputs("\n", out);
+    fputs("Options:\n", out);
+    fputs("  -b, --default-blocklist   include a default blocklist "
+        "(de,en,es,fr,hi,it,pt,none,all) [none]\n", out);
+    fputs("  -w, --block-word          add a word to the blocklist\n", out);
+    fputs("  -f, --word-file           add the words of a file, one per "
+        "line\n", out);
+    fputs("  -o, --output              write the compiled blocklist to file\n",
+        out);
+    fputs("  -h, --help                print this message and exit\n", out);
+    fputs("  -v, --version             print version information and exit\n",
+        out);
+
+    fputs("\n", out);
+    exit(out == stderr ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/* add the words of a file, skipping blank lines */
+static int
+add_file(sqids_bl_t *blocklist, const char *path)
+{
+    FILE *in;
+    char line[4096];
+    size_t n;
+
+    if (!(in = fopen(path, "r"))) {
+        fprintf(stderr, "--word-file: %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), in)) {
+        for (n = strlen(line); n && (line[n - 1] == '\n' ||
+            line[n - 1] == '\r'); line[--n] = 0) {}
+
+        if (n && !sqids_bl_add_tail(blocklist, line)) {
+            fprintf(stderr, "sqids_bl_add_tail(): %s\n",
+                sqids_strerror(sqids_errno));
+            fclose(in);
+            return -1;
+        }
+    }
+
+    fclose(in);
+
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    sqids_bl_t *blocklist, *shared, *base;
+    sqids_bl_node_t *iter, *node;
+    char *output = NULL;
+    int ch;
+
+    static const struct option longopts[] = {
+        {"default-blocklist", required_argument, NULL, 'b'},
+        {"block-word", required_argument, NULL, 'w'},
+        {"word-file", required_argument, NULL, 'f'},
+        {"output", required_argument, NULL, 'o'},
+        {"help", no_argument, NULL, 'h'},
+        {"version", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    if (!(blocklist = sqids_bl_new(sqids_bl_match))) {
+        fprintf(stderr, "sqids_bl_new(): %s\n", sqids_strerror(sqids_errno));
+        return EXIT_FAILURE;
+    }
+
+    /* parse command line options */
+    while ((ch = getopt_long(argc, argv, "b:w:f:o:hv", longopts,
+        NULL)) != -1) {
+        switch (ch) {
+            case 'b':
+                if (strcmp(optarg, "none") == 0) {
+                    break;
+                }
+
+                /* default words keep their languages */
+                if (!(shared = sqids_bl_default(optarg))) {
+                    fprintf(stderr, "sqids_bl_default(%s): %s\n", optarg,
+                        sqids_strerror(sqids_errno));
+                    sqids_bl_free(blocklist);
+                    return EXIT_FAILURE;
+                }
+
+                base = sqids_bl_dup(shared);
+                sqids_bl_free(shared);
+
+                /* followed by the words given so far */
+                sqids_bl_foreach(blocklist->head, iter) {
+                    if (!base || !(node = sqids_bl_add_tail(base, iter->s))) {
+                        break;
+                    }
+
+                    node->mask = iter->mask;
+                }
+
+                sqids_bl_free(blocklist);
+                if (!(blocklist = iter ? NULL : base)) {
+                    fprintf(stderr, "sqids_bl_dup(): %s\n",
+                        sqids_strerror(sqids_errno));
+                    if (base) {
+                        sqids_bl_free(base);
+                    }
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'w':
+                if (!sqids_bl_add_tail(blocklist, optarg)) {
+                    fprintf(stderr, "sqids_bl_add_tail(): %s\n",
+                        sqids_strerror(sqids_errno));
+                    sqids_bl_free(blocklist);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'f':
+                if (add_file(blocklist, optarg) != 0) {
+                    sqids_bl_free(blocklist);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'h':
+                usage(argv[0], stdout);
+                break;
+            case 'v':
+                fputs(SQIDS_VERSION_STRING, stdout);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0], stderr);
+        }
+    }
+
+    if (!output) {
+        usage(argv[0], stderr);
+    }
+
+    if (sqids_bl_write(blocklist, output) != 0) {
+        fprintf(stderr, "sqids_bl_write(%s): %s\n", output,
+            sqids_strerror(sqids_errno));
+        sqids_bl_free(blocklist);
+        return EXIT_FAILURE;
+    }
+
+    sqids_bl_free(blocklist);
+
+    return EXIT_SUCCESS;
+}
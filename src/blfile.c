@@ -0,0 +1,320 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ blocklist file stuff                                                  */
+/*****************************************************************************/
+
+/* write a whole buffer */
+static int
+sqids_bl_file_write_all(int fd, const char *buf, size_t n)
+{
+    ssize_t r;
+
+    while (n) {
+        if ((r = write(fd, buf, n)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return -1;
+        }
+
+        buf += r;
+        n -= r;
+    }
+
+    return 0;
+}
+
+/* the process umask, read once since reading it means setting it */
+static mode_t sqids_file_umask;
+static pthread_once_t sqids_file_umask_once = PTHREAD_ONCE_INIT;
+
+static void
+sqids_file_umask_init(void)
+{
+    sqids_file_umask = umask(0);
+    umask(sqids_file_umask);
+}
+
+/* compile a blocklist into memory */
+void *
+sqids_bl_compile(sqids_bl_t *bl, size_t *n)
+{
+    sqids_bl_file_hdr_t *hdr;
+    sqids_bl_file_word_t *word;
+    sqids_bl_node_t *iter;
+    unsigned long long size, pool = 0;
+    unsigned int cnt = 0;
+    char *buf, *p, *s;
+
+    /* every word goes into the pool twice, as is and folded */
+    sqids_bl_foreach(bl->head, iter) {
+        ++cnt;
+        pool += 2 * (strlen(iter->s) + 1);
+    }
+
+    size = sizeof(sqids_bl_file_hdr_t) +
+        (unsigned long long)cnt * sizeof(sqids_bl_file_word_t) + pool;
+    if (pool > 0xFFFFFFFFull || size > 0xFFFFFFFFull) {
+        sqids_errno = SQIDS_ERR_OVERFLOW;
+        return NULL;
+    }
+
+    if (!(buf = sqids_mem_alloc(size))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    memset(buf, 0, sizeof(sqids_bl_file_hdr_t));
+    hdr = (sqids_bl_file_hdr_t *)buf;
+    memcpy(hdr->magic, SQIDS_BL_FILE_MAGIC, sizeof(SQIDS_BL_FILE_MAGIC));
+    hdr->version = SQIDS_BL_FILE_VERSION;
+    hdr->order = SQIDS_BL_FILE_ORDER;
+    hdr->cnt = cnt;
+    hdr->words = sizeof(sqids_bl_file_hdr_t);
+    hdr->pool = hdr->words + (uint64_t)cnt * sizeof(sqids_bl_file_word_t);
+    hdr->size = size;
+
+    word = (sqids_bl_file_word_t *)(buf + hdr->words);
+    p = buf + hdr->pool;
+    sqids_bl_foreach(bl->head, iter) {
+        word->len = strlen(iter->s);
+        word->mask = iter->mask;
+
+        word->s = p - (buf + hdr->pool);
+        memcpy(p, iter->s, word->len + 1);
+        p += word->len + 1;
+
+        word->fold = p - (buf + hdr->pool);
+        for (s = iter->s; *s; ++s) {
+            *p++ = tolower((unsigned char)*s);
+        }
+        *p++ = 0;
+
+        ++word;
+    }
+
+    *n = size;
+
+    return buf;
+}
+
+/* write a file through a temporary one, so readers either see the old file
+   or the new one - even after a crash */
+int
+sqids_file_replace(const char *path, const void *buf, size_t n)
+{
+    char *tmp;
+    int fd, r;
+
+    if (!(tmp = sqids_mem_alloc(strlen(path) + 8))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return -1;
+    }
+
+    /* a unique name, as other threads may be replacing the same file */
+    sprintf(tmp, "%s.XXXXXX", path);
+    if ((fd = mkstemp(tmp)) < 0) {
+        sqids_mem_free(tmp);
+        sqids_errno = SQIDS_ERR_IO;
+        return -1;
+    }
+
+    /* permissions as open() would have set them rather than mkstemp()'s
+       0600, and the data on disk before the name points to it */
+    pthread_once(&sqids_file_umask_once, sqids_file_umask_init);
+    r = fchmod(fd, 0666 & ~sqids_file_umask);
+    r = r == 0 ? sqids_bl_file_write_all(fd, buf, n) : r;
+    r = r == 0 ? fsync(fd) : r;
+    r = close(fd) != 0 ? -1 : r;
+    r = r == 0 ? rename(tmp, path) : r;
+
+    if (r != 0) {
+        unlink(tmp);
+        sqids_errno = SQIDS_ERR_IO;
+    }
+
+    sqids_mem_free(tmp);
+
+    return r;
+}
+
+/* compile a blocklist into a file, replacing it atomically */
+int
+sqids_bl_write(sqids_bl_t *bl, const char *path)
+{
+    size_t n;
+    void *buf;
+    int r;
+
+    if (!(buf = sqids_bl_compile(bl, &n))) {
+        return -1;
+    }
+
+    r = sqids_file_replace(path, buf, n);
+    sqids_mem_free(buf);
+
+    return r;
+}
+
+/* check that a pool offset holds a string of the given length */
+static inline int
+sqids_bl_file_str_ok(const char *pool, uint64_t pool_len, uint32_t off,
+    uint32_t len)
+{
+    return (uint64_t)off + len < pool_len && pool[off + len] == 0;
+}
+
+/* use a compiled blocklist in place */
+sqids_bl_t *
+sqids_bl_load_mem(const void *p, size_t n, int (*match_func)(char *, char *))
+{
+    sqids_bl_t *result;
+    const sqids_bl_file_hdr_t *hdr = p;
+    const sqids_bl_file_word_t *word;
+    sqids_bl_node_t *node;
+    uint64_t pool_len;
+    unsigned int i;
+
+    /* the header, then every offset has to stay within the buffer */
+    if (n < sizeof(sqids_bl_file_hdr_t) || (uintptr_t)p % sizeof(uint64_t) ||
+        memcmp(hdr->magic, SQIDS_BL_FILE_MAGIC, sizeof(SQIDS_BL_FILE_MAGIC))
+        != 0 || hdr->version != SQIDS_BL_FILE_VERSION ||
+        hdr->order != SQIDS_BL_FILE_ORDER || hdr->size != (uint64_t)n ||
+        hdr->cnt > 0xFFFFFFFFu / sizeof(sqids_bl_node_t) ||
+        hdr->words < sizeof(sqids_bl_file_hdr_t) ||
+        hdr->words % sizeof(uint32_t) != 0 ||
+        hdr->pool < hdr->words ||
+        (hdr->pool - hdr->words) / sizeof(sqids_bl_file_word_t) < hdr->cnt ||
+        hdr->pool > hdr->size) {
+        sqids_errno = SQIDS_ERR_FORMAT;
+        return NULL;
+    }
+
+    word = (const sqids_bl_file_word_t *)((const char *)p + hdr->words);
+    pool_len = hdr->size - hdr->pool;
+    for (i = 0; i < hdr->cnt; ++i) {
+        if (!sqids_bl_file_str_ok((const char *)p + hdr->pool, pool_len,
+            word[i].s, word[i].len) ||
+            !sqids_bl_file_str_ok((const char *)p + hdr->pool, pool_len,
+            word[i].fold, word[i].len)) {
+            sqids_errno = SQIDS_ERR_FORMAT;
+            return NULL;
+        }
+    }
+
+    if (!(result = sqids_bl_new(match_func))) {
+        return NULL;
+    }
+
+    result->words = word;
+    result->pool = (const char *)p + hdr->pool;
+
+    if (!hdr->cnt) {
+        return result;
+    }
+
+    /* one block of nodes, pointing into the buffer */
+    if (!(result->nodes = sqids_mem_alloc(
+        hdr->cnt * sizeof(sqids_bl_node_t)))) {
+        sqids_bl_free(result);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    for (i = 0, node = result->nodes; i < hdr->cnt; ++i, ++node) {
+        node->s = (char *)result->pool + word[i].s;
+        node->mask = word[i].mask;
+        node->prev = i ? node - 1 : NULL;
+        node->next = i + 1 < hdr->cnt ? node + 1 : NULL;
+    }
+
+    result->node_cnt = hdr->cnt;
+    result->head = result->nodes;
+    result->tail = result->nodes + hdr->cnt - 1;
+
+    return result;
+}
+
+/* map a file read-only */
+void *
+sqids_file_map(const char *path, size_t *n)
+{
+    struct stat st;
+    void *map;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    /* nothing to map - and nothing valid either */
+    if (!st.st_size) {
+        close(fd);
+        sqids_errno = SQIDS_ERR_FORMAT;
+        return NULL;
+    }
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED) {
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    *n = st.st_size;
+
+    return map;
+}
+
+/* map a compiled blocklist file and use its words in place */
+sqids_bl_t *
+sqids_bl_load_mmap(const char *path, int (*match_func)(char *, char *))
+{
+    sqids_bl_t *result;
+    size_t n;
+    void *map;
+
+    if (!(map = sqids_file_map(path, &n))) {
+        return NULL;
+    }
+
+    if (!(result = sqids_bl_load_mem(map, n, match_func))) {
+        munmap(map, n);
+        return NULL;
+    }
+
+    /* the list owns the mapping from now on */
+    result->map = map;
+    result->map_len = n;
+
+    return result;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
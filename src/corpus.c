@@ -0,0 +1,810 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+#include "sqids.h"
+#include "strerror.h"
+
+/*****************************************************************************/
+/* {{{ random stuff                                                          */
+/*****************************************************************************/
+
+/* splitmix64 - the same corpus from the same seed, on any platform */
+static unsigned long long
+rnd_next(unsigned long long *state)
+{
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ull);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+    return z ^ (z >> 31);
+}
+
+/* uniform in [0, n) */
+static unsigned long long
+rnd_below(unsigned long long *state, unsigned long long n)
+{
+    return rnd_next(state) % n;
+}
+
+/* uniform in [0, 1) */
+static double
+rnd_unit(unsigned long long *state)
+{
+    return (rnd_next(state) >> 11) * 0x1.0p-53;
+}
+
+/* zipf over ranks 1..n, by rejection-inversion (Hormann & Derflinger) */
+struct zipf_s {
+    double s, n, h_x1, h_n, s_div;
+};
+
+static double
+zipf_helper1(double x)
+{
+    return fabs(x) > 1e-8 ? log1p(x) / x : 1 - x / 2;
+}
+
+static double
+zipf_helper2(double x)
+{
+    return fabs(x) > 1e-8 ? expm1(x) / x : 1 + x / 2;
+}
+
+static double
+zipf_h(const struct zipf_s *z, double x)
+{
+    return exp(-z->s * log(x));
+}
+
+static double
+zipf_h_integral(const struct zipf_s *z, double x)
+{
+    double log_x = log(x);
+
+    return zipf_helper2((1 - z->s) * log_x) * log_x;
+}
+
+static double
+zipf_h_integral_inv(const struct zipf_s *z, double x)
+{
+    double t = x * (1 - z->s);
+
+    return exp(zipf_helper1(t < -1 ? -1 : t) * x);
+}
+
+static void
+zipf_init(struct zipf_s *z, double s, unsigned long long n)
+{
+    z->s = s;
+    z->n = n;
+    z->h_x1 = zipf_h_integral(z, 1.5) - 1;
+    z->h_n = zipf_h_integral(z, n + 0.5);
+    z->s_div = 2 - zipf_h_integral_inv(z, zipf_h_integral(z, 2.5) -
+        zipf_h(z, 2));
+}
+
+static unsigned long long
+zipf_next(const struct zipf_s *z, unsigned long long *state)
+{
+    double u, x, k;
+
+    for (;;) {
+        u = z->h_n + rnd_unit(state) * (z->h_x1 - z->h_n);
+        x = zipf_h_integral_inv(z, u);
+        k = floor(x + 0.5);
+        k = k < 1 ? 1 : k > z->n ? z->n : k;
+
+        if (k - x <= z->s_div || u >= zipf_h_integral(z, k + 0.5) -
+            zipf_h(z, k)) {
+            return (unsigned long long)k;
+        }
+    }
+}
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ generator stuff                                                       */
+/*****************************************************************************/
+
+/* what a corpus holds */
+#define CORPUS_NUMBERS  0
+#define CORPUS_IDS      1
+
+/* generator settings */
+struct gen_s {
+    sqids_t *sqids;
+    const char *alphabet;
+    unsigned long long count, seed, max;
+    unsigned int nums;
+    double exponent;
+};
+
+/* a named distribution, writing `count` lines */
+struct dist_s {
+    const char *name;
+    int kind;
+    int (*gen)(const struct gen_s *, FILE *);
+};
+
+/* 0, 1, 2, ... */
+static int
+gen_sequential(const struct gen_s *gen, FILE *out)
+{
+    unsigned long long i;
+
+    for (i = 0; i < gen->count; ++i) {
+        fprintf(out, "%llu\n", i);
+    }
+
+    return 0;
+}
+
+/* a few hot keys, a long tail */
+static int
+gen_zipf(const struct gen_s *gen, FILE *out)
+{
+    unsigned long long state = gen->seed, i;
+    struct zipf_s z;
+
+    zipf_init(&z, gen->exponent, gen->max);
+
+    for (i = 0; i < gen->count; ++i) {
+        fprintf(out, "%llu\n", zipf_next(&z, &state));
+    }
+
+    return 0;
+}
+
+/* twitter-style ids: 41 bits of milliseconds, 10 of worker, 12 of sequence */
+static int
+gen_snowflake(const struct gen_s *gen, FILE *out)
+{
+    unsigned long long state = gen->seed, ms, seq = 0, i;
+
+    /* some time after the 2020-01-01 epoch */
+    ms = 100000000000ull + rnd_below(&state, 10000000000ull);
+
+    for (i = 0; i < gen->count; ++i) {
+        if (rnd_below(&state, 4) == 0) {
+            ms += 1 + rnd_below(&state, 50);
+            seq = 0;
+        }
+
+        fprintf(out, "%llu\n", ms << 22 | rnd_below(&state, 1024) << 12 |
+            (seq++ & 0xFFF));
+    }
+
+    return 0;
+}
+
+/* uniform 64-bit numbers */
+static int
+gen_random64(const struct gen_s *gen, FILE *out)
+{
+    unsigned long long state = gen->seed, i;
+
+    for (i = 0; i < gen->count; ++i) {
+        fprintf(out, "%llu\n", rnd_next(&state));
+    }
+
+    return 0;
+}
+
+/* `nums` numbers per line, of every magnitude */
+static int
+gen_tuples(const struct gen_s *gen, FILE *out)
+{
+    unsigned long long state = gen->seed, i;
+    unsigned int j;
+
+    for (i = 0; i < gen->count; ++i) {
+        for (j = 0; j < gen->nums; ++j) {
+            fprintf(out, j ? " %llu" : "%llu",
+                rnd_next(&state) >> rnd_below(&state, 64));
+        }
+        fputc('\n', out);
+    }
+
+    return 0;
+}
+
+/* strings that make decode work hard or fail: near-miss ids, random and
+   overlong runs of the alphabet, stray characters */
+static int
+gen_adversarial(const struct gen_s *gen, FILE *out)
+{
+    static const char junk[] = "-_.~!@$%^&*+=/?";
+    unsigned long long state = gen->seed, nums[4], i;
+    size_t alen = strlen(gen->alphabet), len, j;
+    unsigned int cnt, k;
+    char *id;
+
+    for (i = 0; i < gen->count; ++i) {
+        cnt = 1 + rnd_below(&state, 4);
+        for (k = 0; k < cnt; ++k) {
+            nums[k] = rnd_next(&state) >> rnd_below(&state, 64);
+        }
+
+        if (!(id = sqids_encode(gen->sqids, cnt, nums))) {
+            return -1;
+        }
+        len = strlen(id);
+
+        switch (rnd_below(&state, 7)) {
+            case 0:     /* the real thing */
+                fputs(id, out);
+                break;
+            case 1:     /* one character off */
+                id[rnd_below(&state, len)] =
+                    gen->alphabet[rnd_below(&state, alen)];
+                fputs(id, out);
+                break;
+            case 2:     /* a stray character */
+                id[rnd_below(&state, len)] =
+                    junk[rnd_below(&state, sizeof(junk) - 1)];
+                fputs(id, out);
+                break;
+            case 3:     /* twice over */
+                fprintf(out, "%s%s", id, id);
+                break;
+            case 4:     /* random, id-sized */
+                for (j = 1 + rnd_below(&state, 64); j; --j) {
+                    fputc(gen->alphabet[rnd_below(&state, alen)], out);
+                }
+                break;
+            case 5:     /* random, long enough to overflow */
+                for (j = 64 + rnd_below(&state, 400); j; --j) {
+                    fputc(gen->alphabet[rnd_below(&state, alen)], out);
+                }
+                break;
+            default:    /* one character, repeated */
+                k = rnd_below(&state, alen);
+                for (j = 1 + rnd_below(&state, 100); j; --j) {
+                    fputc(gen->alphabet[k], out);
+                }
+        }
+
+        fputc('\n', out);
+        sqids_mem_free(id);
+    }
+
+    return 0;
+}
+
+static const struct dist_s dists[] = {
+    {"sequential", CORPUS_NUMBERS, gen_sequential},
+    {"zipf", CORPUS_NUMBERS, gen_zipf},
+    {"snowflake", CORPUS_NUMBERS, gen_snowflake},
+    {"random64", CORPUS_NUMBERS, gen_random64},
+    {"tuples", CORPUS_NUMBERS, gen_tuples},
+    {"adversarial", CORPUS_IDS, gen_adversarial},
+    {NULL, 0, NULL}
+};
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ replay stuff                                                          */
+/*****************************************************************************/
+
+/* a corpus in memory: the ids of a corpus of numbers are encoded first */
+struct corpus_s {
+    int kind;
+    size_t cnt;
+    size_t *num_offs;               /* into `nums`, per item */
+    unsigned int *num_cnts;
+    unsigned long long *nums;
+    size_t *id_offs;                /* into `ids`, per item */
+    unsigned int *id_lens;
+    char *ids;                      /* nul-terminated */
+    size_t chars, max_len;
+};
+
+static void
+corpus_free(struct corpus_s *corpus)
+{
+    free(corpus->num_offs);
+    free(corpus->num_cnts);
+    free(corpus->nums);
+    free(corpus->id_offs);
+    free(corpus->id_lens);
+    free(corpus->ids);
+}
+
+static char *
+read_file(const char *path, size_t *len)
+{
+    size_t size = 1 << 16, n;
+    char *buf, *tmp;
+    FILE *fp;
+
+    if (!(fp = fopen(path, "r"))) {
+        return NULL;
+    }
+
+    for (*len = 0, buf = NULL;; *len += n) {
+        if ((!buf || *len + 1 == size) &&
+            !(tmp = realloc(buf, size = buf ? size * 2 : size))) {
+            free(buf);
+            fclose(fp);
+            errno = ENOMEM;
+            return NULL;
+        }
+        buf = tmp;
+
+        if (!(n = fread(buf + *len, 1, size - *len - 1, fp))) {
+            break;
+        }
+    }
+
+    buf[*len] = 0;
+    fclose(fp);
+
+    return buf;
+}
+
+/* the kind comes from the header a generated corpus starts with, or else
+   from whether the first line is all numbers */
+static int
+corpus_kind(const char *buf)
+{
+    const char *p;
+
+    if (strncmp(buf, "# sqids-corpus ", 15) == 0) {
+        return strncmp(buf + 15, "ids ", 4) == 0 ? CORPUS_IDS :
+            CORPUS_NUMBERS;
+    }
+
+    for (p = buf; *p && *p != '\n'; ++p) {
+        if ((*p < '0' || *p > '9') && *p != ' ' && *p != '\r') {
+            return CORPUS_IDS;
+        }
+    }
+
+    return CORPUS_NUMBERS;
+}
+
+static int
+corpus_load(struct corpus_s *corpus, const char *path)
+{
+    size_t len, items = 1, words = 1, n = 0;
+    char *buf, *p, *end, *eol;
+    unsigned long long v;
+    int last;
+
+    memset(corpus, 0, sizeof(*corpus));
+
+    if (!(buf = read_file(path, &len))) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    corpus->kind = corpus_kind(buf);
+
+    /* size everything up front */
+    for (p = buf; *p; ++p) {
+        items += *p == '\n';
+        words += *p == '\n' || *p == ' ';
+    }
+
+    if (!(corpus->id_offs = malloc(items * sizeof(size_t))) ||
+        !(corpus->id_lens = malloc(items * sizeof(unsigned int))) ||
+        (corpus->kind == CORPUS_NUMBERS &&
+        (!(corpus->num_offs = malloc(items * sizeof(size_t))) ||
+        !(corpus->num_cnts = malloc(items * sizeof(unsigned int))) ||
+        !(corpus->nums = malloc(words * sizeof(unsigned long long)))))) {
+        fputs("malloc(): out of memory\n", stderr);
+        free(buf);
+        corpus_free(corpus);
+        return -1;
+    }
+
+    /* ids stay in the file buffer, cut at their line ends */
+    for (p = buf, last = !*p; !last; p = eol + 1) {
+        eol = p + strcspn(p, "\n");
+        end = eol > p && eol[-1] == '\r' ? eol - 1 : eol;
+        last = !*eol || !eol[1];
+
+        if (*p == '#' || end == p) {
+            continue;
+        }
+
+        if (corpus->kind == CORPUS_IDS) {
+            corpus->id_offs[corpus->cnt] = p - buf;
+            corpus->id_lens[corpus->cnt] = end - p;
+            corpus->chars += end - p;
+            corpus->max_len = end - p > corpus->max_len ? end - p :
+                corpus->max_len;
+            *end = 0;
+        } else {
+            corpus->num_offs[corpus->cnt] = n;
+            for (corpus->num_cnts[corpus->cnt] = 0; p < end; ) {
+                /* digits only, as strtoull() also takes a sign */
+                errno = *p >= '0' && *p <= '9' ? 0 : EINVAL;
+                v = errno ? 0 : strtoull(p, &p, 10);
+                if (errno || (*p != ' ' && p != end)) {
+                    fprintf(stderr, "%s: line %zu: not a list of numbers\n",
+                        path, corpus->cnt + 1);
+                    free(buf);
+                    corpus_free(corpus);
+                    return -1;
+                }
+                corpus->nums[n++] = v;
+                ++corpus->num_cnts[corpus->cnt];
+                p += strspn(p, " ");
+            }
+        }
+
+        ++corpus->cnt;
+    }
+
+    if (corpus->kind == CORPUS_IDS) {
+        corpus->ids = buf;
+    } else {
+        free(buf);
+    }
+
+    return 0;
+}
+
+static double
+now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* encode every tuple, keeping the ids for the other phases */
+static int
+replay_encode(sqids_t *sqids, struct corpus_s *corpus, unsigned int passes,
+    double *rate)
+{
+    size_t i, len, size = 0;
+    unsigned int p;
+    double start;
+    int r = 0;
+
+    for (i = 0; i < corpus->cnt; ++i) {
+        len = sqids_encoded_len(sqids, corpus->num_cnts[i],
+            corpus->nums + corpus->num_offs[i]);
+        corpus->id_offs[i] = size;
+        corpus->id_lens[i] = len;
+        corpus->chars += len;
+        corpus->max_len = len > corpus->max_len ? len : corpus->max_len;
+        size += len + 1;
+    }
+
+    if (!(corpus->ids = malloc(size ? size : 1))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return -1;
+    }
+
+    start = now_sec();
+    for (p = 0; r >= 0 && p < passes; ++p) {
+        for (i = 0; r >= 0 && i < corpus->cnt; ++i) {
+            r = sqids_encode_buf(sqids, corpus->ids + corpus->id_offs[i],
+                corpus->num_cnts[i], corpus->nums + corpus->num_offs[i]);
+        }
+    }
+    *rate = corpus->cnt * passes / (now_sec() - start);
+
+    return r < 0 ? -1 : 0;
+}
+
+/* decode every id, counting those that fail (or, for ids of numbers, don't
+   come back as they went in) */
+static int
+replay_decode(sqids_t *sqids, const struct corpus_s *corpus,
+    unsigned int passes, double *rate, size_t *invalid)
+{
+    unsigned long long *nums;
+    size_t i, n = corpus->max_len / 2 + 1;
+    unsigned int p;
+    double start;
+    int r;
+
+    if (!(nums = malloc(n * sizeof(unsigned long long)))) {
+        return -1;
+    }
+
+    start = now_sec();
+    for (p = 0, *invalid = 0; p < passes; ++p) {
+        for (i = 0; i < corpus->cnt; ++i) {
+            r = sqids_decode_len(sqids, corpus->ids + corpus->id_offs[i],
+                corpus->id_lens[i], nums, n);
+            *invalid += r < 0 || (corpus->kind == CORPUS_NUMBERS &&
+                (unsigned int)r != corpus->num_cnts[i]);
+        }
+    }
+    *rate = corpus->cnt * passes / (now_sec() - start);
+    *invalid /= passes;
+
+    free(nums);
+
+    return 0;
+}
+
+/* check every id against the blocklist */
+static void
+replay_blocked(sqids_t *sqids, const struct corpus_s *corpus,
+    unsigned int passes, double *rate)
+{
+    unsigned int p;
+    double start;
+    size_t i;
+
+    start = now_sec();
+    for (p = 0; p < passes; ++p) {
+        for (i = 0; i < corpus->cnt; ++i) {
+            sqids_blocked(sqids, corpus->ids + corpus->id_offs[i]);
+        }
+    }
+    *rate = corpus->cnt * passes / (now_sec() - start);
+}
+
+/* }}}                                                                       */
+
+static void
+usage(const char *progname, FILE *out)
+{
+    fputs("\n", out);
+    fputs("Usage:\n", out);
+    fprintf(out, "  %s -g distribution [options]\n", progname);
+    fprintf(out, "  %s [options] corpus...\n", progname);
+
+    fputs("\n", out);
+    fputs("Generates a corpus, or replays corpora through encode, decode "
+        "and the\nblocklist.\n", out);
+
+    fputs("\n", out);
+    fputs("Options:\n", out);
+    fputs("  -g, --generate            generate a corpus from a distribution\n"
+        "                            (sequential,zipf,snowflake,random64,"
+        "tuples,\n"
+        "                            adversarial)\n", out);
+    fputs("  -o, --output              write the corpus to this file "
+        "[stdout]\n", out);
+    fputs("  -n, --count               set number of lines [100000]\n", out);
+    fputs("  -s, --seed                set random seed [1]\n", out);
+    fputs("  -k, --numbers             set number of numbers per tuple [3]\n",
+        out);
+    fputs("  -z, --exponent            set zipf exponent [1.1]\n", out);
+    fputs("  -m, --max                 set highest zipf rank [1000000]\n",
+        out);
+    fputs("  -p, --passes              replay every corpus this many times "
+        "[3]\n", out);
+    fputs("  -a, --alphabet            set alphabet ["
+        SQIDS_DEFAULT_ALPHABET "]\n", out);
+    fputs("  -l, --min-length          set hash minimum length [0]\n", out);
+    fputs("  -b, --default-blocklist   include a default blocklist\n"
+        "                            (de,en,es,fr,hi,it,pt,none,all) "
+        "[all]\n", out);
+    fputs("  -h, --help                print this message and exit\n", out);
+    fputs("  -v, --version             print version information and exit\n",
+        out);
+
+    fputs("\n", out);
+    exit(out == stderr ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+static unsigned long long
+parse_num(const char *s, char **p)
+{
+    int radix = 10;
+
+    if (*s == '0') {
+        radix = 8;
+        ++s;
+
+        if (*s == 'x' || *s == 'X') {
+            radix = 16;
+            ++s;
+        }
+    }
+
+    return strtoull(s, p, radix);
+}
+
+int
+main(int argc, char **argv)
+{
+    struct gen_s gen = {NULL, SQIDS_DEFAULT_ALPHABET, 100000, 1, 1000000, 3,
+        1.1};
+    char *bl_name = "all", *dist_name = NULL, *output = NULL, *p;
+    const struct dist_s *dist = NULL;
+    sqids_bl_t *blocklist = NULL;
+    struct corpus_s corpus;
+    unsigned int passes = 3;
+    double enc_rate = 0, dec_rate, bl_rate;
+    char rate[32];
+    size_t invalid;
+    int min_len = 0, ch, err = 0, i;
+    FILE *out = stdout;
+
+    static const struct option longopts[] = {
+        {"generate", required_argument, NULL, 'g'},
+        {"output", required_argument, NULL, 'o'},
+        {"count", required_argument, NULL, 'n'},
+        {"seed", required_argument, NULL, 's'},
+        {"numbers", required_argument, NULL, 'k'},
+        {"exponent", required_argument, NULL, 'z'},
+        {"max", required_argument, NULL, 'm'},
+        {"passes", required_argument, NULL, 'p'},
+        {"alphabet", required_argument, NULL, 'a'},
+        {"min-length", required_argument, NULL, 'l'},
+        {"default-blocklist", required_argument, NULL, 'b'},
+        {"help", no_argument, NULL, 'h'},
+        {"version", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    /* parse command line options */
+    while ((ch = getopt_long(argc, argv, "g:o:n:s:k:z:m:p:a:l:b:hv", longopts,
+        NULL)) != -1) {
+        switch (ch) {
+            case 'g':
+                dist_name = optarg;
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'n':
+                gen.count = parse_num(optarg, &p);
+                err |= p == optarg || *p;
+                break;
+            case 's':
+                gen.seed = parse_num(optarg, &p);
+                err |= p == optarg || *p;
+                break;
+            case 'k':
+                gen.nums = parse_num(optarg, &p);
+                err |= p == optarg || *p || !gen.nums || gen.nums > 256;
+                break;
+            case 'z':
+                gen.exponent = strtod(optarg, &p);
+                err |= p == optarg || *p || gen.exponent <= 0;
+                break;
+            case 'm':
+                gen.max = parse_num(optarg, &p);
+                err |= p == optarg || *p || !gen.max;
+                break;
+            case 'p':
+                passes = parse_num(optarg, &p);
+                err |= p == optarg || *p || !passes;
+                break;
+            case 'a':
+                gen.alphabet = optarg;
+                break;
+            case 'l':
+                min_len = parse_num(optarg, &p);
+                err |= p == optarg || *p;
+                break;
+            case 'b':
+                bl_name = optarg;
+                break;
+            case 'h':
+                usage(argv[0], stdout);
+                break;
+            case 'v':
+                fputs(SQIDS_VERSION_STRING, stdout);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0], stderr);
+        }
+
+        if (err) {
+            fprintf(stderr, "-%c: invalid value \"%s\"\n", ch, optarg);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (dist_name) {
+        for (dist = dists; dist->name && strcmp(dist->name, dist_name); ++dist);
+
+        if (!dist->name || optind != argc) {
+            usage(argv[0], stderr);
+        }
+    } else if (optind == argc) {
+        usage(argv[0], stderr);
+    }
+
+    if (strcmp(bl_name, "none") != 0 &&
+        !(blocklist = sqids_bl_default(bl_name))) {
+        fprintf(stderr, "sqids_bl_default(%s): %s\n", bl_name,
+            sqids_strerror(sqids_errno));
+        return EXIT_FAILURE;
+    }
+
+    if (!(gen.sqids = sqids_new(gen.alphabet, min_len, blocklist))) {
+        fprintf(stderr, "sqids_new(): %s\n", sqids_strerror(sqids_errno));
+        return EXIT_FAILURE;
+    }
+
+    /* generate */
+    if (dist) {
+        if (output && !(out = fopen(output, "w"))) {
+            fprintf(stderr, "%s: %s\n", output, strerror(errno));
+            sqids_free(gen.sqids);
+            return EXIT_FAILURE;
+        }
+
+        fprintf(out, "# sqids-corpus %s %s count=%llu seed=%llu\n",
+            dist->kind == CORPUS_IDS ? "ids" : "numbers", dist->name,
+            gen.count, gen.seed);
+
+        if (dist->gen(&gen, out) != 0) {
+            fprintf(stderr, "%s: %s\n", dist->name,
+                sqids_strerror(sqids_errno));
+            err = -1;
+        }
+
+        if ((output ? fclose(out) : fflush(out)) != 0) {
+            fprintf(stderr, "%s: %s\n", output ? output : "stdout",
+                strerror(errno));
+            err = -1;
+        }
+
+        sqids_free(gen.sqids);
+
+        return err ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    /* replay */
+    printf("%-24s %-7s %9s %7s %12s %12s %12s %9s\n", "corpus", "kind",
+        "items", "avg len", "encode/s", "decode/s", "blocked/s", "invalid");
+
+    for (i = optind; !err && i < argc; ++i) {
+        if (corpus_load(&corpus, argv[i]) != 0) {
+            err = -1;
+            break;
+        }
+
+        if (corpus.kind == CORPUS_NUMBERS) {
+            if (replay_encode(gen.sqids, &corpus, passes, &enc_rate) != 0) {
+                fprintf(stderr, "%s: %s\n", argv[i],
+                    sqids_strerror(sqids_errno));
+                corpus_free(&corpus);
+                err = -1;
+                break;
+            }
+        }
+
+        if (replay_decode(gen.sqids, &corpus, passes, &dec_rate,
+            &invalid) != 0) {
+            fputs("malloc(): out of memory\n", stderr);
+            corpus_free(&corpus);
+            err = -1;
+            break;
+        }
+        replay_blocked(gen.sqids, &corpus, passes, &bl_rate);
+
+        snprintf(rate, sizeof(rate), "%.0f", enc_rate);
+        printf("%-24s %-7s %9zu %7.1f %12s %12.0f %12.0f %9zu\n", argv[i],
+            corpus.kind == CORPUS_IDS ? "ids" : "numbers", corpus.cnt,
+            corpus.cnt ? (double)corpus.chars / corpus.cnt : 0,
+            corpus.kind == CORPUS_IDS ? "-" : rate, dec_rate, bl_rate,
+            invalid);
+
+        corpus_free(&corpus);
+    }
+
+    sqids_free(gen.sqids);
+
+    return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
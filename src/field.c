@@ -0,0 +1,243 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ field stuff                                                           */
+/*****************************************************************************/
+
+/* end of the field starting at `p`, a quoted one may hold the delimiter */
+static const char *
+sqids_field_end(const char *p, const char *end, char delim)
+{
+    const char *q;
+
+    if (p < end && *p == '"') {
+        for (++p; p < end; ++p) {
+            if (*p == '"') {
+                if (p + 1 < end && p[1] == '"') {
+                    ++p;
+                    continue;
+                }
+
+                ++p;
+                break;
+            }
+        }
+    }
+
+    return (q = memchr(p, delim, end - p)) ? q : end;
+}
+
+/* parse decimal numbers separated by spaces */
+static int
+sqids_field_parse(const char *s, size_t n, unsigned long long *nums,
+    unsigned int max)
+{
+    const char *end = s + n;
+    unsigned long long num;
+    unsigned int cnt = 0, d;
+
+    while (s < end) {
+        if (*s == ' ') {
+            ++s;
+            continue;
+        }
+
+        if (*s < '0' || *s > '9' || cnt == max) {
+            sqids_errno = SQIDS_ERR_INVALID;
+            return -1;
+        }
+
+        for (num = 0; s < end && *s >= '0' && *s <= '9'; ++s) {
+            d = *s - '0';
+            if (num > (~0ull - d) / 10) {
+                sqids_errno = SQIDS_ERR_OVERFLOW;
+                return -1;
+            }
+
+            num = num * 10 + d;
+        }
+
+        if (s < end && *s != ' ') {
+            sqids_errno = SQIDS_ERR_INVALID;
+            return -1;
+        }
+
+        nums[cnt++] = num;
+    }
+
+    return cnt;
+}
+
+/* convert a field value, returning the bytes written or -1 */
+static long
+sqids_field_convert(sqids_t *sqids, const char *s, size_t n, int flags,
+    char *out, size_t size)
+{
+    unsigned long long nums[SQIDS_CANONICAL_MAX / 2 + 1], num;
+    char digits[20];
+    size_t o = 0, need;
+    int cnt, i, j;
+
+    /* empty fields stay empty */
+    if (!n) {
+        return 0;
+    }
+
+    if (n > SQIDS_CANONICAL_MAX) {
+        sqids_errno = SQIDS_ERR_INVALID;
+        return -1;
+    }
+
+    if (!(flags & SQIDS_FIELD_DECODE)) {
+        /* numbers in, one id out */
+        if ((cnt = sqids_field_parse(s, n, nums, n / 2 + 1)) < 0) {
+            return -1;
+        }
+
+        need = sqids_encoded_len(sqids, cnt, nums);
+        if (need + 1 > size) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            return -1;
+        }
+
+        return sqids_encode_buf(sqids, out, cnt, nums);
+    }
+
+    /* an id in, numbers out - only the one encode would produce, as most
+       words decode to something */
+    if ((cnt = sqids_decode_canonical(sqids, s, n, nums, n / 2 + 1)) < 0) {
+        return -1;
+    }
+
+    for (i = 0; i < cnt; ++i) {
+        for (j = 0, num = nums[i]; j == 0 || num; num /= 10) {
+            digits[j++] = '0' + num % 10;
+        }
+
+        if (o + j + (i > 0) > size) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            return -1;
+        }
+
+        if (i > 0) {
+            out[o++] = ' ';
+        }
+
+        while (j) {
+            out[o++] = digits[--j];
+        }
+    }
+
+    return o;
+}
+
+/* rewrite one field of every line */
+int
+sqids_field_rewrite(sqids_t *sqids, const char *buf, size_t len,
+    unsigned int field, char delim, int flags, char *out, size_t size,
+    size_t *out_len)
+{
+    const char *line = buf, *end = buf + len, *eol, *next, *fs, *fe, *vs, *ve;
+    size_t o = 0, n;
+    unsigned int i;
+    long r;
+    int quoted;
+
+    if (!field) {
+        sqids_errno = SQIDS_ERR_INVALID;
+        return -1;
+    }
+
+    for (; line < end; line = next) {
+        eol = memchr(line, '\n', end - line);
+        next = eol ? eol + 1 : end;
+        eol = eol ? eol : end;
+
+        /* walk to the wanted field */
+        for (i = 1, fs = line, fe = sqids_field_end(fs, eol, delim);
+            i < field && fe < eol; ++i) {
+            fs = fe + 1;
+            fe = sqids_field_end(fs, eol, delim);
+        }
+
+        /* lines without it stay as they are */
+        if (i < field) {
+            fs = fe = next;
+        }
+
+        /* everything before the field */
+        n = fs - line;
+        if (n > size - o) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            return -1;
+        }
+        memcpy(out + o, line, n);
+        o += n;
+
+        if (fs == next) {
+            continue;
+        }
+
+        /* the value, without quotes or the carriage return of a crlf line */
+        vs = fs;
+        ve = fe;
+        if (ve == eol && ve > vs && ve[-1] == '\r') {
+            --ve;
+        }
+
+        quoted = ve - vs >= 2 && *vs == '"' && ve[-1] == '"';
+        if (quoted) {
+            ++vs;
+            --ve;
+
+            if (o == size) {
+                sqids_errno = SQIDS_ERR_NOSPACE;
+                return -1;
+            }
+            out[o++] = '"';
+        }
+
+        r = sqids_field_convert(sqids, vs, ve - vs, flags, out + o, size - o);
+        if (r < 0) {
+            if (sqids_errno == SQIDS_ERR_NOSPACE) {
+                return -1;
+            }
+
+            /* keep what does not convert, or point at it */
+            if (!(flags & SQIDS_FIELD_KEEP)) {
+                *out_len = fs - buf;
+                return -1;
+            }
+
+            o -= quoted;
+            vs = fs;
+        } else {
+            o += r;
+            vs = ve;
+        }
+
+        /* and the rest of the line, as is */
+        n = next - vs;
+        if (n > size - o) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            return -1;
+        }
+        memcpy(out + o, vs, n);
+        o += n;
+    }
+
+    *out_len = o;
+
+    return 0;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
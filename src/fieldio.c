@@ -0,0 +1,415 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sqids.h"
+#include "strerror.h"
+#include "fieldio.h"
+
+/*****************************************************************************/
+/* {{{ field stuff                                                           */
+/*****************************************************************************/
+
+/* field rewriting: input is cut into chunks of whole lines, which worker
+   threads rewrite while the main thread reads ahead and writes the results
+   out in order */
+
+#define FIELD_CHUNK (4 << 20)
+
+struct field_job_s {
+    const char *path;
+    unsigned long long base;    /* offset of the chunk within the file */
+    const char *in;
+    size_t in_len;
+    char *buf;                  /* chunk of piped input */
+    size_t buf_size;
+    char *out;
+    size_t out_size, out_len;
+    int done, err;
+};
+
+struct field_ctx_s {
+    sqids_t *sqids;
+    unsigned int field;
+    char delim;
+    int flags;
+    struct field_job_s *jobs;
+    unsigned int job_cnt;
+    unsigned long long filled, taken, written;
+    int stop, failed;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+};
+
+/* the last newline of a buffer */
+static const char *
+last_newline(const char *buf, size_t n)
+{
+    while (n--) {
+        if (buf[n] == '\n') {
+            return buf + n;
+        }
+    }
+
+    return NULL;
+}
+
+/* rewrite one chunk, growing the output buffer until it fits */
+static void
+field_run(struct field_ctx_s *ctx, struct field_job_s *job)
+{
+    size_t size = job->in_len * 2 + 4096;
+    char *out;
+
+    for (;;) {
+        if (job->out_size < size) {
+            if (!(out = realloc(job->out, size))) {
+                job->err = SQIDS_ERR_ALLOC;
+                return;
+            }
+
+            job->out = out;
+            job->out_size = size;
+        }
+
+        if (sqids_field_rewrite(ctx->sqids, job->in, job->in_len, ctx->field,
+            ctx->delim, ctx->flags, job->out, job->out_size,
+            &job->out_len) == 0) {
+            job->err = 0;
+            return;
+        }
+
+        if (sqids_errno != SQIDS_ERR_NOSPACE) {
+            job->err = sqids_errno;
+            return;
+        }
+
+        size = job->out_size * 2;
+    }
+}
+
+static void *
+field_worker(void *arg)
+{
+    struct field_ctx_s *ctx = arg;
+    struct field_job_s *job;
+
+    pthread_mutex_lock(&ctx->lock);
+    for (;;) {
+        while (!ctx->stop && ctx->taken == ctx->filled) {
+            pthread_cond_wait(&ctx->cond, &ctx->lock);
+        }
+
+        if (ctx->taken == ctx->filled) {
+            break;
+        }
+
+        job = &ctx->jobs[ctx->taken++ % ctx->job_cnt];
+        pthread_mutex_unlock(&ctx->lock);
+
+        field_run(ctx, job);
+
+        pthread_mutex_lock(&ctx->lock);
+        job->done = 1;
+        pthread_cond_broadcast(&ctx->cond);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    return NULL;
+}
+
+/* write out the oldest chunk once it is done, nothing more after a failure */
+static int
+field_flush(struct field_ctx_s *ctx)
+{
+    struct field_job_s *job = &ctx->jobs[ctx->written++ % ctx->job_cnt];
+
+    pthread_mutex_lock(&ctx->lock);
+    while (!job->done) {
+        pthread_cond_wait(&ctx->cond, &ctx->lock);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    if (ctx->failed) {
+        return -1;
+    }
+
+    if (job->err) {
+        fprintf(stderr, "sqids_field_rewrite(%s): %s", job->path,
+            sqids_strerror(job->err));
+        if (job->err != SQIDS_ERR_ALLOC) {
+            fprintf(stderr, " at byte %llu", job->base + job->out_len);
+        }
+        fputs("\n", stderr);
+        ctx->failed = 1;
+    } else if (fwrite(job->out, 1, job->out_len, stdout) != job->out_len) {
+        fputs("fwrite(): error\n", stderr);
+        ctx->failed = 1;
+    }
+
+    return ctx->failed ? -1 : 0;
+}
+
+/* a free job, flushing the oldest one when all are in use */
+static struct field_job_s *
+field_job(struct field_ctx_s *ctx)
+{
+    if (ctx->filled - ctx->written == ctx->job_cnt &&
+        field_flush(ctx) != 0) {
+        return NULL;
+    }
+
+    return &ctx->jobs[ctx->filled % ctx->job_cnt];
+}
+
+/* hand a filled job to the workers */
+static void
+field_submit(struct field_ctx_s *ctx)
+{
+    pthread_mutex_lock(&ctx->lock);
+    ctx->jobs[ctx->filled % ctx->job_cnt].done = 0;
+    ++ctx->filled;
+    pthread_cond_broadcast(&ctx->cond);
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+/* wait for and write out everything submitted */
+static int
+field_drain(struct field_ctx_s *ctx)
+{
+    while (ctx->written < ctx->filled) {
+        field_flush(ctx);
+    }
+
+    return ctx->failed ? -1 : 0;
+}
+
+/* chunks of a regular file, rewritten in place of the mapping */
+static int
+field_map(struct field_ctx_s *ctx, const char *path, int fd, size_t size)
+{
+    struct field_job_s *job;
+    const char *map, *p;
+    size_t pos, end;
+    int r;
+
+    if ((map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0)) ==
+        MAP_FAILED) {
+        fprintf(stderr, "mmap(%s): %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    madvise((void *)map, size, MADV_SEQUENTIAL);
+
+    for (pos = 0; pos < size; pos = end) {
+        /* whole lines only */
+        end = size - pos > FIELD_CHUNK ? pos + FIELD_CHUNK : size;
+        if (end < size) {
+            p = memchr(map + end, '\n', size - end);
+            end = p ? (size_t)(p + 1 - map) : size;
+        }
+
+        if (!(job = field_job(ctx))) {
+            break;
+        }
+
+        job->path = path;
+        job->base = pos;
+        job->in = map + pos;
+        job->in_len = end - pos;
+        field_submit(ctx);
+    }
+
+    /* the mapping has to outlive its chunks */
+    r = field_drain(ctx);
+    munmap((void *)map, size);
+
+    return r;
+}
+
+/* chunks of a pipe, each one read into its job, carrying over the partial
+   last line */
+static int
+field_read(struct field_ctx_s *ctx, const char *path, int fd)
+{
+    struct field_job_s *job;
+    const char *carry = NULL;
+    size_t carry_len = 0, n, len;
+    unsigned long long base = 0;
+    ssize_t r = 1;
+    const char *p;
+    char *buf;
+
+    while (r > 0 || carry_len) {
+        if (!(job = field_job(ctx))) {
+            return -1;
+        }
+
+        if (job->buf_size < FIELD_CHUNK + carry_len) {
+            if (!(buf = realloc(job->buf, FIELD_CHUNK + carry_len))) {
+                fputs("realloc(): out of memory\n", stderr);
+                return -1;
+            }
+
+            job->buf = buf;
+            job->buf_size = FIELD_CHUNK + carry_len;
+        }
+
+        /* the previous job, still in use, is only read from */
+        memcpy(job->buf, carry, carry_len);
+        n = carry_len;
+
+        for (;;) {
+            while (r > 0 && n < job->buf_size) {
+                if ((r = read(fd, job->buf + n, job->buf_size - n)) < 0) {
+                    if (errno == EINTR) {
+                        r = 1;
+                        continue;
+                    }
+
+                    fprintf(stderr, "read(%s): %s\n", path, strerror(errno));
+                    return -1;
+                }
+
+                n += r;
+            }
+
+            /* a line longer than the buffer */
+            if (r > 0 && !last_newline(job->buf, n)) {
+                if (!(buf = realloc(job->buf, job->buf_size * 2))) {
+                    fputs("realloc(): out of memory\n", stderr);
+                    return -1;
+                }
+
+                job->buf = buf;
+                job->buf_size *= 2;
+                continue;
+            }
+
+            break;
+        }
+
+        /* up to the last newline, or everything at the end */
+        len = n;
+        if (r > 0) {
+            p = last_newline(job->buf, n);
+            len = p + 1 - job->buf;
+        }
+        carry = job->buf + len;
+        carry_len = n - len;
+
+        job->path = path;
+        job->base = base;
+        job->in = job->buf;
+        job->in_len = len;
+        base += len;
+
+        if (len) {
+            field_submit(ctx);
+        }
+    }
+
+    return field_drain(ctx);
+}
+
+/* rewrite a field of the files (or stdin) to stdout */
+int
+sqids_field_files(sqids_t *sqids, unsigned int field, char delim, int flags,
+    unsigned int threads, int path_cnt, char **paths)
+{
+    struct field_ctx_s ctx;
+    pthread_t tid[threads];
+    struct stat st;
+    const char *path;
+    unsigned int i, started;
+    int fd, r = 0;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.sqids = sqids;
+    ctx.field = field;
+    ctx.delim = delim;
+    ctx.flags = flags;
+
+    /* twice the threads, so reading and writing overlap with rewriting */
+    ctx.job_cnt = threads * 2;
+    if (!(ctx.jobs = calloc(ctx.job_cnt, sizeof(struct field_job_s)))) {
+        fputs("calloc(): out of memory\n", stderr);
+        return -1;
+    }
+
+    pthread_mutex_init(&ctx.lock, NULL);
+    pthread_cond_init(&ctx.cond, NULL);
+
+    for (started = 0; started < threads; ++started) {
+        if (pthread_create(&tid[started], NULL, field_worker, &ctx) != 0) {
+            fputs("pthread_create(): error\n", stderr);
+            r = -1;
+            break;
+        }
+    }
+
+    for (i = 0; r == 0 && i < (path_cnt ? (unsigned int)path_cnt : 1); ++i) {
+        path = path_cnt ? paths[i] : "-";
+
+        if (strcmp(path, "-") == 0) {
+            fd = STDIN_FILENO;
+        } else if ((fd = open(path, O_RDONLY)) < 0) {
+            fprintf(stderr, "open(%s): %s\n", path, strerror(errno));
+            r = -1;
+            break;
+        }
+
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            r = field_map(&ctx, path, fd, st.st_size);
+        } else {
+            r = field_read(&ctx, path, fd);
+        }
+
+        if (fd != STDIN_FILENO) {
+            close(fd);
+        }
+    }
+
+    /* on errors, whatever is queued is dropped */
+    pthread_mutex_lock(&ctx.lock);
+    if (r != 0) {
+        ctx.taken = ctx.filled;
+    }
+    ctx.stop = 1;
+    pthread_cond_broadcast(&ctx.cond);
+    pthread_mutex_unlock(&ctx.lock);
+
+    for (i = 0; i < started; ++i) {
+        pthread_join(tid[i], NULL);
+    }
+
+    for (i = 0; i < ctx.job_cnt; ++i) {
+        free(ctx.jobs[i].buf);
+        free(ctx.jobs[i].out);
+    }
+    free(ctx.jobs);
+
+    pthread_cond_destroy(&ctx.cond);
+    pthread_mutex_destroy(&ctx.lock);
+
+    if (r == 0 && fflush(stdout) != 0) {
+        fputs("fflush(): error\n", stderr);
+        r = -1;
+    }
+
+    return r;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
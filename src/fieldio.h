@@ -0,0 +1,24 @@
+#ifndef SQIDS_FIELDIO_H
+#define SQIDS_FIELDIO_H 1
+
+/*****************************************************************************/
+/* {{{ field stuff                                                           */
+/*****************************************************************************/
+
+/*
+ * threaded field rewriting of the command line tool, not part of the library
+ */
+
+/**
+ * rewrite a field of the files (or stdin when there are none) to stdout,
+ * with `threads` workers
+ */
+int
+sqids_field_files(sqids_t *, unsigned int, char, int, unsigned int, int,
+    char **);
+
+/* }}}                                                                       */
+
+#endif /* !defined(SQIDS_FIELDIO_H) */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
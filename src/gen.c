@@ -0,0 +1,805 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <time.h>
+
+#include "sqids.h"
+#include "strerror.h"
+
+/* bounds on the baked tables, which are also built here */
+#define GEN_MIN_LEN_MAX SQIDS_CANONICAL_MAX
+#define GEN_DEPTH_MAX 64
+
+/*
+ * templates are plain C, with `$` standing for the lowercase prefix and `@`
+ * for the uppercase one
+ */
+
+static const char *gen_head =
+    "#include <stddef.h>\n"
+    "#include <stdlib.h>\n"
+    "#include <string.h>\n"
+    "\n";
+
+static const char *gen_proto =
+    "/**\n"
+    " * exact encoded length (not counting the terminator)\n"
+    " */\n"
+    "size_t\n"
+    "$_encoded_len(unsigned int num_cnt, const unsigned long long *nums);\n"
+    "\n"
+    "/**\n"
+    " * encode into a buffer of at least `$_encoded_len() + 1`\n"
+    " */\n"
+    "int\n"
+    "$_encode_buf(char *s, unsigned int num_cnt,\n"
+    "    const unsigned long long *nums);\n"
+    "\n"
+    "/**\n"
+    " * encode (the result should be released with free())\n"
+    " */\n"
+    "char *\n"
+    "$_encode(unsigned int num_cnt, const unsigned long long *nums);\n"
+    "\n"
+    "/**\n"
+    " * length-delimited validate\n"
+    " */\n"
+    "int\n"
+    "$_valid_len(const char *s, size_t n);\n"
+    "\n"
+    "/**\n"
+    " * length-delimited numbers count\n"
+    " */\n"
+    "int\n"
+    "$_num_cnt_len(const char *s, size_t n);\n"
+    "\n"
+    "/**\n"
+    " * numbers count\n"
+    " */\n"
+    "int\n"
+    "$_num_cnt(const char *s);\n"
+    "\n"
+    "/**\n"
+    " * length-delimited decode\n"
+    " */\n"
+    "int\n"
+    "$_decode_len(const char *s, size_t n, unsigned long long *nums,\n"
+    "    unsigned int num_max);\n"
+    "\n"
+    "/**\n"
+    " * decode\n"
+    " */\n"
+    "int\n"
+    "$_decode(const char *s, unsigned long long *nums, unsigned int num_max);\n";
+
+static const char *gen_body =
+    "/* consistent shuffle */\n"
+    "static inline void\n"
+    "$_shuffle(char *alphabet)\n"
+    "{\n"
+    "    int i, j, x, tmp;\n"
+    "\n"
+    "    for (i = 0, j = @_LEN - 1; j > 0; ++i, --j) {\n"
+    "        x = (i * j + alphabet[i] + alphabet[j]) % @_LEN;\n"
+    "        tmp = alphabet[x];\n"
+    "        alphabet[x] = alphabet[i];\n"
+    "        alphabet[i] = tmp;\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "/* alphabet state `k`, given the previous one */\n"
+    "static inline const char *\n"
+    "$_next(int offset, unsigned int k, const char *alphabet, char *tmp)\n"
+    "{\n"
+    "    if (k < @_DEPTH) {\n"
+    "        return $_states[offset][k];\n"
+    "    }\n"
+    "\n"
+    "    if (alphabet != tmp) {\n"
+    "        memcpy(tmp, alphabet, @_LEN + 1);\n"
+    "    }\n"
+    "\n"
+    "    $_shuffle(tmp);\n"
+    "\n"
+    "    return tmp;\n"
+    "}\n"
+    "\n"
+    "/* count of digits needed to encode a number */\n"
+    "static inline unsigned int\n"
+    "$_digits(unsigned long long num)\n"
+    "{\n"
+    "    unsigned int i;\n"
+    "\n"
+    "    for (i = 0; i < @_POW_CNT && num >= $_pow[i]; ++i) {}\n"
+    "\n"
+    "    return i + 1;\n"
+    "}\n"
+    "\n"
+    "/* blocklist check */\n"
+    "static inline int\n"
+    "$_blocked(const char *s, size_t n)\n"
+    "{\n"
+    "#if @_BL_CNT > 0\n"
+    "    size_t i, j, len;\n"
+    "    const char *w;\n"
+    "    char low[n];\n"
+    "\n"
+    "    /* words are folded already, fold the hash once */\n"
+    "    for (i = 0; i < n; ++i) {\n"
+    "        low[i] = s[i] >= 'A' && s[i] <= 'Z' ? s[i] - 'A' + 'a' : s[i];\n"
+    "    }\n"
+    "\n"
+    "    for (i = 0; i < @_BL_CNT; ++i) {\n"
+    "        w = $_bl[i].s;\n"
+    "        len = $_bl[i].len;\n"
+    "\n"
+    "        if (n < len) {\n"
+    "            continue;\n"
+    "        }\n"
+    "\n"
+    "        if (n <= 3 || len <= 3) {\n"
+    "            if (n == len && memcmp(low, w, n) == 0) {\n"
+    "                return 1;\n"
+    "            }\n"
+    "        } else if ($_bl[i].digits) {\n"
+    "            if (memcmp(low, w, len) == 0 ||\n"
+    "                memcmp(low + n - len, w, len) == 0) {\n"
+    "                return 1;\n"
+    "            }\n"
+    "        } else {\n"
+    "            for (j = 0; j + len <= n; ++j) {\n"
+    "                if (memcmp(low + j, w, len) == 0) {\n"
+    "                    return 1;\n"
+    "                }\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "#endif\n"
+    "\n"
+    "    return 0;\n"
+    "}\n"
+    "\n"
+    "/* single encode attempt, returns the end of the hash */\n"
+    "static inline char *\n"
+    "$_attempt(char *s, unsigned int num_cnt, const unsigned long long *nums,\n"
+    "    int offset)\n"
+    "{\n"
+    "    unsigned long long num;\n"
+    "    unsigned int i, k;\n"
+    "    const char *alphabet;\n"
+    "    char tmp[@_LEN + 1], *p, *pb;\n"
+    "\n"
+    "    /* start with prefix */\n"
+    "    p = s;\n"
+    "    *p++ = $_alphabet[offset];\n"
+    "    alphabet = $_states[offset][0];\n"
+    "\n"
+    "    for (i = 0; i < num_cnt; ++i) {\n"
+    "        /* emit digits back to front, the base is a constant */\n"
+    "        num = nums[i];\n"
+    "        pb = p + $_digits(num);\n"
+    "        p = pb;\n"
+    "        do {\n"
+    "            *--p = alphabet[num % @_BASE + 1];\n"
+    "            num /= @_BASE;\n"
+    "        } while (num > 0);\n"
+    "        p = pb;\n"
+    "\n"
+    "        /* more numbers to encode - append a separator, next alphabet */\n"
+    "        if (i < num_cnt - 1) {\n"
+    "            *p++ = alphabet[0];\n"
+    "            alphabet = $_next(offset, i + 1, alphabet, tmp);\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    /* handle min_len */\n"
+    "    if (p - s < @_MIN_LEN) {\n"
+    "        if (num_cnt <= 1) {\n"
+    "            /* padding of single numbers is baked */\n"
+    "            memcpy(p, $_pad[offset], @_MIN_LEN - (p - s));\n"
+    "            p = s + @_MIN_LEN;\n"
+    "        } else {\n"
+    "            *p++ = alphabet[0];\n"
+    "\n"
+    "            for (k = num_cnt; p - s < @_MIN_LEN; ++k) {\n"
+    "                alphabet = $_next(offset, k, alphabet, tmp);\n"
+    "                i = @_MIN_LEN - (p - s) < @_LEN ?\n"
+    "                    @_MIN_LEN - (p - s) : @_LEN;\n"
+    "                memcpy(p, alphabet, i);\n"
+    "                p += i;\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    *p = 0;\n"
+    "\n"
+    "    return p;\n"
+    "}\n"
+    "\n"
+    "/* exact encoded length */\n"
+    "size_t\n"
+    "$_encoded_len(unsigned int num_cnt, const unsigned long long *nums)\n"
+    "{\n"
+    "    unsigned int i;\n"
+    "    size_t result;\n"
+    "\n"
+    "    for (i = 0, result = num_cnt ? num_cnt : 1; i < num_cnt; ++i) {\n"
+    "        result += $_digits(nums[i]);\n"
+    "    }\n"
+    "\n"
+    "    return result > @_MIN_LEN ? result : @_MIN_LEN;\n"
+    "}\n"
+    "\n"
+    "/* encode into a caller-supplied buffer */\n"
+    "int\n"
+    "$_encode_buf(char *s, unsigned int num_cnt,\n"
+    "    const unsigned long long *nums)\n"
+    "{\n"
+    "    int i, offset, increment;\n"
+    "    char *p;\n"
+    "\n"
+    "    /* get a semi-random offset from input numbers */\n"
+    "    for (i = 0, offset = num_cnt; i < num_cnt; ++i) {\n"
+    "        offset = $_alphabet[nums[i] % @_LEN] + i + offset;\n"
+    "    }\n"
+    "    offset %= @_LEN;\n"
+    "\n"
+    "    for (increment = 0; increment <= @_LEN; ++increment) {\n"
+    "        p = $_attempt(s, num_cnt, nums, (offset + increment) % @_LEN);\n"
+    "\n"
+    "        if (!$_blocked(s, p - s)) {\n"
+    "            return p - s;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    return -1;\n"
+    "}\n"
+    "\n"
+    "/* encode */\n"
+    "char *\n"
+    "$_encode(unsigned int num_cnt, const unsigned long long *nums)\n"
+    "{\n"
+    "    char *result;\n"
+    "\n"
+    "    if (!(result = malloc($_encoded_len(num_cnt, nums) + 1))) {\n"
+    "        return NULL;\n"
+    "    }\n"
+    "\n"
+    "    if ($_encode_buf(result, num_cnt, nums) < 0) {\n"
+    "        free(result);\n"
+    "        return NULL;\n"
+    "    }\n"
+    "\n"
+    "    return result;\n"
+    "}\n"
+    "\n"
+    "/* length-delimited validate */\n"
+    "int\n"
+    "$_valid_len(const char *s, size_t n)\n"
+    "{\n"
+    "    size_t i;\n"
+    "\n"
+    "    for (i = 0; i < n; ++i) {\n"
+    "        if (!$_index[(unsigned char)s[i]]) {\n"
+    "            return 0;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    return 1;\n"
+    "}\n"
+    "\n"
+    "/* walk a hash, storing up to `num_max` numbers when `nums` is given */\n"
+    "static inline int\n"
+    "$_walk(const char *s, size_t n, unsigned long long *nums,\n"
+    "    unsigned int num_max)\n"
+    "{\n"
+    "    unsigned long long num;\n"
+    "    unsigned int i, k, d;\n"
+    "    int offset, separator;\n"
+    "    const char *p, *end, *alphabet;\n"
+    "    char tmp[@_LEN + 1];\n"
+    "\n"
+    "    /* safety first - scan str for unknown characters */\n"
+    "    if (!$_valid_len(s, n)) {\n"
+    "        return -1;\n"
+    "    }\n"
+    "\n"
+    "    /* empty string - nothing to decode (technically not an error) */\n"
+    "    if (!n) {\n"
+    "        return 0;\n"
+    "    }\n"
+    "\n"
+    "    p = s;\n"
+    "    end = s + n;\n"
+    "    offset = $_index[(unsigned char)*p++] - 1;\n"
+    "    alphabet = $_states[offset][0];\n"
+    "\n"
+    "    for (i = 0, k = 0; p < end && i < num_max;) {\n"
+    "        separator = alphabet[0];\n"
+    "\n"
+    "        /* empty chunk - we're done */\n"
+    "        if (*p == separator) {\n"
+    "            break;\n"
+    "        }\n"
+    "\n"
+    "        for (num = 0; p < end && *p != separator; ++p) {\n"
+    "            if (!nums) {\n"
+    "                continue;\n"
+    "            }\n"
+    "\n"
+    "            if (k < @_DEPTH) {\n"
+    "                d = $_states_rev[offset][k][\n"
+    "                    $_index[(unsigned char)*p] - 1] - 1;\n"
+    "            } else {\n"
+    "                d = (char *)memchr(alphabet + 1, *p, @_BASE) - alphabet - 1;\n"
+    "            }\n"
+    "\n"
+    "            /* overflow protection */\n"
+    "            if (num > (0xFFFFFFFFFFFFFFFFull - d) / @_BASE) {\n"
+    "                return -1;\n"
+    "            }\n"
+    "\n"
+    "            num = num * @_BASE + d;\n"
+    "        }\n"
+    "\n"
+    "        if (nums) {\n"
+    "            nums[i] = num;\n"
+    "        }\n"
+    "        ++i;\n"
+    "\n"
+    "        /* more numbers - next alphabet */\n"
+    "        if (p < end && *p == separator) {\n"
+    "            alphabet = $_next(offset, ++k, alphabet, tmp);\n"
+    "            ++p;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    return i;\n"
+    "}\n"
+    "\n"
+    "/* length-delimited numbers count */\n"
+    "int\n"
+    "$_num_cnt_len(const char *s, size_t n)\n"
+    "{\n"
+    "    return $_walk(s, n, NULL, -1);\n"
+    "}\n"
+    "\n"
+    "/* numbers count */\n"
+    "int\n"
+    "$_num_cnt(const char *s)\n"
+    "{\n"
+    "    return $_walk(s, strlen(s), NULL, -1);\n"
+    "}\n"
+    "\n"
+    "/* length-delimited decode */\n"
+    "int\n"
+    "$_decode_len(const char *s, size_t n, unsigned long long *nums,\n"
+    "    unsigned int num_max)\n"
+    "{\n"
+    "    return $_walk(s, n, nums, num_max);\n"
+    "}\n"
+    "\n"
+    "/* decode */\n"
+    "int\n"
+    "$_decode(const char *s, unsigned long long *nums, unsigned int num_max)\n"
+    "{\n"
+    "    return $_walk(s, strlen(s), nums, num_max);\n"
+    "}\n";
+
+/* close an output file, reporting write errors */
+static int
+gen_close(FILE *out, const char *path)
+{
+    int err;
+
+    err = ferror(out);
+    if ((out == stdout ? fflush(out) : fclose(out)) != 0 || err) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    return 0;
+}
+
+/* print a template, substituting prefixes */
+static void
+gen_template(FILE *out, const char *tmpl, const char *prefix,
+    const char *uprefix)
+{
+    for (; *tmpl; ++tmpl) {
+        if (*tmpl == '$') {
+            fputs(prefix, out);
+        } else if (*tmpl == '@') {
+            fputs(uprefix, out);
+        } else {
+            fputc(*tmpl, out);
+        }
+    }
+}
+
+/* print a C string literal */
+static void
+gen_string(FILE *out, const char *s, int len)
+{
+    int i;
+
+    fputc('"', out);
+    for (i = 0; i < len; ++i) {
+        if (isalnum((unsigned char)s[i])) {
+            fputc(s[i], out);
+        } else {
+            fprintf(out, "\\%03o", (unsigned char)s[i]);
+        }
+    }
+    fputc('"', out);
+}
+
+/* print a byte table row */
+static void
+gen_bytes(FILE *out, const unsigned char *b, int len, const char *indent)
+{
+    int i;
+
+    fputs("{", out);
+    for (i = 0; i < len; ++i) {
+        if (i && i % 16 == 0) {
+            fprintf(out, "\n%s ", indent);
+        }
+        fprintf(out, "%d%s", b[i], i < len - 1 ? ", " : "");
+    }
+    fputs("}", out);
+}
+
+/* can a (folded) word appear in hashes made of this alphabet? */
+static int
+gen_reachable(const char *alphabet, const char *word)
+{
+    const char *p;
+
+    for (; *word; ++word) {
+        for (p = alphabet; *p; ++p) {
+            if (tolower((unsigned char)*p) == *word) {
+                break;
+            }
+        }
+
+        if (!*p) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static void
+usage(const char *progname, FILE *out)
+{
+    fputs("\n", out);
+    fputs("Usage:\n", out);
+    fprintf(out, "  %s [options]\n", progname);
+
+    fputs("\n", out);
+    fputs("Options:\n", out);
+    fputs("  -a, --alphabet            set alphabet [" SQIDS_DEFAULT_ALPHABET
+        "]\n", out);
+    fputs("  -l, --min-length          set hash minimum length (0-4096) [0]\n",
+        out);
+    fputs("  -b, --default-blocklist   include a default blocklist "
+        "(de,en,es,fr,hi,it,pt,none,all) [all]\n", out);
+    fputs("  -w, --block-word          add a word to the blocklist\n", out);
+    fputs("  -p, --prefix              set symbol prefix [sqids_fixed]\n",
+        out);
+    fputs("  -d, --depth               set count of baked shuffles (1-64) "
+        "[4]\n",
+        out);
+    fputs("  -o, --output              write source to file [stdout]\n", out);
+    fputs("  -H, --header              also write a header to file\n", out);
+    fputs("  -h, --help                print this message and exit\n", out);
+    fputs("  -v, --version             print version information and exit\n",
+        out);
+
+    fputs("\n", out);
+    exit(out == stderr ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+int
+main(int argc, char **argv)
+{
+    sqids_t *sqids;
+    sqids_bl_t *blocklist, *shared;
+    sqids_bl_node_t *node;
+    FILE *out;
+    char *alphabet = SQIDS_DEFAULT_ALPHABET, *prefix = "sqids_fixed";
+    char *output = NULL, *header = NULL, *bl_name = "all", *p, *uprefix;
+    char *words[argc], *states, *s;
+    int min_len = 0, depth = 4, word_cnt = 0, ch, i, j, k, len, bl_cnt;
+
+    static const struct option longopts[] = {
+        {"alphabet", required_argument, NULL, 'a'},
+        {"min-length", required_argument, NULL, 'l'},
+        {"default-blocklist", required_argument, NULL, 'b'},
+        {"block-word", required_argument, NULL, 'w'},
+        {"prefix", required_argument, NULL, 'p'},
+        {"depth", required_argument, NULL, 'd'},
+        {"output", required_argument, NULL, 'o'},
+        {"header", required_argument, NULL, 'H'},
+        {"help", no_argument, NULL, 'h'},
+        {"version", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    /* parse command line options */
+    while ((ch = getopt_long(argc, argv, "a:l:b:w:p:d:o:H:hv", longopts,
+        NULL)) != -1) {
+        switch (ch) {
+            case 'a':
+                alphabet = optarg;
+                break;
+            case 'l':
+                min_len = strtol(optarg, &p, 0);
+                if (p == optarg || min_len < 0 || min_len > GEN_MIN_LEN_MAX) {
+                    fprintf(stderr, "--min-length: invalid value \"%s\"\n",
+                        optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'b':
+                bl_name = optarg;
+                break;
+            case 'w':
+                words[word_cnt++] = optarg;
+                break;
+            case 'p':
+                prefix = optarg;
+                break;
+            case 'd':
+                depth = strtol(optarg, &p, 0);
+                if (p == optarg || depth < 1 || depth > GEN_DEPTH_MAX) {
+                    fprintf(stderr, "--depth: invalid value \"%s\"\n",
+                        optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'H':
+                header = optarg;
+                break;
+            case 'h':
+                usage(argv[0], stdout);
+                break;
+            case 'v':
+                fputs(SQIDS_VERSION_STRING, stdout);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0], stderr);
+        }
+    }
+
+    /* a private copy of the default list, as its words get folded below */
+    if (strcmp(bl_name, "none") == 0) {
+        blocklist = sqids_bl_new(sqids_bl_match);
+    } else if (!(shared = sqids_bl_default(bl_name))) {
+        fprintf(stderr, "sqids_bl_default(%s): %s\n", bl_name,
+            sqids_strerror(sqids_errno));
+        return EXIT_FAILURE;
+    } else {
+        blocklist = sqids_bl_dup(shared);
+        sqids_bl_free(shared);
+    }
+
+    if (!blocklist) {
+        fprintf(stderr, "sqids_bl_new(): %s\n", sqids_strerror(sqids_errno));
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < word_cnt; ++i) {
+        if (!sqids_bl_add_tail(blocklist, words[i])) {
+            fprintf(stderr, "sqids_bl_add_tail(): %s\n",
+                sqids_strerror(sqids_errno));
+            sqids_bl_free(blocklist);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* the library does all the hard work */
+    if (!(sqids = sqids_new(alphabet, min_len, blocklist))) {
+        fprintf(stderr, "sqids_new(): %s\n", sqids_strerror(sqids_errno));
+        sqids_bl_free(blocklist);
+        return EXIT_FAILURE;
+    }
+
+    len = sqids->len;
+    uprefix = strdup(prefix);
+    for (p = uprefix; *p; ++p) {
+        *p = toupper((unsigned char)*p);
+    }
+
+    /* header */
+    if (header) {
+        if (!(out = fopen(header, "w"))) {
+            perror(header);
+            return EXIT_FAILURE;
+        }
+
+        fprintf(out, "/* generated by sqids-gen %s */\n\n",
+            SQIDS_VERSION_STRING);
+        fprintf(out, "#ifndef %s_H\n#define %s_H 1\n\n", uprefix, uprefix);
+        fputs("#include <stddef.h>\n\n", out);
+        gen_template(out, gen_proto, prefix, uprefix);
+        fprintf(out, "\n#endif /* !defined(%s_H) */\n", uprefix);
+        if (gen_close(out, header) != 0) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!output) {
+        out = stdout;
+    } else if (!(out = fopen(output, "w"))) {
+        perror(output);
+        return EXIT_FAILURE;
+    }
+
+    /* constants */
+    fprintf(out, "/* generated by sqids-gen %s: alphabet ",
+        SQIDS_VERSION_STRING);
+    gen_string(out, alphabet, strlen(alphabet));
+    fprintf(out, ", min_len %d */\n\n", min_len);
+    gen_template(out, gen_head, prefix, uprefix);
+    gen_template(out, gen_proto, prefix, uprefix);
+    fputs("\n", out);
+
+    for (bl_cnt = 0, node = sqids->blocklist->head; node; node = node->next) {
+        for (p = node->s; *p; ++p) {
+            *p = tolower((unsigned char)*p);
+        }
+
+        bl_cnt += gen_reachable(sqids->alphabet, node->s);
+    }
+
+    fprintf(out, "#define %s_LEN %d\n", uprefix, len);
+    fprintf(out, "#define %s_BASE %d\n", uprefix, len - 1);
+    fprintf(out, "#define %s_MIN_LEN %d\n", uprefix, min_len);
+    fprintf(out, "#define %s_DEPTH %d\n", uprefix, depth);
+    fprintf(out, "#define %s_POW_CNT %u\n", uprefix, sqids->pow_cnt);
+    fprintf(out, "#define %s_BL_CNT %d\n\n", uprefix, bl_cnt);
+
+    /* shuffled alphabet and its reverse lookup */
+    unsigned char index[256];
+    memset(index, 0, sizeof(index));
+    for (i = 0; i < len; ++i) {
+        index[(unsigned char)sqids->alphabet[i]] = i + 1;
+    }
+
+    fprintf(out, "/* shuffled alphabet */\nstatic const char %s_alphabet"
+        "[%s_LEN + 1] =\n    ", prefix, uprefix);
+    gen_string(out, sqids->alphabet, len);
+    fputs(";\n\n", out);
+
+    fprintf(out, "/* alphabet position + 1 of every byte, 0 for bytes not in "
+        "the alphabet */\nstatic const unsigned char %s_index[256] = ",
+        prefix);
+    gen_bytes(out, index, 256, "   ");
+    fputs(";\n\n", out);
+
+    /* powers of the base */
+    fprintf(out, "/* powers of the base */\nstatic const unsigned long long "
+        "%s_pow[%s_POW_CNT] = {\n", prefix, uprefix);
+    for (i = 0; i < sqids->pow_cnt; ++i) {
+        fprintf(out, "    %lluull,\n", sqids->pow[i]);
+    }
+    fputs("};\n\n", out);
+
+    /* alphabet states: rotated by offset, reversed, then shuffled `k` times,
+       `depth` rows of `len + 1` per offset */
+    if (!(states = malloc((size_t)len * depth * (len + 1)))) {
+        fputs("malloc(): out of memory\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < len; ++i) {
+        s = states + (size_t)i * depth * (len + 1);
+        for (j = 0; j < len; ++j) {
+            s[j] = sqids->alphabet[(i + len - 1 - j) % len];
+        }
+        s[len] = 0;
+
+        for (k = 1; k < depth; ++k, s += len + 1) {
+            memcpy(s + len + 1, s, len + 1);
+            sqids_shuffle(s + len + 1);
+        }
+    }
+
+    fprintf(out, "/* alphabet states per offset, after 0..%s_DEPTH - 1 "
+        "shuffles */\nstatic const char %s_states[%s_LEN][%s_DEPTH]"
+        "[%s_LEN + 1] = {\n", uprefix, prefix, uprefix, uprefix, uprefix);
+    for (i = 0; i < len; ++i) {
+        fputs("    {\n", out);
+        s = states + (size_t)i * depth * (len + 1);
+        for (k = 0; k < depth; ++k, s += len + 1) {
+            fputs("        ", out);
+            gen_string(out, s, len);
+            fputs(",\n", out);
+        }
+        fputs("    },\n", out);
+    }
+    fputs("};\n\n", out);
+
+    /* reverse lookup of the states */
+    fprintf(out, "/* state position of every alphabet position */\n"
+        "static const unsigned char %s_states_rev[%s_LEN][%s_DEPTH]"
+        "[%s_LEN] = {\n", prefix, uprefix, uprefix, uprefix);
+    for (i = 0; i < len; ++i) {
+        fputs("    {\n", out);
+        s = states + (size_t)i * depth * (len + 1);
+        for (k = 0; k < depth; ++k, s += len + 1) {
+            unsigned char rev[len];
+
+            for (j = 0; j < len; ++j) {
+                rev[index[(unsigned char)s[j]] - 1] = j;
+            }
+
+            fputs("        ", out);
+            gen_bytes(out, rev, len, "        ");
+            fputs(",\n", out);
+        }
+        fputs("    },\n", out);
+    }
+    fputs("};\n\n", out);
+
+    /* padding material of single numbers: separator + shuffle chain */
+    fprintf(out, "/* padding per offset for zero or one numbers */\n"
+        "static const char %s_pad[%s_LEN][%s_MIN_LEN + 1] = {\n", prefix,
+        uprefix, uprefix);
+    for (i = 0; i < len; ++i) {
+        char pad[min_len + len + 1], state[len + 1];
+
+        memcpy(state, states + (size_t)i * depth * (len + 1), len + 1);
+        pad[0] = state[0];
+        for (j = 1; j < min_len; j += len) {
+            sqids_shuffle(state);
+            memcpy(pad + j, state, len);
+        }
+
+        fputs("    ", out);
+        gen_string(out, pad, min_len);
+        fputs(",\n", out);
+    }
+    fputs("};\n\n", out);
+
+    /* blocklist words that can appear in hashes, folded to lowercase */
+    if (bl_cnt) {
+        fprintf(out, "/* blocklist, pruned to the alphabet */\n"
+            "static const struct {\n"
+            "    const char *s;\n"
+            "    unsigned char len;\n"
+            "    unsigned char digits;\n"
+            "} %s_bl[%s_BL_CNT] = {\n", prefix, uprefix);
+        sqids_bl_foreach(sqids->blocklist->head, node) {
+            if (gen_reachable(sqids->alphabet, node->s)) {
+                fputs("    {", out);
+                gen_string(out, node->s, strlen(node->s));
+                fprintf(out, ", %d, %d},\n", (int)strlen(node->s),
+                    strpbrk(node->s, "0123456789") != NULL);
+            }
+        }
+        fputs("};\n\n", out);
+    }
+
+    gen_template(out, gen_body, prefix, uprefix);
+
+    free(states);
+    free(uprefix);
+    sqids_free(sqids);
+
+    return gen_close(out, output ? output : "stdout") != 0 ? EXIT_FAILURE :
+        EXIT_SUCCESS;
+}
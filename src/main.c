@@ -6,9 +6,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <getopt.h>
-#include <errno.h>
+#include <unistd.h>
 
 #include "sqids.h"
+#include "strerror.h"
+#include "fieldio.h"
 
 enum {
     COMMAND_ENCODE = 0,
@@ -32,7 +34,19 @@ usage(const char *progname, FILE *out)
     fputs("  -l, --min-length          set hash minimum length [0]\n", out);
     fputs("  -b, --default-blocklist   include a default blocklist "
         "(de,en,es,fr,hi,it,pt,none,all) [all]\n", out);
+    fputs("  -B, --blocklist-file      use a blocklist compiled by "
+        "sqids-bl instead\n", out);
     fputs("  -w, --block-word          add a word to the blocklist\n", out);
+    fputs("  -f, --field               rewrite this field (from 1) of "
+        "every line of the\n"
+        "                            files (or stdin) instead\n", out);
+    fputs("  -t, --delimiter           set field delimiter [\\t]\n", out);
+    fputs("  -k, --keep-invalid        leave fields that do not convert "
+        "as they are\n", out);
+    fputs("  -j, --jobs                set number of field rewriting "
+        "threads [cpus]\n", out);
+    fputs("  -P, --phases              print per-phase counters to stderr\n",
+        out);
     fputs("  -h, --help                print this message and exit\n", out);
     fputs("  -v, --version             print version information and exit\n",
         out);
@@ -41,6 +55,56 @@ usage(const char *progname, FILE *out)
     exit(out == stderr ? EXIT_FAILURE : EXIT_SUCCESS);
 }
 
+static void
+print_phases(void)
+{
+    sqids_phase_stats_t stats[SQIDS_PHASE_CNT];
+    int i;
+
+    if (sqids_phase_snapshot(stats) < 0) {
+        fputs("phases: not available (build with --enable-instrumentation)\n",
+            stderr);
+        return;
+    }
+
+    fprintf(stderr, "%-10s %12s %16s %10s\n", "phase", "calls", "cycles",
+        "avg");
+    for (i = 0; i < SQIDS_PHASE_CNT; ++i) {
+        fprintf(stderr, "%-10s %12llu %16llu %10.1f\n", sqids_phase_name(i),
+            stats[i].calls, stats[i].cycles,
+            stats[i].calls ? (double)stats[i].cycles / stats[i].calls : 0.0);
+    }
+}
+
+/* languages of a default blocklist name, -1 if unknown */
+static long long
+parse_bl_mask(const char *s)
+{
+    static const struct {
+        const char *name;
+        unsigned int mask;
+    } names[] = {
+        {"all", SQIDS_BL_ALL},
+        {"none", 0},
+        {"de", SQIDS_BL_DE},
+        {"en", SQIDS_BL_EN},
+        {"es", SQIDS_BL_ES},
+        {"fr", SQIDS_BL_FR},
+        {"hi", SQIDS_BL_HI},
+        {"it", SQIDS_BL_IT},
+        {"pt", SQIDS_BL_PT},
+    };
+    unsigned int i;
+
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(s, names[i].name) == 0) {
+            return names[i].mask;
+        }
+    }
+
+    return -1;
+}
+
 static unsigned long long
 parse_num(const char *s, char **p)
 {
@@ -59,26 +123,32 @@ parse_num(const char *s, char **p)
     return strtoull(s, p, radix);
 }
 
-static char *
-sqids_strerror(int e)
+static int
+parse_delim(const char *s)
 {
-    switch (e) {
-        case SQIDS_ERR_ALLOC:       return "out of memory";
-        case SQIDS_ERR_ALPHABET:    return "alphabet is too short";
-        case SQIDS_ERR_MAX_RETRIES: return "max retries reached";
-        case SQIDS_ERR_INVALID:     return "invalid hash";
-        case SQIDS_ERR_OVERFLOW:    return "integer overflow";
-        default: return "unknown error";
+    if (strcmp(s, "\\t") == 0 || strcmp(s, "tab") == 0) {
+        return '\t';
+    }
+
+    if (strlen(s) != 1 || *s == '\n' || *s == '"') {
+        return -1;
     }
+
+    return (unsigned char)*s;
 }
 
 int
 main(int argc, char **argv)
 {
     sqids_t *sqids;
-    sqids_bl_t *blocklist;
-    char *alphabet = SQIDS_DEFAULT_ALPHABET, *p, *buf;
-    int command = COMMAND_ENCODE, min_len = 0, ch, i, j, num_cnt;
+    sqids_bl_t *blocklist, *shared;
+    char *alphabet = SQIDS_DEFAULT_ALPHABET, *bl_name = NULL, *p, *buf;
+    char *bl_file = NULL;
+    long long bl_mask = SQIDS_BL_ALL;
+    char *words[argc];
+    int command = COMMAND_ENCODE, min_len = 0, phases = 0, word_cnt = 0;
+    int ch, i, j, num_cnt, field = 0, delim = '\t', flags = 0;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
 
     static const struct option longopts[] = {
         {"encode", no_argument, NULL, 'e'},
@@ -86,21 +156,20 @@ main(int argc, char **argv)
         {"alphabet", required_argument, NULL, 'a'},
         {"min-length", required_argument, NULL, 'l'},
         {"default-blocklist", required_argument, NULL, 'b'},
+        {"blocklist-file", required_argument, NULL, 'B'},
         {"block-word", required_argument, NULL, 'w'},
+        {"field", required_argument, NULL, 'f'},
+        {"delimiter", required_argument, NULL, 't'},
+        {"keep-invalid", no_argument, NULL, 'k'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"phases", no_argument, NULL, 'P'},
         {"help", no_argument, NULL, 'h'},
         {"version", no_argument, NULL, 'v'},
         {NULL, 0, NULL, 0}
     };
 
-    /* start with default blocklist */
-    if (!(blocklist = sqids_bl_list_all(sqids_bl_match))) {
-        fprintf(stderr, "sqids_bl_list_all(): %s\n",
-            sqids_strerror(sqids_errno));
-        return EXIT_FAILURE;
-    }
-
     /* parse command line options */
-    while ((ch = getopt_long(argc, argv, "+eda:l:b:w:hv", longopts,
+    while ((ch = getopt_long(argc, argv, "+eda:l:b:B:w:f:t:kj:Phv", longopts,
         NULL)) != -1) {
         switch (ch) {
             case 'e':
@@ -121,54 +190,43 @@ main(int argc, char **argv)
                 }
                 break;
             case 'b':
-                if (strcmp(optarg, "de") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_de(sqids_bl_match);
-                } else if (strcmp(optarg, "en") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_en(sqids_bl_match);
-                } else if (strcmp(optarg, "es") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_es(sqids_bl_match);
-                } else if (strcmp(optarg, "fr") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_fr(sqids_bl_match);
-                } else if (strcmp(optarg, "hi") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_hi(sqids_bl_match);
-                } else if (strcmp(optarg, "it") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_it(sqids_bl_match);
-                } else if (strcmp(optarg, "pt") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_pt(sqids_bl_match);
-                } else if (strcmp(optarg, "none") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_new(sqids_bl_match);
-                } else if (strcmp(optarg, "all") == 0) {
-                    sqids_bl_free(blocklist);
-                    blocklist = sqids_bl_list_all(sqids_bl_match);
-                } else {
-                    fprintf(stderr, "--blocklist: unknown value \"%s\"\n",
+                bl_name = optarg;
+                break;
+            case 'B':
+                bl_file = optarg;
+                break;
+            case 'w':
+                words[word_cnt++] = optarg;
+                break;
+            case 'f':
+                field = parse_num(optarg, &p);
+                if (p == optarg || *p || field < 1) {
+                    fprintf(stderr, "--field: invalid value \"%s\"\n",
                         optarg);
                     return EXIT_FAILURE;
                 }
-
-                if (!blocklist) {
-                    fprintf(stderr, "sqids_bl_new(): %s\n",
-                        sqids_strerror(sqids_errno));
+                break;
+            case 't':
+                if ((delim = parse_delim(optarg)) < 0) {
+                    fprintf(stderr, "--delimiter: invalid value \"%s\"\n",
+                        optarg);
                     return EXIT_FAILURE;
                 }
-
                 break;
-            case 'w':
-                if (!sqids_bl_add_tail(blocklist, optarg)) {
-                    fprintf(stderr, "sqids_bl_add_tail(): %s\n",
-                        sqids_strerror(sqids_errno));
-                    sqids_bl_free(blocklist);
+            case 'k':
+                flags |= SQIDS_FIELD_KEEP;
+                break;
+            case 'j':
+                jobs = parse_num(optarg, &p);
+                if (p == optarg || *p || jobs < 1 || jobs > 1024) {
+                    fprintf(stderr, "--jobs: invalid value \"%s\"\n",
+                        optarg);
                     return EXIT_FAILURE;
                 }
                 break;
+            case 'P':
+                phases = 1;
+                break;
             case 'h':
                 usage(argv[0], stdout);
                 break;
@@ -180,20 +238,97 @@ main(int argc, char **argv)
         }
     }
 
-    /* no arguments? */
-    if (optind == argc) {
+    /* no arguments? (fields are read from stdin then) */
+    if (optind == argc && !field) {
         usage(argv[0], stderr);
     }
 
+    if (bl_file && bl_name) {
+        fputs("--blocklist-file: can't be combined with "
+            "--default-blocklist\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    /* fields only decode canonical ids, which are no longer than this */
+    if (field && min_len > SQIDS_CANONICAL_MAX) {
+        fprintf(stderr, "--min-length: at most %d with --field\n",
+            SQIDS_CANONICAL_MAX);
+        return EXIT_FAILURE;
+    }
+
+    if (bl_name && (bl_mask = parse_bl_mask(bl_name)) < 0) {
+        fprintf(stderr, "--default-blocklist: unknown value \"%s\"\n",
+            bl_name);
+        return EXIT_FAILURE;
+    }
+
+    /* the shared "all" list, masked to the languages asked for once the
+       structure is built, or a private copy to add words to */
+    blocklist = NULL;
+    if (bl_file) {
+        if (!(blocklist = sqids_bl_load_mmap(bl_file, NULL))) {
+            fprintf(stderr, "sqids_bl_load_mmap(%s): %s\n", bl_file,
+                sqids_strerror(sqids_errno));
+            return EXIT_FAILURE;
+        }
+    } else if (bl_mask) {
+        if (!(blocklist = sqids_bl_default("all"))) {
+            fprintf(stderr, "sqids_bl_default(): %s\n",
+                sqids_strerror(sqids_errno));
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (word_cnt) {
+        shared = blocklist;
+        blocklist = shared ? sqids_bl_dup(shared) : sqids_bl_new(NULL);
+
+        if (shared) {
+            sqids_bl_free(shared);
+        }
+
+        if (!blocklist) {
+            fprintf(stderr, "sqids_bl_new(): %s\n",
+                sqids_strerror(sqids_errno));
+            return EXIT_FAILURE;
+        }
+
+        for (i = 0; i < word_cnt; ++i) {
+            if (!sqids_bl_add_tail(blocklist, words[i])) {
+                fprintf(stderr, "sqids_bl_add_tail(): %s\n",
+                    sqids_strerror(sqids_errno));
+                sqids_bl_free(blocklist);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
     /* initialize sqids */
     if (!(sqids = sqids_new(alphabet, min_len, blocklist))) {
         fprintf(stderr, "sqids_new(): %s\n",
             sqids_strerror(sqids_errno));
-        sqids_bl_free(blocklist);
+        if (blocklist) {
+            sqids_bl_free(blocklist);
+        }
         return EXIT_FAILURE;
     }
 
-    if (command == COMMAND_ENCODE) {
+    if (!bl_file && bl_mask && bl_mask != SQIDS_BL_ALL) {
+        sqids_bl_mask_set(sqids, bl_mask);
+    }
+
+    if (field) {
+        /* rewrite fields */
+        if (command == COMMAND_DECODE) {
+            flags |= SQIDS_FIELD_DECODE;
+        }
+
+        if (sqids_field_files(sqids, field, delim, flags, jobs < 1 ? 1 : jobs,
+            argc - optind, argv + optind) != 0) {
+            sqids_free(sqids);
+            return EXIT_FAILURE;
+        }
+    } else if (command == COMMAND_ENCODE) {
         /* encode */
         num_cnt = argc - optind;
         unsigned long long nums[num_cnt];
@@ -256,6 +391,10 @@ main(int argc, char **argv)
         /* !@#$? */
     }
 
+    if (phases) {
+        print_phases();
+    }
+
     sqids_free(sqids);
 
     return EXIT_SUCCESS;
@@ -0,0 +1,252 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ minter stuff                                                          */
+/*****************************************************************************/
+
+/* default numbers reserved per block */
+#define SQIDS_MINTER_BLOCK 1024
+
+/* per-thread state: a reserved block, encoded up front */
+struct sqids_minter_local_s {
+    struct sqids_minter_s *minter;
+    unsigned long long begin;
+    unsigned int pos;
+    unsigned int cnt;
+    unsigned long long *nums;
+    char *ids;
+    struct sqids_minter_local_s *prev;
+    struct sqids_minter_local_s *next;
+};
+typedef struct sqids_minter_local_s sqids_minter_local_t;
+
+/* minter */
+struct sqids_minter_s {
+    sqids_t *sqids;
+    unsigned long long start;
+    unsigned long long block_max;   /* blocks before the sequence runs out */
+    unsigned long long block_next;  /* the only shared hot word */
+    unsigned int block;
+    size_t stride;
+    pthread_key_t key;
+    pthread_mutex_t lock;           /* guards the list of locals */
+    sqids_minter_local_t *locals;
+};
+
+/* free a thread's state */
+static void
+sqids_minter_local_free(sqids_minter_local_t *local)
+{
+    sqids_mem_free(local->nums);
+    sqids_mem_free(local->ids);
+    sqids_mem_free(local);
+}
+
+/* thread exit - unlink and free the thread's state */
+static void
+sqids_minter_local_destroy(void *arg)
+{
+    sqids_minter_local_t *local = arg;
+    sqids_minter_t *minter = local->minter;
+
+    pthread_mutex_lock(&minter->lock);
+
+    if (local->prev) {
+        local->prev->next = local->next;
+    } else {
+        minter->locals = local->next;
+    }
+
+    if (local->next) {
+        local->next->prev = local->prev;
+    }
+
+    pthread_mutex_unlock(&minter->lock);
+
+    sqids_minter_local_free(local);
+}
+
+/* the calling thread's state, created on first use */
+static sqids_minter_local_t *
+sqids_minter_local(sqids_minter_t *minter)
+{
+    sqids_minter_local_t *local;
+
+    if ((local = pthread_getspecific(minter->key))) {
+        return local;
+    }
+
+    if (!(local = sqids_mem_alloc(sizeof(sqids_minter_local_t)))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    local->nums = sqids_mem_alloc(minter->block * sizeof(unsigned long long));
+    local->ids = sqids_mem_alloc(minter->block * minter->stride);
+
+    if (!local->nums || !local->ids) {
+        if (local->nums) {
+            sqids_mem_free(local->nums);
+        }
+
+        if (local->ids) {
+            sqids_mem_free(local->ids);
+        }
+
+        sqids_mem_free(local);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    local->minter = minter;
+    local->pos = 0;
+    local->cnt = 0;
+
+    if (pthread_setspecific(minter->key, local) != 0) {
+        sqids_minter_local_free(local);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    pthread_mutex_lock(&minter->lock);
+    local->prev = NULL;
+    local->next = minter->locals;
+    if (minter->locals) {
+        minter->locals->prev = local;
+    }
+    minter->locals = local;
+    pthread_mutex_unlock(&minter->lock);
+
+    return local;
+}
+
+/* reserve the next block with a single atomic and encode all of it */
+static int
+sqids_minter_refill(sqids_minter_t *minter, sqids_minter_local_t *local)
+{
+    unsigned long long idx, cnt, i;
+
+    idx = __atomic_fetch_add(&minter->block_next, 1, __ATOMIC_RELAXED);
+
+    if (idx >= minter->block_max) {
+        sqids_errno = SQIDS_ERR_OVERFLOW;
+        return -1;
+    }
+
+    local->begin = minter->start + idx * minter->block;
+
+    /* the last block may be short */
+    cnt = 0xFFFFFFFFFFFFFFFFull - local->begin;
+    cnt = cnt < minter->block - 1 ? cnt + 1 : minter->block;
+
+    for (i = 0; i < cnt; ++i) {
+        local->nums[i] = local->begin + i;
+    }
+
+    if (sqids_encode_batch(minter->sqids, cnt, local->nums, local->ids,
+        minter->stride) != 0) {
+        return -1;
+    }
+
+    local->pos = 0;
+    local->cnt = cnt;
+
+    return 0;
+}
+
+/* allocate a new minter */
+sqids_minter_t *
+sqids_minter_new(sqids_t *sqids, unsigned long long start, unsigned int block)
+{
+    sqids_minter_t *result;
+    unsigned long long max = 0xFFFFFFFFFFFFFFFFull;
+    size_t stride = sqids_encoded_len(sqids, 1, &max) + 1;
+
+    if (!block) {
+        block = SQIDS_MINTER_BLOCK;
+    }
+
+    /* a thread's buffers have to fit the allocator's size */
+    if ((unsigned long long)block * stride > 0xFFFFFFFFull ||
+        (unsigned long long)block * sizeof(unsigned long long) >
+        0xFFFFFFFFull) {
+        sqids_errno = SQIDS_ERR_OVERFLOW;
+        return NULL;
+    }
+
+    if (!(result = sqids_mem_alloc(sizeof(sqids_minter_t)))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    if (pthread_key_create(&result->key, sqids_minter_local_destroy) != 0) {
+        sqids_mem_free(result);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    result->block = block;
+    result->start = start;
+    result->block_next = 0;
+    result->block_max = (max - start) / result->block;
+    if (result->block_max < max) {
+        ++result->block_max;
+    }
+    result->stride = stride;
+    result->sqids = sqids_ref(sqids);
+    result->locals = NULL;
+    pthread_mutex_init(&result->lock, NULL);
+
+    return result;
+}
+
+/* free a minter, along with the state of every thread that used it */
+void
+sqids_minter_free(sqids_minter_t *minter)
+{
+    sqids_minter_local_t *local, *next;
+
+    pthread_key_delete(minter->key);
+
+    for (local = minter->locals; local; local = next) {
+        next = local->next;
+        sqids_minter_local_free(local);
+    }
+
+    pthread_mutex_destroy(&minter->lock);
+    sqids_free(minter->sqids);
+    sqids_mem_free(minter);
+}
+
+/* hand out the next id */
+const char *
+sqids_minter_next(sqids_minter_t *minter, unsigned long long *seq)
+{
+    sqids_minter_local_t *local;
+
+    if (!(local = sqids_minter_local(minter))) {
+        return NULL;
+    }
+
+    if (local->pos == local->cnt && sqids_minter_refill(minter, local) != 0) {
+        return NULL;
+    }
+
+    if (seq) {
+        *seq = local->begin + local->pos;
+    }
+
+    return local->ids + local->pos++ * minter->stride;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
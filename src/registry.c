@@ -0,0 +1,443 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ registry stuff                                                        */
+/*****************************************************************************/
+
+/* registry entry */
+struct sqids_registry_entry_s {
+    char *alphabet;
+    unsigned int min_len;
+    unsigned int bl_id;
+    unsigned int hash;
+    size_t size;
+    sqids_t *sqids;                             /* NULL while building */
+    unsigned int stale;                 /* blocklist replaced while building */
+    struct sqids_registry_entry_s *chain;       /* hash bucket chain */
+    struct sqids_registry_entry_s *prev;        /* LRU list, head is hot */
+    struct sqids_registry_entry_s *next;
+};
+typedef struct sqids_registry_entry_s sqids_registry_entry_t;
+
+/* registered blocklist */
+struct sqids_registry_bl_s {
+    unsigned int id;
+    sqids_bl_t *bl;
+};
+typedef struct sqids_registry_bl_s sqids_registry_bl_t;
+
+/* registry */
+struct sqids_registry_s {
+    pthread_mutex_t lock;
+    pthread_cond_t built;
+    size_t mem;
+    size_t mem_max;
+    unsigned int cnt;
+    unsigned int bucket_cnt;
+    sqids_registry_entry_t **buckets;
+    sqids_registry_entry_t *head;
+    sqids_registry_entry_t *tail;
+    unsigned int bl_cnt;
+    sqids_registry_bl_t *bls;
+};
+
+/* FNV-1a over the key */
+static inline unsigned int
+sqids_registry_hash(const char *alphabet, unsigned int min_len,
+    unsigned int bl_id)
+{
+    unsigned int result = 2166136261u;
+
+    for (; *alphabet; ++alphabet) {
+        result = (result ^ (unsigned char)*alphabet) * 16777619u;
+    }
+
+    result = (result ^ min_len) * 16777619u;
+    result = (result ^ bl_id) * 16777619u;
+
+    return result;
+}
+
+/* unlink an entry from the LRU list */
+static inline void
+sqids_registry_lru_unlink(sqids_registry_t *reg, sqids_registry_entry_t *entry)
+{
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        reg->head = entry->next;
+    }
+
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        reg->tail = entry->prev;
+    }
+}
+
+/* link an entry at the hot end of the LRU list */
+static inline void
+sqids_registry_lru_link(sqids_registry_t *reg, sqids_registry_entry_t *entry)
+{
+    entry->prev = NULL;
+    entry->next = reg->head;
+
+    if (reg->head) {
+        reg->head->prev = entry;
+    } else {
+        reg->tail = entry;
+    }
+
+    reg->head = entry;
+}
+
+/* remove an entry from the registry and free it */
+static void
+sqids_registry_remove(sqids_registry_t *reg, sqids_registry_entry_t *entry)
+{
+    sqids_registry_entry_t **pp;
+
+    pp = &reg->buckets[entry->hash & (reg->bucket_cnt - 1)];
+    for (; *pp != entry; pp = &(*pp)->chain) {}
+    *pp = entry->chain;
+
+    sqids_registry_lru_unlink(reg, entry);
+    reg->mem -= entry->size;
+    --reg->cnt;
+
+    /* handles given out keep the structure alive */
+    if (entry->sqids) {
+        sqids_free(entry->sqids);
+    }
+
+    sqids_mem_free(entry->alphabet);
+    sqids_mem_free(entry);
+}
+
+/* double the bucket count once the table gets crowded */
+static void
+sqids_registry_grow(sqids_registry_t *reg)
+{
+    sqids_registry_entry_t **buckets, *iter, *next;
+    unsigned int i, cnt = reg->bucket_cnt * 2;
+
+    /* a crowded table is slower, but still correct */
+    if (!(buckets = sqids_mem_alloc(cnt * sizeof(*buckets)))) {
+        return;
+    }
+
+    memset(buckets, 0, cnt * sizeof(*buckets));
+
+    for (i = 0; i < reg->bucket_cnt; ++i) {
+        for (iter = reg->buckets[i]; iter; iter = next) {
+            next = iter->chain;
+            iter->chain = buckets[iter->hash & (cnt - 1)];
+            buckets[iter->hash & (cnt - 1)] = iter;
+        }
+    }
+
+    sqids_mem_free(reg->buckets);
+    reg->buckets = buckets;
+    reg->bucket_cnt = cnt;
+}
+
+/* evict cold entries until the registry fits its budget */
+static void
+sqids_registry_evict(sqids_registry_t *reg)
+{
+    sqids_registry_entry_t *iter, *prev;
+
+    if (!reg->mem_max) {
+        return;
+    }
+
+    for (iter = reg->tail; iter && reg->mem > reg->mem_max; iter = prev) {
+        prev = iter->prev;
+
+        /* never evict entries still being built */
+        if (iter->sqids) {
+            sqids_registry_remove(reg, iter);
+        }
+    }
+}
+
+/* find a registered blocklist */
+static inline sqids_registry_bl_t *
+sqids_registry_bl_find(sqids_registry_t *reg, unsigned int id)
+{
+    unsigned int i;
+
+    for (i = 0; i < reg->bl_cnt; ++i) {
+        if (reg->bls[i].id == id) {
+            return &reg->bls[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* allocate a new registry */
+sqids_registry_t *
+sqids_registry_new(size_t mem_max)
+{
+    sqids_registry_t *result;
+
+    if (!(result = sqids_mem_alloc(sizeof(sqids_registry_t)))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    result->bucket_cnt = 64;
+    if (!(result->buckets = sqids_mem_alloc(result->bucket_cnt *
+        sizeof(*result->buckets)))) {
+        sqids_mem_free(result);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    memset(result->buckets, 0, result->bucket_cnt * sizeof(*result->buckets));
+    pthread_mutex_init(&result->lock, NULL);
+    pthread_cond_init(&result->built, NULL);
+    result->mem = 0;
+    result->mem_max = mem_max;
+    result->cnt = 0;
+    result->head = NULL;
+    result->tail = NULL;
+    result->bl_cnt = 0;
+    result->bls = NULL;
+
+    return result;
+}
+
+/* free a registry */
+void
+sqids_registry_free(sqids_registry_t *reg)
+{
+    unsigned int i;
+
+    while (reg->head) {
+        sqids_registry_remove(reg, reg->head);
+    }
+
+    for (i = 0; i < reg->bl_cnt; ++i) {
+        sqids_bl_free(reg->bls[i].bl);
+    }
+
+    if (reg->bls) {
+        sqids_mem_free(reg->bls);
+    }
+
+    pthread_cond_destroy(&reg->built);
+    pthread_mutex_destroy(&reg->lock);
+    sqids_mem_free(reg->buckets);
+    sqids_mem_free(reg);
+}
+
+/* register a blocklist under an id */
+int
+sqids_registry_bl_set(sqids_registry_t *reg, unsigned int id, sqids_bl_t *bl)
+{
+    sqids_registry_entry_t *iter, *next;
+    sqids_registry_bl_t *slot, *bls;
+
+    /* reserved for "no blocklist" */
+    if (!id) {
+        sqids_errno = SQIDS_ERR_INVALID;
+        return -1;
+    }
+
+    pthread_mutex_lock(&reg->lock);
+
+    if ((slot = sqids_registry_bl_find(reg, id))) {
+        sqids_bl_free(slot->bl);
+        slot->bl = bl;
+
+        /* drop structures built with the old list, and have the ones
+           being built with it start over */
+        for (iter = reg->head; iter; iter = next) {
+            next = iter->next;
+
+            if (iter->bl_id != id) {
+                continue;
+            }
+
+            if (iter->sqids) {
+                sqids_registry_remove(reg, iter);
+            } else {
+                iter->stale = 1;
+            }
+        }
+    } else {
+        if (!(bls = sqids_mem_alloc((reg->bl_cnt + 1) * sizeof(*bls)))) {
+            pthread_mutex_unlock(&reg->lock);
+            sqids_errno = SQIDS_ERR_ALLOC;
+            return -1;
+        }
+
+        if (reg->bls) {
+            memcpy(bls, reg->bls, reg->bl_cnt * sizeof(*bls));
+            sqids_mem_free(reg->bls);
+        }
+
+        bls[reg->bl_cnt].id = id;
+        bls[reg->bl_cnt].bl = bl;
+        reg->bls = bls;
+        ++reg->bl_cnt;
+    }
+
+    pthread_mutex_unlock(&reg->lock);
+
+    return 0;
+}
+
+/* get a shared sqids structure, building it on first use */
+sqids_t *
+sqids_registry_get(sqids_registry_t *reg, const char *alphabet,
+    unsigned int min_len, unsigned int bl_id)
+{
+    sqids_registry_entry_t *entry;
+    sqids_registry_bl_t *slot;
+    sqids_bl_t *bl;
+    sqids_t *result;
+    unsigned int hash;
+    size_t size;
+    int len;
+
+    if (!alphabet) {
+        alphabet = SQIDS_DEFAULT_ALPHABET;
+    }
+
+    hash = sqids_registry_hash(alphabet, min_len, bl_id);
+
+    pthread_mutex_lock(&reg->lock);
+
+    for (;;) {
+        for (entry = reg->buckets[hash & (reg->bucket_cnt - 1)]; entry;
+            entry = entry->chain) {
+            if (entry->hash == hash && entry->min_len == min_len &&
+                entry->bl_id == bl_id &&
+                strcmp(entry->alphabet, alphabet) == 0) {
+                break;
+            }
+        }
+
+        if (!entry) {
+            break;
+        }
+
+        /* somebody else is building it - wait and look again */
+        if (!entry->sqids) {
+            pthread_cond_wait(&reg->built, &reg->lock);
+            continue;
+        }
+
+        /* hit - move to the hot end */
+        sqids_registry_lru_unlink(reg, entry);
+        sqids_registry_lru_link(reg, entry);
+        result = sqids_ref(entry->sqids);
+
+        pthread_mutex_unlock(&reg->lock);
+
+        return result;
+    }
+
+    /* miss - prepare a placeholder entry */
+    len = strlen(alphabet);
+    if (!(entry = sqids_mem_alloc(sizeof(sqids_registry_entry_t)))) {
+        pthread_mutex_unlock(&reg->lock);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    if (!(entry->alphabet = sqids_mem_alloc(len + 1))) {
+        pthread_mutex_unlock(&reg->lock);
+        sqids_mem_free(entry);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    /* resolve the blocklist */
+    bl = NULL;
+    if (bl_id) {
+        if (!(slot = sqids_registry_bl_find(reg, bl_id))) {
+            pthread_mutex_unlock(&reg->lock);
+            sqids_mem_free(entry->alphabet);
+            sqids_mem_free(entry);
+            sqids_errno = SQIDS_ERR_NOENT;
+            return NULL;
+        }
+
+        bl = sqids_bl_ref(slot->bl);
+    }
+
+    memcpy(entry->alphabet, alphabet, len + 1);
+    entry->min_len = min_len;
+    entry->bl_id = bl_id;
+    entry->hash = hash;
+    entry->size = sizeof(sqids_registry_entry_t) + sizeof(sqids_t) +
+        2 * (len + 1);
+    entry->sqids = NULL;
+    entry->stale = 0;
+
+    /* publish it so concurrent lookups wait for us */
+    if (reg->cnt >= reg->bucket_cnt) {
+        sqids_registry_grow(reg);
+    }
+
+    entry->chain = reg->buckets[hash & (reg->bucket_cnt - 1)];
+    reg->buckets[hash & (reg->bucket_cnt - 1)] = entry;
+    sqids_registry_lru_link(reg, entry);
+    reg->mem += entry->size;
+    ++reg->cnt;
+
+    /* build outside the lock */
+    pthread_mutex_unlock(&reg->lock);
+    result = sqids_new(alphabet, min_len, bl);
+    pthread_mutex_lock(&reg->lock);
+
+    /* the blocklist was replaced meanwhile - waiters look again and we start
+       over with the new one */
+    if (result && entry->stale) {
+        sqids_registry_remove(reg, entry);
+        sqids_free(result);
+        pthread_cond_broadcast(&reg->built);
+        pthread_mutex_unlock(&reg->lock);
+
+        return sqids_registry_get(reg, alphabet, min_len, bl_id);
+    }
+
+    if (result) {
+        /* account for the padding tables and the pruned blocklist, now
+           that they're known */
+        size = (size_t)result->pad_depth * result->len * result->min_len +
+            result->bl_view_size;
+        entry->size += size;
+        reg->mem += size;
+
+        entry->sqids = sqids_ref(result);
+        sqids_registry_evict(reg);
+    } else {
+        if (bl) {
+            sqids_bl_free(bl);
+        }
+
+        sqids_registry_remove(reg, entry);
+    }
+
+    pthread_cond_broadcast(&reg->built);
+    pthread_mutex_unlock(&reg->lock);
+
+    return result;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
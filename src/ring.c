@@ -0,0 +1,514 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* memfd_create */
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ ring stuff                                                            */
+/*****************************************************************************/
+
+#define SQIDS_RING_MAGIC    "SQIDSRN"
+#define SQIDS_RING_VERSION  1
+
+#define SQIDS_RING_ENCODE   1
+#define SQIDS_RING_DECODE   2
+
+/* result states, the futex word of a waiting client */
+#define SQIDS_RING_PENDING  0
+#define SQIDS_RING_DONE     1
+#define SQIDS_RING_WAITING  2
+
+/* shared header, the positions one cache line apart */
+struct sqids_ring_hdr_s {
+    char magic[8];
+    uint32_t version;
+    uint32_t slots;
+    uint64_t size;
+    uint32_t head __attribute__((aligned(64)));     /* next to enqueue */
+    uint32_t tail __attribute__((aligned(64)));     /* next to serve */
+    uint32_t sleeping;                              /* the server is */
+    uint32_t bell;                                  /* and waits on this */
+    uint32_t stop;
+} __attribute__((aligned(64)));
+typedef struct sqids_ring_hdr_s sqids_ring_hdr_t;
+
+/* one request and its result, 256 bytes */
+struct sqids_ring_slot_s {
+    uint32_t seq;       /* lap marker: free at `pos`, filled at `pos + 1` */
+    uint32_t state;
+    uint32_t op;
+    uint32_t num_cnt;
+    int32_t result;     /* id length or number count, -sqids_errno on errors */
+    uint32_t len;
+    uint64_t nums[SQIDS_RING_NUMS];
+    char id[SQIDS_RING_ID_MAX + 1];
+} __attribute__((aligned(64)));
+typedef struct sqids_ring_slot_s sqids_ring_slot_t;
+
+/* a mapping of the ring, private to a process */
+struct sqids_ring_s {
+    sqids_ring_hdr_t *hdr;
+    sqids_ring_slot_t *slots;
+    uint32_t mask;
+    unsigned int spin;
+    int fd;
+};
+
+static inline long
+sqids_ring_futex(uint32_t *addr, int op, uint32_t val)
+{
+    return syscall(SYS_futex, addr, op, val, NULL, NULL, 0);
+}
+
+static inline void
+sqids_ring_pause(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/* map a ring file */
+static sqids_ring_t *
+sqids_ring_map(int fd, size_t size)
+{
+    sqids_ring_t *result;
+    void *map;
+
+    if (!(result = sqids_mem_alloc(sizeof(sqids_ring_t)))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    if ((map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) ==
+        MAP_FAILED) {
+        sqids_mem_free(result);
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    result->hdr = map;
+    result->slots = (sqids_ring_slot_t *)(result->hdr + 1);
+    result->spin = 1024;
+    result->fd = fd;
+
+    return result;
+}
+
+/* create a ring in a new memfd */
+sqids_ring_t *
+sqids_ring_new(unsigned int slots)
+{
+    sqids_ring_t *result;
+    size_t size;
+    unsigned int i;
+    int fd;
+
+    /* a power of two, so positions wrap cleanly */
+    if (slots < 2 || slots > (1u << 20) || (slots & (slots - 1))) {
+        sqids_errno = SQIDS_ERR_INVALID;
+        return NULL;
+    }
+
+    size = sizeof(sqids_ring_hdr_t) + slots * sizeof(sqids_ring_slot_t);
+    if ((fd = memfd_create("sqids-ring", MFD_CLOEXEC)) < 0) {
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    if (!(result = sqids_ring_map(fd, size))) {
+        close(fd);
+        return NULL;
+    }
+
+    /* the file starts zeroed */
+    memcpy(result->hdr->magic, SQIDS_RING_MAGIC, sizeof(SQIDS_RING_MAGIC));
+    result->hdr->version = SQIDS_RING_VERSION;
+    result->hdr->slots = slots;
+    result->hdr->size = size;
+    for (i = 0; i < slots; ++i) {
+        result->slots[i].seq = i;
+    }
+    result->mask = slots - 1;
+
+    return result;
+}
+
+/* map a ring another process created */
+sqids_ring_t *
+sqids_ring_open(int fd)
+{
+    sqids_ring_hdr_t hdr;
+    sqids_ring_t *result;
+    struct stat st;
+    ssize_t n;
+
+    if ((fd = dup(fd)) < 0) {
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0 || (n = pread(fd, &hdr, sizeof(hdr), 0)) < 0) {
+        close(fd);
+        sqids_errno = SQIDS_ERR_IO;
+        return NULL;
+    }
+
+    if (n != sizeof(hdr) || memcmp(hdr.magic, SQIDS_RING_MAGIC, sizeof(SQIDS_RING_MAGIC)) != 0 ||
+        hdr.version != SQIDS_RING_VERSION || hdr.slots < 2 ||
+        hdr.slots > (1u << 20) || (hdr.slots & (hdr.slots - 1)) ||
+        hdr.size != sizeof(sqids_ring_hdr_t) +
+        hdr.slots * sizeof(sqids_ring_slot_t) ||
+        (uint64_t)st.st_size != hdr.size) {
+        close(fd);
+        sqids_errno = SQIDS_ERR_FORMAT;
+        return NULL;
+    }
+
+    if (!(result = sqids_ring_map(fd, hdr.size))) {
+        close(fd);
+        return NULL;
+    }
+
+    result->mask = hdr.slots - 1;
+
+    return result;
+}
+
+/* the file descriptor, to pass on to other processes */
+int
+sqids_ring_fd(sqids_ring_t *ring)
+{
+    return ring->fd;
+}
+
+/* spin this many times before sleeping */
+void
+sqids_ring_spin(sqids_ring_t *ring, unsigned int spin)
+{
+    ring->spin = spin;
+}
+
+/* unmap a ring */
+void
+sqids_ring_free(sqids_ring_t *ring)
+{
+    munmap(ring->hdr, sizeof(sqids_ring_hdr_t) +
+        (ring->mask + 1) * sizeof(sqids_ring_slot_t));
+    close(ring->fd);
+    sqids_mem_free(ring);
+}
+
+/* claim the slot of the next position, giving up while the ring is full -
+   the oldest result may belong to the caller itself */
+static sqids_ring_slot_t *
+sqids_ring_claim(sqids_ring_t *ring, uint32_t *pos)
+{
+    sqids_ring_slot_t *slot;
+    uint32_t p, seq;
+    unsigned int spins = 0;
+    int32_t diff;
+
+    p = __atomic_load_n(&ring->hdr->head, __ATOMIC_RELAXED);
+    for (;;) {
+        slot = &ring->slots[p & ring->mask];
+        seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        diff = (int32_t)(seq - p);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&ring->hdr->head, &p, p + 1, 1,
+                __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *pos = p;
+                return slot;
+            }
+            continue;
+        }
+
+        /* a lap behind: its result has not been collected yet */
+        if (diff < 0) {
+            if (++spins > ring->spin) {
+                sqids_errno = SQIDS_ERR_BUSY;
+                return NULL;
+            }
+            sqids_ring_pause();
+        }
+
+        p = __atomic_load_n(&ring->hdr->head, __ATOMIC_RELAXED);
+    }
+}
+
+/* hand a filled slot to the server */
+static long long
+sqids_ring_publish(sqids_ring_t *ring, sqids_ring_slot_t *slot, uint32_t pos)
+{
+    slot->state = SQIDS_RING_PENDING;
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&ring->hdr->sleeping, __ATOMIC_SEQ_CST)) {
+        __atomic_add_fetch(&ring->hdr->bell, 1, __ATOMIC_SEQ_CST);
+        sqids_ring_futex(&ring->hdr->bell, FUTEX_WAKE, 1);
+    }
+
+    return pos;
+}
+
+/* enqueue numbers to encode */
+long long
+sqids_ring_put_encode(sqids_ring_t *ring, unsigned int num_cnt,
+    const unsigned long long *nums)
+{
+    sqids_ring_slot_t *slot;
+    uint32_t pos;
+
+    if (num_cnt > SQIDS_RING_NUMS) {
+        sqids_errno = SQIDS_ERR_NOSPACE;
+        return -1;
+    }
+
+    if (!(slot = sqids_ring_claim(ring, &pos))) {
+        return -1;
+    }
+
+    slot->op = SQIDS_RING_ENCODE;
+    slot->num_cnt = num_cnt;
+    memcpy(slot->nums, nums, num_cnt * sizeof(uint64_t));
+
+    return sqids_ring_publish(ring, slot, pos);
+}
+
+/* enqueue an id to decode */
+long long
+sqids_ring_put_decode(sqids_ring_t *ring, const char *s, size_t len)
+{
+    sqids_ring_slot_t *slot;
+    uint32_t pos;
+
+    if (len > SQIDS_RING_ID_MAX) {
+        sqids_errno = SQIDS_ERR_NOSPACE;
+        return -1;
+    }
+
+    if (!(slot = sqids_ring_claim(ring, &pos))) {
+        return -1;
+    }
+
+    slot->op = SQIDS_RING_DECODE;
+    slot->len = len;
+    memcpy(slot->id, s, len);
+
+    return sqids_ring_publish(ring, slot, pos);
+}
+
+/* wait for the result of a ticket */
+static sqids_ring_slot_t *
+sqids_ring_wait(sqids_ring_t *ring, long long ticket)
+{
+    sqids_ring_slot_t *slot = &ring->slots[(uint32_t)ticket & ring->mask];
+    uint32_t state = SQIDS_RING_PENDING;
+    unsigned int spins;
+
+    if (ticket < 0 || __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) !=
+        (uint32_t)ticket + 1) {
+        sqids_errno = SQIDS_ERR_INVALID;
+        return NULL;
+    }
+
+    for (spins = 0; spins < ring->spin; ++spins) {
+        if (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) ==
+            SQIDS_RING_DONE) {
+            return slot;
+        }
+        sqids_ring_pause();
+    }
+
+    /* tell the server to wake us */
+    if (__atomic_compare_exchange_n(&slot->state, &state, SQIDS_RING_WAITING,
+        0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) || state ==
+        SQIDS_RING_WAITING) {
+        while (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) !=
+            SQIDS_RING_DONE) {
+            sqids_ring_futex(&slot->state, FUTEX_WAIT, SQIDS_RING_WAITING);
+        }
+    }
+
+    return slot;
+}
+
+/* free a slot for the next lap */
+static void
+sqids_ring_release(sqids_ring_t *ring, sqids_ring_slot_t *slot,
+    long long ticket)
+{
+    __atomic_store_n(&slot->seq, (uint32_t)ticket + ring->mask + 1,
+        __ATOMIC_RELEASE);
+}
+
+/* collect an encoded id */
+int
+sqids_ring_get_encode(sqids_ring_t *ring, long long ticket, char *s,
+    size_t n)
+{
+    sqids_ring_slot_t *slot;
+    int result;
+
+    if (!(slot = sqids_ring_wait(ring, ticket))) {
+        return -1;
+    }
+
+    if ((result = slot->result) >= 0) {
+        if ((size_t)result + 1 > n) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            result = -1;
+        } else {
+            memcpy(s, slot->id, result);
+            s[result] = 0;
+        }
+    } else {
+        sqids_errno = -result;
+        result = -1;
+    }
+
+    sqids_ring_release(ring, slot, ticket);
+
+    return result;
+}
+
+/* collect decoded numbers */
+int
+sqids_ring_get_decode(sqids_ring_t *ring, long long ticket,
+    unsigned long long *nums, unsigned int n)
+{
+    sqids_ring_slot_t *slot;
+    int result;
+
+    if (!(slot = sqids_ring_wait(ring, ticket))) {
+        return -1;
+    }
+
+    if ((result = slot->result) >= 0) {
+        if ((unsigned int)result > n) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            result = -1;
+        } else {
+            memcpy(nums, slot->nums, result * sizeof(uint64_t));
+        }
+    } else {
+        sqids_errno = -result;
+        result = -1;
+    }
+
+    sqids_ring_release(ring, slot, ticket);
+
+    return result;
+}
+
+/* answer one request in place, trusting nothing the peer wrote */
+static void
+sqids_ring_answer(sqids_t *sqids, sqids_ring_slot_t *slot)
+{
+    unsigned long long nums[SQIDS_RING_ID_MAX / 2 + 1];
+    uint32_t op = slot->op, cnt = slot->num_cnt, len = slot->len;
+    int r = -1;
+
+    if (op == SQIDS_RING_ENCODE && cnt <= SQIDS_RING_NUMS) {
+        memcpy(nums, slot->nums, cnt * sizeof(uint64_t));
+        if (sqids_encoded_len(sqids, cnt, nums) > SQIDS_RING_ID_MAX) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+        } else {
+            r = sqids_encode_buf(sqids, slot->id, cnt, nums);
+        }
+    } else if (op == SQIDS_RING_DECODE && len <= SQIDS_RING_ID_MAX) {
+        r = sqids_decode_len(sqids, slot->id, len, nums, len / 2 + 1);
+        if (r > SQIDS_RING_NUMS) {
+            sqids_errno = SQIDS_ERR_NOSPACE;
+            r = -1;
+        } else if (r > 0) {
+            memcpy(slot->nums, nums, r * sizeof(uint64_t));
+        }
+    } else {
+        sqids_errno = SQIDS_ERR_INVALID;
+    }
+
+    slot->result = r < 0 ? -sqids_errno : r;
+}
+
+/* serve requests until stopped */
+int
+sqids_ring_serve(sqids_ring_t *ring, sqids_t *sqids)
+{
+    sqids_ring_hdr_t *hdr = ring->hdr;
+    sqids_ring_slot_t *slot;
+    uint32_t pos = __atomic_load_n(&hdr->tail, __ATOMIC_ACQUIRE), seq, bell;
+    unsigned int spins = 0;
+
+    while (!__atomic_load_n(&hdr->stop, __ATOMIC_ACQUIRE)) {
+        slot = &ring->slots[pos & ring->mask];
+        seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if (seq != pos + 1) {
+            if (++spins < ring->spin) {
+                sqids_ring_pause();
+                continue;
+            }
+
+            /* announce the nap, then look once more before taking it - a
+               ring after the bell was read makes the wait return at once */
+            bell = __atomic_load_n(&hdr->bell, __ATOMIC_SEQ_CST);
+            __atomic_store_n(&hdr->sleeping, 1, __ATOMIC_SEQ_CST);
+            seq = __atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST);
+            if (seq != pos + 1 && !__atomic_load_n(&hdr->stop,
+                __ATOMIC_SEQ_CST)) {
+                sqids_ring_futex(&hdr->bell, FUTEX_WAIT, bell);
+            }
+            __atomic_store_n(&hdr->sleeping, 0, __ATOMIC_RELAXED);
+            spins = 0;
+            continue;
+        }
+
+        sqids_ring_answer(sqids, slot);
+
+        if (__atomic_exchange_n(&slot->state, SQIDS_RING_DONE,
+            __ATOMIC_ACQ_REL) == SQIDS_RING_WAITING) {
+            sqids_ring_futex(&slot->state, FUTEX_WAKE, INT_MAX);
+        }
+
+        __atomic_store_n(&hdr->tail, ++pos, __ATOMIC_RELEASE);
+        spins = 0;
+    }
+
+    return 0;
+}
+
+/* make `sqids_ring_serve` return */
+void
+sqids_ring_stop(sqids_ring_t *ring)
+{
+    sqids_ring_hdr_t *hdr = ring->hdr;
+
+    __atomic_store_n(&hdr->stop, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&hdr->bell, 1, __ATOMIC_SEQ_CST);
+    sqids_ring_futex(&hdr->bell, FUTEX_WAKE, INT_MAX);
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
@@ -0,0 +1,230 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define SQIDS_SCAN_X86 1
+#endif
+
+#include "sqids.h"
+
+/*****************************************************************************/
+/* {{{ scan stuff                                                            */
+/*****************************************************************************/
+
+/* alphabet membership, as a bitmap and as nibble tables */
+struct sqids_scan_class_s {
+    uint8_t member[256];
+    uint8_t lo_clear[16];   /* bit `hi` of [lo]: (hi << 4 | lo) is a member */
+    uint8_t lo_set[16];     /* the same, for bytes with the top bit set */
+};
+typedef struct sqids_scan_class_s sqids_scan_class_t;
+
+/* classify `n` bytes, setting bit i of the result when s[i] is a member */
+typedef uint64_t (*sqids_scan_classify_t)(const sqids_scan_class_t *,
+    const char *, size_t);
+
+/* build the classifier */
+static void
+sqids_scan_class_init(sqids_scan_class_t *cls, sqids_t *sqids)
+{
+    unsigned int i;
+    unsigned char c;
+
+    memset(cls, 0, sizeof(sqids_scan_class_t));
+
+    for (i = 0; i < sqids->len; ++i) {
+        c = sqids->alphabet[i];
+        cls->member[c] = 1;
+
+        if (c & 0x80) {
+            cls->lo_set[c & 0x0F] |= 1 << ((c >> 4) & 0x07);
+        } else {
+            cls->lo_clear[c & 0x0F] |= 1 << (c >> 4);
+        }
+    }
+}
+
+/* scalar classifier */
+static uint64_t
+sqids_scan_classify_scalar(const sqids_scan_class_t *cls, const char *s,
+    size_t n)
+{
+    uint64_t result = 0;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        result |= (uint64_t)cls->member[(unsigned char)s[i]] << i;
+    }
+
+    return result;
+}
+
+#ifdef SQIDS_SCAN_X86
+
+/* AVX2 classifier: two nibble lookups per byte, 64 bytes at a time */
+__attribute__((target("avx2")))
+static uint64_t
+sqids_scan_classify_avx2(const sqids_scan_class_t *cls, const char *s,
+    size_t n)
+{
+    __m256i lo_clear, lo_set, bits, top, nib, v, t, hi;
+    uint64_t result;
+    int i;
+
+    if (n < 64) {
+        return sqids_scan_classify_scalar(cls, s, n);
+    }
+
+    lo_clear = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        (const __m128i *)cls->lo_clear));
+    lo_set = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        (const __m128i *)cls->lo_set));
+    bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32,
+        64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    top = _mm256_set1_epi8(-128);
+    nib = _mm256_set1_epi8(0x07);
+
+    for (i = 0, result = 0; i < 2; ++i) {
+        v = _mm256_loadu_si256((const __m256i *)(s + i * 32));
+
+        /* pshufb zeroes lanes with the top bit set, so each table only
+           answers for its half of the byte range */
+        t = _mm256_or_si256(_mm256_shuffle_epi8(lo_clear, v),
+            _mm256_shuffle_epi8(lo_set, _mm256_xor_si256(v, top)));
+        hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nib);
+        t = _mm256_and_si256(t, _mm256_shuffle_epi8(bits, hi));
+
+        result |= (uint64_t)(uint32_t)~_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(t, _mm256_setzero_si256())) << (i * 32);
+    }
+
+    return result;
+}
+
+#endif
+
+/* pick the widest classifier the cpu supports */
+static sqids_scan_classify_t
+sqids_scan_classifier(void)
+{
+#ifdef SQIDS_SCAN_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return sqids_scan_classify_avx2;
+    }
+#endif
+
+    return sqids_scan_classify_scalar;
+}
+
+/* decode a run and report it */
+static int
+sqids_scan_run(sqids_t *sqids, const char *buf, size_t begin, size_t end,
+    int flags, int (*callback)(const sqids_match_t *, void *), void *arg,
+    int *cnt)
+{
+    size_t n = end - begin;
+    unsigned long long nums[n / 2 + 1];
+    sqids_match_t match;
+    int num_cnt;
+
+    if (flags & SQIDS_SCAN_CANONICAL) {
+        num_cnt = sqids_decode_canonical(sqids, buf + begin, n, nums,
+            n / 2 + 1);
+    } else {
+        num_cnt = sqids_decode_len(sqids, buf + begin, n, nums, n / 2 + 1);
+    }
+
+    if (num_cnt <= 0) {
+        return 0;
+    }
+
+    match.offset = begin;
+    match.len = n;
+    match.nums = nums;
+    match.num_cnt = num_cnt;
+    ++*cnt;
+
+    return callback(&match, arg);
+}
+
+/* find, decode and report ids embedded in a buffer */
+int
+sqids_scan(sqids_t *sqids, const char *buf, size_t len, size_t min_len,
+    size_t max_len, int flags, int (*callback)(const sqids_match_t *, void *),
+    void *arg)
+{
+    static sqids_scan_classify_t classify;
+    sqids_scan_classify_t fn;
+    sqids_scan_class_t cls;
+    size_t pos, block, begin = 0, i;
+    uint64_t mask;
+    int cnt = 0, err, in_run = 0, bit, stop = 0;
+
+    if (!(fn = __atomic_load_n(&classify, __ATOMIC_RELAXED))) {
+        fn = sqids_scan_classifier();
+        __atomic_store_n(&classify, fn, __ATOMIC_RELAXED);
+    }
+
+    /* runs are decoded on the stack */
+    if (!max_len || max_len > SQIDS_CANONICAL_MAX) {
+        max_len = SQIDS_CANONICAL_MAX;
+    }
+
+    /* rejected candidates are not errors */
+    err = sqids_errno;
+    sqids_scan_class_init(&cls, sqids);
+
+    for (pos = 0; pos < len && !stop; pos += block) {
+        block = len - pos < 64 ? len - pos : 64;
+        mask = fn(&cls, buf + pos, block);
+
+        /* walk the run boundaries within the block */
+        for (i = 0; i < block && !stop;) {
+            if (in_run) {
+                /* next non-member ends the run */
+                bit = ~mask >> i ? __builtin_ctzll(~mask >> i) : 64;
+                if (i + bit >= block) {
+                    break;
+                }
+
+                i += bit;
+                in_run = 0;
+
+                if (pos + i - begin >= min_len && pos + i - begin <= max_len) {
+                    stop = sqids_scan_run(sqids, buf, begin, pos + i, flags,
+                        callback, arg, &cnt);
+                }
+            } else {
+                /* next member starts one */
+                if (!(mask >> i)) {
+                    break;
+                }
+
+                i += __builtin_ctzll(mask >> i);
+                in_run = 1;
+                begin = pos + i;
+            }
+        }
+    }
+
+    /* a run reaching the end of the buffer */
+    if (in_run && !stop && len - begin >= min_len && len - begin <= max_len) {
+        sqids_scan_run(sqids, buf, begin, len, flags, callback, arg, &cnt);
+    }
+
+    sqids_errno = err;
+
+    return cnt;
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
@@ -5,7 +5,17 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
-#include <math.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#if defined(SQIDS_INSTRUMENT) && SQIDS_INSTRUMENT == 1
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+#endif
 
 #include "sqids.h"
 
@@ -45,10 +55,97 @@ void (*sqids_mem_free)(void *) = sqids_mem_free_default;
 
 /* }}}                                                                       */
 
+/*****************************************************************************/
+/* {{{ instrumentation stuff                                                 */
+/*****************************************************************************/
+
+#if defined(SQIDS_INSTRUMENT) && SQIDS_INSTRUMENT == 1
+
+/* per-thread phase counters */
+TLS sqids_phase_stats_t __sqids_phases[SQIDS_PHASE_CNT];
+
+/* cheapest available clock */
+static inline unsigned long long
+sqids_phase_clock(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+#define SQIDS_PHASE_DECL(t) unsigned long long t
+#define SQIDS_PHASE_BEGIN(t) (t) = sqids_phase_clock()
+#define SQIDS_PHASE_END(phase, t) do { \
+        __sqids_phases[phase].cycles += sqids_phase_clock() - (t); \
+        ++__sqids_phases[phase].calls; \
+    } while (0)
+
+#else
+
+#define SQIDS_PHASE_DECL(t)
+#define SQIDS_PHASE_BEGIN(t) do {} while (0)
+#define SQIDS_PHASE_END(phase, t) do {} while (0)
+
+#endif
+
+/* snapshot the calling thread's phase counters */
+int
+sqids_phase_snapshot(sqids_phase_stats_t *stats)
+{
+#if defined(SQIDS_INSTRUMENT) && SQIDS_INSTRUMENT == 1
+    memcpy(stats, __sqids_phases, sizeof(__sqids_phases));
+
+    return 0;
+#else
+    memset(stats, 0, SQIDS_PHASE_CNT * sizeof(sqids_phase_stats_t));
+
+    return -1;
+#endif
+}
+
+/* reset the calling thread's phase counters */
+void
+sqids_phase_reset(void)
+{
+#if defined(SQIDS_INSTRUMENT) && SQIDS_INSTRUMENT == 1
+    memset(__sqids_phases, 0, sizeof(__sqids_phases));
+#endif
+}
+
+/* phase name */
+const char *
+sqids_phase_name(int phase)
+{
+    switch (phase) {
+        case SQIDS_PHASE_OFFSET:    return "offset";
+        case SQIDS_PHASE_ROTATE:    return "rotate";
+        case SQIDS_PHASE_DIGITS:    return "digits";
+        case SQIDS_PHASE_PADDING:   return "padding";
+        case SQIDS_PHASE_SHUFFLE:   return "shuffle";
+        case SQIDS_PHASE_BLOCKLIST: return "blocklist";
+        case SQIDS_PHASE_VALIDATE:  return "validate";
+        case SQIDS_PHASE_PARSE:     return "parse";
+        default: return "unknown";
+    }
+}
+
+/* }}}                                                                       */
+
 /*****************************************************************************/
 /* {{{ blocklist stuff                                                       */
 /*****************************************************************************/
 
+/* whether a node belongs to the words of a mapped file */
+#define sqids_bl_mapped(bl, node) \
+    ((bl)->nodes && (node) >= (bl)->nodes && \
+        (node) < (bl)->nodes + (bl)->node_cnt)
+
 /* allocate a new list */
 sqids_bl_t *
 sqids_bl_new(int (*match_func)(char *, char *))
@@ -66,17 +163,43 @@ sqids_bl_new(int (*match_func)(char *, char *))
 
     result->head = NULL;
     result->tail = NULL;
+    result->refcnt = 1;
+    result->frozen = 0;
+    result->map = NULL;
+    result->map_len = 0;
+    result->words = NULL;
+    result->pool = NULL;
+    result->nodes = NULL;
+    result->node_cnt = 0;
 
     return result;
 }
 
-/* free a list and all its data */
+/* take a new reference to a list */
+sqids_bl_t *
+sqids_bl_ref(sqids_bl_t *bl)
+{
+    __atomic_add_fetch(&bl->refcnt, 1, __ATOMIC_RELAXED);
+
+    return bl;
+}
+
+/* drop a reference to a list, free it and all its data with the last one */
 void
 sqids_bl_free(sqids_bl_t *bl)
 {
     sqids_bl_node_t *iter, *next;
 
+    if (__atomic_sub_fetch(&bl->refcnt, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+
     sqids_bl_foreach_safe(bl->head, iter, next) {
+        /* mapped words live in the file, their nodes in a single block */
+        if (sqids_bl_mapped(bl, iter)) {
+            continue;
+        }
+
         if (iter->s) {
             sqids_mem_free(iter->s);
         }
@@ -84,66 +207,100 @@ sqids_bl_free(sqids_bl_t *bl)
         sqids_mem_free(iter);
     }
 
+    if (bl->nodes) {
+        sqids_mem_free(bl->nodes);
+    }
+
+    if (bl->map) {
+        munmap(bl->map, bl->map_len);
+    }
+
     sqids_mem_free(bl);
 }
 
-#if !defined(SQIDS_DEFAULT_BLOCKLIST) || SQIDS_DEFAULT_BLOCKLIST == 0
-/* empty `de` blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* build a list out of the default words of the given languages */
+sqids_bl_t *
+sqids_bl_list_mask(unsigned int mask, int (*match_func)(char *, char *))
+{
+    sqids_bl_t *result;
+    sqids_bl_node_t *node;
+    const sqids_bl_word_t *word;
+
+    if (!(result = sqids_bl_new(match_func))) {
+        return NULL;
+    }
+
+    for (word = sqids_bl_words; word->s; ++word) {
+        if (!(word->mask & mask)) {
+            continue;
+        }
+
+        if (!(node = sqids_bl_add_tail(result, (char *)word->s))) {
+            sqids_bl_free(result);
+            return NULL;
+        }
+
+        node->mask = word->mask;
+    }
+
+    return result;
+}
+
+/* default `de` blocklist */
+sqids_bl_t *
 sqids_bl_list_de(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_DE, match_func);
 }
 
-/* empty `en` blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* default `en` blocklist */
+sqids_bl_t *
 sqids_bl_list_en(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_EN, match_func);
 }
 
-/* empty es` blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* default `es` blocklist */
+sqids_bl_t *
 sqids_bl_list_es(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_ES, match_func);
 }
 
-/* empty `fr` blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* default `fr` blocklist */
+sqids_bl_t *
 sqids_bl_list_fr(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_FR, match_func);
 }
 
-/* empty `hi` blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* default `hi` blocklist */
+sqids_bl_t *
 sqids_bl_list_hi(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_HI, match_func);
 }
 
-/* empty `it` blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* default `it` blocklist */
+sqids_bl_t *
 sqids_bl_list_it(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_IT, match_func);
 }
 
-/* empty `pt` blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* default `pt` blocklist */
+sqids_bl_t *
 sqids_bl_list_pt(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_PT, match_func);
 }
 
-/* empty combined blocklist when compiled with --disable-default-blocklist */
-sqids_bl_list_t *
+/* default combined blocklist */
+sqids_bl_t *
 sqids_bl_list_all(int (*match_func)(char *, char *))
 {
-    return sqids_bl_new(match_func);
+    return sqids_bl_list_mask(SQIDS_BL_ALL, match_func);
 }
-#endif
 
 /* add a string at the end of the list */
 sqids_bl_node_t *
@@ -152,6 +309,14 @@ sqids_bl_add_tail(sqids_bl_t *bl, char *s)
     sqids_bl_node_t *node;
     int len;
 
+    /* shared lists, and lists sqids structures were built with, are
+       immutable */
+    if (__atomic_load_n(&bl->refcnt, __ATOMIC_RELAXED) > 1 ||
+        __atomic_load_n(&bl->frozen, __ATOMIC_RELAXED)) {
+        sqids_errno = SQIDS_ERR_IMMUTABLE;
+        return NULL;
+    }
+
     if (!(node = sqids_mem_alloc(sizeof(sqids_bl_node_t)))) {
         sqids_errno = SQIDS_ERR_ALLOC;
         return NULL;
@@ -165,6 +330,7 @@ sqids_bl_add_tail(sqids_bl_t *bl, char *s)
     }
 
     memcpy(node->s, s, len + 1);
+    node->mask = ~0u;
     node->prev = bl->tail;
     node->next = NULL;
 
@@ -187,6 +353,14 @@ sqids_bl_add_head(sqids_bl_t *bl, char *s)
     sqids_bl_node_t *node;
     int len;
 
+    /* shared lists, and lists sqids structures were built with, are
+       immutable */
+    if (__atomic_load_n(&bl->refcnt, __ATOMIC_RELAXED) > 1 ||
+        __atomic_load_n(&bl->frozen, __ATOMIC_RELAXED)) {
+        sqids_errno = SQIDS_ERR_IMMUTABLE;
+        return NULL;
+    }
+
     if (!(node = sqids_mem_alloc(sizeof(sqids_bl_node_t)))) {
         sqids_errno = SQIDS_ERR_ALLOC;
         return NULL;
@@ -200,6 +374,7 @@ sqids_bl_add_head(sqids_bl_t *bl, char *s)
     }
 
     memcpy(node->s, s, len);
+    node->mask = ~0u;
     node->prev = NULL;
     node->next = bl->head;
 
@@ -215,6 +390,102 @@ sqids_bl_add_head(sqids_bl_t *bl, char *s)
     return node;
 }
 
+/* copy a list into a new, mutable one */
+sqids_bl_t *
+sqids_bl_dup(sqids_bl_t *bl)
+{
+    sqids_bl_t *result;
+    sqids_bl_node_t *iter, *node;
+
+    if (!(result = sqids_bl_new(bl->match_func))) {
+        return NULL;
+    }
+
+    sqids_bl_foreach(bl->head, iter) {
+        if (!(node = sqids_bl_add_tail(result, iter->s))) {
+            sqids_bl_free(result);
+            return NULL;
+        }
+
+        node->mask = iter->mask;
+    }
+
+    return result;
+}
+
+/* lazily built, process-wide default lists */
+struct sqids_bl_default_s {
+    const char *name;
+    sqids_bl_t *(*build)(int (*)(char *, char *));
+    pthread_once_t once;
+    sqids_bl_t *bl;
+};
+typedef struct sqids_bl_default_s sqids_bl_default_t;
+
+static sqids_bl_default_t sqids_bl_defaults[] = {
+    {"all", sqids_bl_list_all, PTHREAD_ONCE_INIT, NULL},
+    {"de", sqids_bl_list_de, PTHREAD_ONCE_INIT, NULL},
+    {"en", sqids_bl_list_en, PTHREAD_ONCE_INIT, NULL},
+    {"es", sqids_bl_list_es, PTHREAD_ONCE_INIT, NULL},
+    {"fr", sqids_bl_list_fr, PTHREAD_ONCE_INIT, NULL},
+    {"hi", sqids_bl_list_hi, PTHREAD_ONCE_INIT, NULL},
+    {"it", sqids_bl_list_it, PTHREAD_ONCE_INIT, NULL},
+    {"pt", sqids_bl_list_pt, PTHREAD_ONCE_INIT, NULL},
+};
+
+/* build a default list, keeping a reference forever so it stays immutable */
+#define SQIDS_BL_DEFAULT_INIT(i) \
+    static void \
+    sqids_bl_default_init_##i(void) \
+    { \
+        if ((sqids_bl_defaults[i].bl = sqids_bl_defaults[i].build(NULL))) { \
+            sqids_bl_ref(sqids_bl_defaults[i].bl); \
+        } \
+    }
+
+SQIDS_BL_DEFAULT_INIT(0)
+SQIDS_BL_DEFAULT_INIT(1)
+SQIDS_BL_DEFAULT_INIT(2)
+SQIDS_BL_DEFAULT_INIT(3)
+SQIDS_BL_DEFAULT_INIT(4)
+SQIDS_BL_DEFAULT_INIT(5)
+SQIDS_BL_DEFAULT_INIT(6)
+SQIDS_BL_DEFAULT_INIT(7)
+
+#undef SQIDS_BL_DEFAULT_INIT
+
+static void (*sqids_bl_default_inits[])(void) = {
+    sqids_bl_default_init_0, sqids_bl_default_init_1, sqids_bl_default_init_2,
+    sqids_bl_default_init_3, sqids_bl_default_init_4, sqids_bl_default_init_5,
+    sqids_bl_default_init_6, sqids_bl_default_init_7,
+};
+
+/* a shared default list, built on first use */
+sqids_bl_t *
+sqids_bl_default(const char *name)
+{
+    unsigned int i;
+
+    for (i = 0; i < sizeof(sqids_bl_defaults) / sizeof(sqids_bl_defaults[0]);
+        ++i) {
+        if (strcmp(name, sqids_bl_defaults[i].name) != 0) {
+            continue;
+        }
+
+        pthread_once(&sqids_bl_defaults[i].once, sqids_bl_default_inits[i]);
+
+        if (!sqids_bl_defaults[i].bl) {
+            sqids_errno = SQIDS_ERR_ALLOC;
+            return NULL;
+        }
+
+        return sqids_bl_ref(sqids_bl_defaults[i].bl);
+    }
+
+    sqids_errno = SQIDS_ERR_NOENT;
+    return NULL;
+}
+
 /* search for a string in the list */
 sqids_bl_node_t *
 sqids_bl_find(sqids_bl_t *bl, char *s)
@@ -229,6 +500,20 @@ sqids_bl_find(sqids_bl_t *bl, char *s)
     return NULL;
 }
 
+/* search for a string among the words of the given languages */
+sqids_bl_node_t *
+sqids_bl_find_mask(sqids_bl_t *bl, char *s, unsigned int mask)
+{
+    sqids_bl_node_t *iter;
+    sqids_bl_foreach(bl->head, iter) {
+        if ((iter->mask & mask) && bl->match_func(s, iter->s)) {
+            return iter;
+        }
+    }
+
+    return NULL;
+}
+
 /* default list search func */
 int
 sqids_bl_match(char *s, char *bad_word)
@@ -260,163 +545,690 @@ sqids_bl_match(char *s, char *bad_word)
 /* }}}                                                                       */
 
 /*****************************************************************************/
-/* {{{ sqids stuff                                                           */
+/* {{{ stats stuff                                                           */
 /*****************************************************************************/
 
-/* allocate a new sqids structure */
-sqids_t *
-sqids_new(char *alphabet, unsigned int min_len, sqids_bl_t *blocklist)
+/* a shard of counters, one cache line apart from the next */
+struct sqids_stats_shard_s {
+    unsigned long long encodes;
+    unsigned long long decodes;
+    unsigned long long bytes;
+    unsigned long long retries[SQIDS_STATS_RETRY_BUCKETS];
+    unsigned long long max_retries;
+    unsigned long long invalid;
+    unsigned long long overflows;
+} __attribute__((aligned(64)));
+typedef struct sqids_stats_shard_s sqids_stats_shard_t;
+
+/* threads get shard ids round-robin, on first use */
+static unsigned int sqids_stats_shard_next;
+static TLS unsigned int sqids_stats_shard_id;
+
+/* bump a counter - threads may share a shard, hence the atomics */
+#define sqids_stats_inc(counter, n) \
+    __atomic_add_fetch(&(counter), (n), __ATOMIC_RELAXED)
+
+/* the calling thread's shard */
+static inline sqids_stats_shard_t *
+sqids_stats_shard(sqids_t *sqids)
 {
-    sqids_t *result;
-    int len;
+    if (!sqids_stats_shard_id) {
+        sqids_stats_shard_id = __atomic_add_fetch(&sqids_stats_shard_next, 1,
+            __ATOMIC_RELAXED);
+    }
 
-    if (!(result = sqids_mem_alloc(sizeof(sqids_t)))) {
-        sqids_errno = SQIDS_ERR_ALLOC;
-        return NULL;
+    return &sqids->stats[sqids_stats_shard_id % SQIDS_STATS_SHARDS];
+}
+
+/* record an encode that took `increment` retries */
+static void
+sqids_stats_encode(sqids_t *sqids, int increment, size_t bytes)
+{
+    sqids_stats_shard_t *shard = sqids_stats_shard(sqids);
+    int bucket;
+
+    for (bucket = 0; increment && bucket < SQIDS_STATS_RETRY_BUCKETS - 1;
+        increment >>= 1, ++bucket) {}
+
+    sqids_stats_inc(shard->encodes, 1);
+    sqids_stats_inc(shard->bytes, bytes);
+    sqids_stats_inc(shard->retries[bucket], 1);
+}
+
+/* record a blocklist hit */
+static void
+sqids_stats_bl_hit(sqids_t *sqids, sqids_bl_node_t *node)
+{
+    sqids_bl_node_t *iter;
+    unsigned int i = 0;
+
+    sqids_bl_foreach(sqids->blocklist->head, iter) {
+        if (i >= sqids->bl_cnt) {
+            return;
+        }
+
+        if (iter == node) {
+            sqids_stats_inc(sqids->bl_hits[i], 1);
+            return;
+        }
+
+        ++i;
     }
+}
 
-    if (!alphabet) {
-        alphabet = SQIDS_DEFAULT_ALPHABET;
+/* start collecting counters */
+int
+sqids_stats_enable(sqids_t *sqids)
+{
+    sqids_bl_node_t *iter;
+    unsigned int i, cnt = 0;
+    char *p, *q;
+
+    if (sqids->stats) {
+        return 0;
     }
 
-    len = strlen(alphabet);
-    if (len < 3) {
-        sqids_mem_free(result);
-        sqids_errno = SQIDS_ERR_ALPHABET;
-        return NULL;
+    if (sqids->blocklist) {
+        sqids_bl_foreach(sqids->blocklist->head, iter) {
+            ++cnt;
+        }
     }
 
-    if (!(result->alphabet = sqids_mem_alloc(len + 1))) {
-        sqids_mem_free(result);
+    /* the allocator makes no alignment promises beyond malloc's, so
+       over-allocate and keep the original pointer right before the shards */
+    if (!(p = sqids_mem_alloc(SQIDS_STATS_SHARDS *
+        sizeof(sqids_stats_shard_t) + 64 + sizeof(void *)))) {
         sqids_errno = SQIDS_ERR_ALLOC;
-        return NULL;
+        return -1;
     }
 
-    memcpy(result->alphabet, alphabet, len + 1);
-    sqids_shuffle(result->alphabet);
+    q = (char *)(((uintptr_t)p + sizeof(void *) + 63) & ~(uintptr_t)63);
+    ((void **)q)[-1] = p;
 
-    result->min_len = min_len;
-    result->blocklist = blocklist;
+    if (!(sqids->bl_hits = sqids_mem_alloc(
+        (cnt ? cnt : 1) * sizeof(unsigned long long)))) {
+        sqids_mem_free(p);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return -1;
+    }
 
-    return result;
+    memset(q, 0, SQIDS_STATS_SHARDS * sizeof(sqids_stats_shard_t));
+    for (i = 0; i < cnt; ++i) {
+        sqids->bl_hits[i] = 0;
+    }
+
+    sqids->bl_cnt = cnt;
+    sqids->stats = (sqids_stats_shard_t *)q;
+
+    return 0;
 }
 
-/* free a sqids structure */
-void
-sqids_free(sqids_t *sqids)
+/* release the counters */
+static void
+sqids_stats_free(sqids_t *sqids)
 {
-    if (sqids->alphabet) {
-        sqids_mem_free(sqids->alphabet);
-    }
-
-    if (sqids->blocklist) {
-        sqids_bl_free(sqids->blocklist);
+    if (sqids->stats) {
+        sqids_mem_free(((void **)sqids->stats)[-1]);
+        sqids_mem_free(sqids->bl_hits);
     }
-
-    sqids_mem_free(sqids);
 }
 
-/* consistent shuffle */
-void
-sqids_shuffle(char *alphabet)
+/* snapshot the counters */
+int
+sqids_stats_snapshot(sqids_t *sqids, sqids_stats_t *stats)
 {
-    int i, j, x, tmp, len;
+    sqids_stats_shard_t *shard;
+    int i, j;
 
-    for (i = 0, len = strlen(alphabet), j = len - 1; j > 0; ++i, --j) {
-        x = (i * j + alphabet[i] + alphabet[j]) % len;
-        tmp = alphabet[x];
-        alphabet[x] = alphabet[i];
-        alphabet[i] = tmp;
+    memset(stats, 0, sizeof(sqids_stats_t));
+
+    if (!sqids->stats) {
+        return -1;
     }
+
+    for (i = 0; i < SQIDS_STATS_SHARDS; ++i) {
+        shard = &sqids->stats[i];
+
+        stats->encodes += __atomic_load_n(&shard->encodes, __ATOMIC_RELAXED);
+        stats->decodes += __atomic_load_n(&shard->decodes, __ATOMIC_RELAXED);
+        stats->bytes += __atomic_load_n(&shard->bytes, __ATOMIC_RELAXED);
+        for (j = 0; j < SQIDS_STATS_RETRY_BUCKETS; ++j) {
+            stats->retries[j] += __atomic_load_n(&shard->retries[j],
+                __ATOMIC_RELAXED);
+        }
+        stats->max_retries += __atomic_load_n(&shard->max_retries,
+            __ATOMIC_RELAXED);
+        stats->invalid += __atomic_load_n(&shard->invalid, __ATOMIC_RELAXED);
+        stats->overflows += __atomic_load_n(&shard->overflows,
+            __ATOMIC_RELAXED);
+    }
+
+    return 0;
 }
 
-/* internal encode */
-static inline int
-sqids_encode_internal(sqids_t *sqids, char *s, unsigned int num_cnt,
-    unsigned long long *nums, int increment)
+/* snapshot blocklist hits per word */
+int
+sqids_stats_bl_hits(sqids_t *sqids, unsigned long long *hits,
+    unsigned int max)
 {
-    unsigned long long num;
-    int i, j, len, tmp, offset, prefix;
-    char *p, *pb;
+    unsigned int i;
 
-    /* sanity check */
-    len = strlen(sqids->alphabet);
-    if (increment > len) {
-        sqids_errno = SQIDS_ERR_MAX_RETRIES;
-        return 1;
+    if (!sqids->stats) {
+        return -1;
     }
 
-    /* get a semi-random offset from input numbers */
-    for (i = 0, offset = num_cnt; i < num_cnt; ++i) {
-        offset = sqids->alphabet[nums[i] % len] + i + offset;
+    for (i = 0; i < sqids->bl_cnt && i < max; ++i) {
+        hits[i] = __atomic_load_n(&sqids->bl_hits[i], __ATOMIC_RELAXED);
     }
-    offset %= len;
 
-    /* take increment into account when retrying generation */
-    offset = (offset + increment) % len;
+    return sqids->bl_cnt;
+}
 
-    /* rearrange the internal alphabet so that the second half comes first */
-    char alphabet[len + 1];
-    memcpy(alphabet, sqids->alphabet + offset, len - offset);
-    memcpy(alphabet + len - offset, sqids->alphabet, offset);
-    alphabet[len] = 0;
+/* }}}                                                                       */
 
-    /* prefix is always the first character in the internal alphabet */
-    prefix = sqids->alphabet[offset];
+/*****************************************************************************/
+/* {{{ sqids stuff                                                           */
+/*****************************************************************************/
 
-    /* reverse the internal alphabet */
-    for (j = 0; j < len / 2; ++j) {
-        tmp = alphabet[j];
-        alphabet[j] = alphabet[len - j - 1];
-        alphabet[len - j - 1] = tmp;
-    }
+/* padding is precomputed for up to this many numbers... */
+#define SQIDS_PAD_DEPTH 4
 
-    /* start with prefix */
-    p = s;
-    *p++ = prefix;
+/* ...as long as the tables stay within this many bytes */
+#define SQIDS_PAD_MEM_MAX 65536
 
-    /* iterate over numbers and encode each */
-    for (i = 0; i < num_cnt; ++i) {
-        /* save current string pointer so we can easily reverse the number */
-        pb = p;
+/* fill `n` bytes of padding material: the separator, followed by the
+   shuffle chain of the alphabet */
+static void
+sqids_pad_fill(char *alphabet, int len, char *out, unsigned int n)
+{
+    char state[len + 1];
+    unsigned int i, cnt;
 
-        /* encode the number in reverse */
-        num = nums[i];
-        do {
-            *p++ = alphabet[num % (len - 1) + 1];
-            num /= (len - 1);
-        } while (num > 0);
+    memcpy(state, alphabet, len + 1);
 
-        /* reverse it so we can decode it in the future */
-        for (j = 0; j < (p - pb) / 2; ++j) {
-            tmp = *(pb + j);
-            *(pb + j) = *(p - 1 - j);
-            *(p - 1 - j) = tmp;
+    for (i = 0; i < n;) {
+        if (i == 0) {
+            out[i++] = state[0];
+            continue;
         }
 
-        /* more numbers to encode - append a separator, shuffle the alphabet */
-        if (i < num_cnt - 1) {
-            /* the separator is the first character in the current alphabet */
-            *p++ = alphabet[0];
-            sqids_shuffle(alphabet);
+        sqids_shuffle(state);
+        cnt = n - i < len ? n - i : len;
+        memcpy(out + i, state, cnt);
+        i += cnt;
+    }
+}
+
+/* powers of the base - a number needs more than `i + 1` digits once it
+   reaches `pow[i]` */
+static void
+sqids_pow_init(sqids_t *sqids)
+{
+    unsigned long long pow, base = sqids->len - 1;
+
+    for (sqids->pow_cnt = 0, pow = base;; pow *= base) {
+        sqids->pow[sqids->pow_cnt++] = pow;
+
+        if (pow > 0xFFFFFFFFFFFFFFFFull / base) {
+            break;
         }
     }
+}
 
-    /* ensure a terminator */
-    *p = 0;
+/* precompute the padding of every (number count, offset) pair, so that
+   padding a short id boils down to a memcpy */
+static int
+sqids_pad_init(sqids_t *sqids)
+{
+    unsigned int len = sqids->len, min_len = sqids->min_len, depth, offset;
+    int j, tmp;
+    char *row;
 
-    /* handle min_len */
-    if (p - s < sqids->min_len) {
+    sqids->pad = NULL;
+    sqids->pad_depth = 0;
+
+    if (min_len < 2) {
+        return 0;
+    }
+
+    for (depth = SQIDS_PAD_DEPTH;
+        depth && (size_t)depth * len * min_len > SQIDS_PAD_MEM_MAX; --depth) {}
+
+    if (!depth) {
+        return 0;
+    }
+
+    if (!(sqids->pad = sqids_mem_alloc(depth * len * min_len))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return -1;
+    }
+
+    char alphabet[len + 1];
+    for (offset = 0; offset < len; ++offset) {
+        /* the alphabet state right after the prefix, as in encode */
+        memcpy(alphabet, sqids->alphabet + offset, len - offset);
+        memcpy(alphabet + len - offset, sqids->alphabet, offset);
+        alphabet[len] = 0;
+
+        for (j = 0; j < len / 2; ++j) {
+            tmp = alphabet[j];
+            alphabet[j] = alphabet[len - j - 1];
+            alphabet[len - j - 1] = tmp;
+        }
+
+        /* each further number shuffles it once more */
+        for (j = 0; j < depth; ++j) {
+            if (j) {
+                sqids_shuffle(alphabet);
+            }
+
+            row = sqids->pad + ((size_t)j * len + offset) * min_len;
+            sqids_pad_fill(alphabet, len, row, min_len - 1);
+        }
+    }
+
+    sqids->pad_depth = depth;
+
+    return 0;
+}
+
+/* a blocklist word that ids of this alphabet may contain, lowercased */
+struct sqids_bl_view_s {
+    char *s;
+    unsigned int len;
+    unsigned int digits;
+    unsigned int mask;
+    unsigned int gram;          /* hash of its first two characters */
+    sqids_bl_node_t *node;
+};
+typedef struct sqids_bl_view_s sqids_bl_view_t;
+
+/* character pairs hash into this many bits */
+#define SQIDS_BL_GRAMS 1024
+#define SQIDS_BL_GRAM(a, b) \
+    (((unsigned char)(a) * 31u + (unsigned char)(b)) % SQIDS_BL_GRAMS)
+
+/* a folded id, along with the character pairs it contains - a word can only
+   occur in it if its first pair does */
+struct sqids_bl_probe_s {
+    char *low;
+    size_t len;
+    uint64_t grams[SQIDS_BL_GRAMS / 64];
+};
+typedef struct sqids_bl_probe_s sqids_bl_probe_t;
+
+/* fold an id into a probe */
+static inline void
+sqids_bl_probe_init(sqids_bl_probe_t *probe, char *low, const char *s,
+    size_t n)
+{
+    unsigned int gram;
+    size_t i;
+
+    memset(probe->grams, 0, sizeof(probe->grams));
+
+    for (i = 0; i <= n; ++i) {
+        low[i] = tolower((unsigned char)s[i]);
+
+        if (i && i < n) {
+            gram = SQIDS_BL_GRAM(low[i - 1], low[i]);
+            probe->grams[gram / 64] |= 1ull << (gram % 64);
+        }
+    }
+
+    probe->low = low;
+    probe->len = n;
+}
+
+/* note whether any word of the view survives the language mask */
+static void
+sqids_bl_view_mask(sqids_t *sqids)
+{
+    unsigned int i;
+
+    if (!sqids->bl_view) {
+        return;
+    }
+
+    for (i = 0; i < sqids->bl_view_cnt; ++i) {
+        if (sqids->bl_view[i].mask & sqids->bl_mask) {
+            break;
+        }
+    }
+
+    sqids->bl_none = i == sqids->bl_view_cnt;
+}
+
+/* prune the blocklist down to the words this alphabet can produce, folded
+   the way `sqids_bl_match` compares them */
+static int
+sqids_bl_view_init(sqids_t *sqids)
+{
+    sqids_bl_t *bl = sqids->blocklist;
+    sqids_bl_node_t *iter;
+    unsigned char fold[256];
+    unsigned int i, cnt = 0;
+    size_t size = 0;
+    char *p, *q, *s;
+
+    sqids->bl_view = NULL;
+    sqids->bl_view_cnt = 0;
+    sqids->bl_view_size = 0;
+    sqids->bl_none = 0;
+
+    /* a custom match function may compare anything with anything */
+    if (!bl || bl->match_func != sqids_bl_match) {
+        return 0;
+    }
+
+    memset(fold, 0, sizeof(fold));
+    for (i = 0; i < sqids->len; ++i) {
+        fold[tolower((unsigned char)sqids->alphabet[i])] = 1;
+    }
+
+    /* size the view first, keeping it in a single allocation */
+    sqids_bl_foreach(bl->head, iter) {
+        for (p = iter->s; *p && fold[tolower((unsigned char)*p)]; ++p) {}
+
+        if (!*p) {
+            ++cnt;
+            size += sqids_bl_mapped(bl, iter) ? 0 : p - iter->s + 1;
+        }
+    }
+
+    if (!cnt) {
+        sqids->bl_none = 1;
+        return 0;
+    }
+
+    size += cnt * sizeof(sqids_bl_view_t);
+    if (!(sqids->bl_view = sqids_mem_alloc(size))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return -1;
+    }
+
+    q = (char *)(sqids->bl_view + cnt);
+    sqids_bl_foreach(bl->head, iter) {
+        for (p = iter->s; *p && fold[tolower((unsigned char)*p)]; ++p) {}
+
+        if (*p) {
+            continue;
+        }
+
+        sqids->bl_view[sqids->bl_view_cnt].len = p - iter->s;
+        sqids->bl_view[sqids->bl_view_cnt].digits =
+            strpbrk(iter->s, "0123456789") != NULL;
+        sqids->bl_view[sqids->bl_view_cnt].mask = iter->mask;
+        sqids->bl_view[sqids->bl_view_cnt].node = iter;
+
+        /* compiled files carry the folded words already */
+        if (sqids_bl_mapped(bl, iter)) {
+            s = (char *)bl->pool + bl->words[iter - bl->nodes].fold;
+        } else {
+            for (s = q, p = iter->s; *p; ++p) {
+                *q++ = tolower((unsigned char)*p);
+            }
+            *q++ = 0;
+        }
+
+        sqids->bl_view[sqids->bl_view_cnt].s = s;
+        sqids->bl_view[sqids->bl_view_cnt++].gram =
+            *s ? SQIDS_BL_GRAM(s[0], s[1]) : 0;
+    }
+
+    sqids->bl_view_size = size;
+    sqids_bl_view_mask(sqids);
+
+    return 0;
+}
+
+/* whether a folded id matches a word of the view, as `sqids_bl_match`
+   would decide */
+static inline int
+sqids_bl_view_match(const sqids_bl_view_t *word, const sqids_bl_probe_t *probe)
+{
+    const char *low = probe->low;
+    size_t slen = probe->len, i;
+
+    if (slen <= 3 || word->len <= 3) {
+        return slen == word->len && memcmp(low, word->s, slen) == 0;
+    }
+
+    if (word->digits) {
+        return memcmp(low, word->s, word->len) == 0 ||
+            memcmp(low + slen - word->len, word->s, word->len) == 0;
+    }
+
+    if (!(probe->grams[word->gram / 64] & (1ull << (word->gram % 64)))) {
+        return 0;
+    }
+
+    for (i = 0; i + word->len <= slen; ++i) {
+        if (low[i] == word->s[0] && memcmp(low + i, word->s, word->len) == 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* `sqids_bl_find_mask` over the view - the same rules as `sqids_bl_match`,
+   with the id folded once instead of on every comparison */
+static sqids_bl_node_t *
+sqids_bl_view_find(sqids_t *sqids, char *s)
+{
+    sqids_bl_view_t *word;
+    sqids_bl_probe_t probe;
+    size_t slen = strlen(s);
+    char low[slen + 1];
+
+    sqids_bl_probe_init(&probe, low, s, slen);
+
+    for (word = sqids->bl_view; word < sqids->bl_view + sqids->bl_view_cnt;
+        ++word) {
+        if ((word->mask & sqids->bl_mask) && slen >= word->len &&
+            sqids_bl_view_match(word, &probe)) {
+            return word->node;
+        }
+    }
+
+    return NULL;
+}
+
+/* check an id against the blocklist, as encode does */
+sqids_bl_node_t *
+sqids_blocked(sqids_t *sqids, char *s)
+{
+    if (!sqids->blocklist || sqids->bl_none) {
+        return NULL;
+    }
+
+    if (sqids->bl_view) {
+        return sqids_bl_view_find(sqids, s);
+    }
+
+    return sqids_bl_find_mask(sqids->blocklist, s, sqids->bl_mask);
+}
+
+/* allocate a new sqids structure */
+sqids_t *
+sqids_new(const char *alphabet, unsigned int min_len, sqids_bl_t *blocklist)
+{
+    sqids_t *result;
+    int len;
+
+    if (!(result = sqids_mem_alloc(sizeof(sqids_t)))) {
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    if (!alphabet) {
+        alphabet = SQIDS_DEFAULT_ALPHABET;
+    }
+
+    len = strlen(alphabet);
+    if (len < 3) {
+        sqids_mem_free(result);
+        sqids_errno = SQIDS_ERR_ALPHABET;
+        return NULL;
+    }
+
+    if (!(result->alphabet = sqids_mem_alloc(len + 1))) {
+        sqids_mem_free(result);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    memcpy(result->alphabet, alphabet, len + 1);
+    sqids_shuffle(result->alphabet);
+
+    result->len = len;
+    result->min_len = min_len;
+    result->blocklist = blocklist;
+    result->bl_mask = ~0u;
+    result->refcnt = 1;
+    result->stats = NULL;
+    result->bl_hits = NULL;
+    result->bl_cnt = 0;
+    result->map = NULL;
+    result->map_len = 0;
+
+    sqids_pow_init(result);
+
+    if (sqids_pad_init(result) != 0) {
+        sqids_mem_free(result->alphabet);
+        sqids_mem_free(result);
+        return NULL;
+    }
+
+    if (sqids_bl_view_init(result) != 0) {
+        if (result->pad) {
+            sqids_mem_free(result->pad);
+        }
+
+        sqids_mem_free(result->alphabet);
+        sqids_mem_free(result);
+        return NULL;
+    }
+
+    /* the view is built once, so later words would go unnoticed */
+    if (blocklist) {
+        __atomic_store_n(&blocklist->frozen, 1, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+/* restrict the blocklist to some languages */
+void
+sqids_bl_mask_set(sqids_t *sqids, unsigned int mask)
+{
+    sqids->bl_mask = mask;
+    sqids_bl_view_mask(sqids);
+}
+
+/* take a new reference to a sqids structure */
+sqids_t *
+sqids_ref(sqids_t *sqids)
+{
+    __atomic_add_fetch(&sqids->refcnt, 1, __ATOMIC_RELAXED);
+
+    return sqids;
+}
+
+/* drop a reference to a sqids structure, free it with the last one */
+void
+sqids_free(sqids_t *sqids)
+{
+    if (__atomic_sub_fetch(&sqids->refcnt, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+
+    /* snapshots keep the alphabet and the padding in the mapping */
+    if (sqids->alphabet && !sqids->map) {
+        sqids_mem_free(sqids->alphabet);
+    }
+
+    if (sqids->pad && !sqids->map) {
+        sqids_mem_free(sqids->pad);
+    }
+
+    if (sqids->bl_view) {
+        sqids_mem_free(sqids->bl_view);
+    }
+
+    /* unless its blocklist owns it */
+    if (sqids->map && (!sqids->blocklist ||
+        sqids->blocklist->map != sqids->map)) {
+        munmap(sqids->map, sqids->map_len);
+    }
+
+    if (sqids->blocklist) {
+        sqids_bl_free(sqids->blocklist);
+    }
+
+    sqids_stats_free(sqids);
+    sqids_mem_free(sqids);
+}
+
+/* consistent shuffle */
+void
+sqids_shuffle(char *alphabet)
+{
+    int i, j, x, tmp, len;
+
+    for (i = 0, len = strlen(alphabet), j = len - 1; j > 0; ++i, --j) {
+        x = (i * j + alphabet[i] + alphabet[j]) % len;
+        tmp = alphabet[x];
+        alphabet[x] = alphabet[i];
+        alphabet[i] = tmp;
+    }
+}
+
+/* semi-random offset from input numbers */
+static inline int
+sqids_offset(sqids_t *sqids, unsigned int num_cnt,
+    const unsigned long long *nums)
+{
+    int i, offset, len = sqids->len;
+
+    for (i = 0, offset = num_cnt; i < num_cnt; ++i) {
+        offset = sqids->alphabet[nums[i] % len] + i + offset;
+    }
+
+    return offset % len;
+}
+
+/* pad an id up to min_len, given the alphabet state after its last number
+   - precomputed for a few numbers */
+static inline char *
+sqids_encode_pad(sqids_t *sqids, char *s, char *p, char *alphabet,
+    unsigned int num_cnt, int offset)
+{
+    int len = sqids->len;
+    char *pb;
+    SQIDS_PHASE_DECL(t);
+
+    if (p - s < sqids->min_len && sqids->pad && num_cnt <= sqids->pad_depth) {
+        SQIDS_PHASE_BEGIN(t);
+        memcpy(p, sqids->pad + ((size_t)(num_cnt ? num_cnt - 1 : 0) *
+            len + offset) * sqids->min_len, sqids->min_len - (p - s));
+        p = s + sqids->min_len;
+        SQIDS_PHASE_END(SQIDS_PHASE_PADDING, t);
+    } else if (p - s < sqids->min_len) {
         /* append the last separator */
         *p++ = alphabet[0];
 
         /* keep appending separators and alphabet until we're done */
         while (p - s < sqids->min_len) {
+            SQIDS_PHASE_BEGIN(t);
             sqids_shuffle(alphabet);
+            SQIDS_PHASE_END(SQIDS_PHASE_SHUFFLE, t);
 
             /* the alphabet has enough material to feed the final id,
                we can safely terminate it */
-            if (len - 1 > sqids->min_len - (p - s)) {
+            SQIDS_PHASE_BEGIN(t);
+            if (len > sqids->min_len - (p - s)) {
                 alphabet[sqids->min_len - (p - s)] = 0;
             }
 
@@ -424,57 +1236,323 @@ sqids_encode_internal(sqids_t *sqids, char *s, unsigned int num_cnt,
             for (pb = alphabet; *pb; ++pb) {
                 *p++ = *pb;
             }
+            SQIDS_PHASE_END(SQIDS_PHASE_PADDING, t);
+        }
+    }
+
+    return p;
+}
+
+/* single encode attempt, without looking at the blocklist */
+static inline void
+sqids_encode_attempt(sqids_t *sqids, char *s, unsigned int num_cnt,
+    const unsigned long long *nums, int increment)
+{
+    unsigned long long num;
+    int i, j, len, tmp, offset, prefix;
+    char *p, *pb;
+    SQIDS_PHASE_DECL(t);
+
+    len = sqids->len;
+
+    /* take increment into account when retrying generation */
+    SQIDS_PHASE_BEGIN(t);
+    offset = (sqids_offset(sqids, num_cnt, nums) + increment) % len;
+    SQIDS_PHASE_END(SQIDS_PHASE_OFFSET, t);
+
+    /* rearrange the internal alphabet so that the second half comes first */
+    SQIDS_PHASE_BEGIN(t);
+    char alphabet[len + 1];
+    memcpy(alphabet, sqids->alphabet + offset, len - offset);
+    memcpy(alphabet + len - offset, sqids->alphabet, offset);
+    alphabet[len] = 0;
+
+    /* prefix is always the first character in the internal alphabet */
+    prefix = sqids->alphabet[offset];
+
+    /* reverse the internal alphabet */
+    for (j = 0; j < len / 2; ++j) {
+        tmp = alphabet[j];
+        alphabet[j] = alphabet[len - j - 1];
+        alphabet[len - j - 1] = tmp;
+    }
+    SQIDS_PHASE_END(SQIDS_PHASE_ROTATE, t);
+
+    /* start with prefix */
+    p = s;
+    *p++ = prefix;
+
+    /* iterate over numbers and encode each */
+    for (i = 0; i < num_cnt; ++i) {
+        /* save current string pointer so we can easily reverse the number */
+        SQIDS_PHASE_BEGIN(t);
+        pb = p;
+
+        /* encode the number in reverse */
+        num = nums[i];
+        do {
+            *p++ = alphabet[num % (len - 1) + 1];
+            num /= (len - 1);
+        } while (num > 0);
+
+        /* reverse it so we can decode it in the future */
+        for (j = 0; j < (p - pb) / 2; ++j) {
+            tmp = *(pb + j);
+            *(pb + j) = *(p - 1 - j);
+            *(p - 1 - j) = tmp;
+        }
+        SQIDS_PHASE_END(SQIDS_PHASE_DIGITS, t);
+
+        /* more numbers to encode - append a separator, shuffle the alphabet */
+        if (i < num_cnt - 1) {
+            /* the separator is the first character in the current alphabet */
+            *p++ = alphabet[0];
+
+            SQIDS_PHASE_BEGIN(t);
+            sqids_shuffle(alphabet);
+            SQIDS_PHASE_END(SQIDS_PHASE_SHUFFLE, t);
         }
     }
 
+    /* ensure a terminator */
+    *p = 0;
+
+    /* handle min_len */
+    p = sqids_encode_pad(sqids, s, p, alphabet, num_cnt, offset);
+
     /* terminate the buffer */
     *p = 0;
+}
+
+/* candidates encoded at once when retrying */
+#define SQIDS_SPEC_LANES 4
+
+/* ...for ids up to this long, longer ones retry one at a time */
+#define SQIDS_SPEC_MAX 256
+
+/* record an encode, or running out of retries */
+static inline int
+sqids_encode_done(sqids_t *sqids, int increment, size_t n)
+{
+    if (increment > sqids->len) {
+        if (sqids->stats) {
+            sqids_stats_inc(sqids_stats_shard(sqids)->max_retries, 1);
+        }
 
-    /* handle bad words */
-    if (sqids->blocklist && sqids_bl_find(sqids->blocklist, s)) {
-        return sqids_encode_internal(sqids, s, num_cnt, nums, increment + 1);
+        sqids_errno = SQIDS_ERR_MAX_RETRIES;
+        return 1;
+    }
+
+    if (sqids->stats) {
+        sqids_stats_encode(sqids, increment, n);
     }
 
     return 0;
 }
 
-/* estimate encoded buffer needs */
+/* speculative retries: encode the candidates of several increments at once,
+   sharing the digits of the numbers, and keep the first clean one - the one
+   retrying one increment at a time would reach */
+static int
+sqids_encode_spec(sqids_t *sqids, char *s, unsigned int num_cnt,
+    const unsigned long long *nums, int increment, size_t n)
+{
+    unsigned long long num;
+    unsigned int digits[n], ends[num_cnt], i, j, k, l, lanes, tmp;
+    int len = sqids->len, base, offset;
+    char ids[SQIDS_SPEC_LANES][n + 1], alphabets[SQIDS_SPEC_LANES][len + 1];
+    char *p[SQIDS_SPEC_LANES];
+    sqids_bl_node_t *hit;
+    SQIDS_PHASE_DECL(t);
+
+    /* digits of every number, most significant first, once */
+    SQIDS_PHASE_BEGIN(t);
+    for (i = 0, k = 0; i < num_cnt; ++i) {
+        num = nums[i];
+        j = k;
+        do {
+            digits[k++] = num % (len - 1);
+            num /= (len - 1);
+        } while (num > 0);
+
+        for (l = 0; l < (k - j) / 2; ++l) {
+            tmp = digits[j + l];
+            digits[j + l] = digits[k - 1 - l];
+            digits[k - 1 - l] = tmp;
+        }
+
+        ends[i] = k;
+    }
+    SQIDS_PHASE_END(SQIDS_PHASE_DIGITS, t);
+
+    base = sqids_offset(sqids, num_cnt, nums);
+
+    for (;; increment += lanes) {
+        if (increment > len) {
+            return sqids_encode_done(sqids, increment, n);
+        }
+
+        lanes = len - increment + 1;
+        lanes = lanes < SQIDS_SPEC_LANES ? lanes : SQIDS_SPEC_LANES;
+
+        /* prefixes, and the alphabet states they lead to */
+        SQIDS_PHASE_BEGIN(t);
+        for (l = 0; l < lanes; ++l) {
+            offset = (base + increment + l) % len;
+            for (j = 0; j < len; ++j) {
+                alphabets[l][j] = sqids->alphabet[(offset + len - 1 - j) % len];
+            }
+            alphabets[l][len] = 0;
+
+            p[l] = ids[l];
+            *p[l]++ = sqids->alphabet[offset];
+        }
+        SQIDS_PHASE_END(SQIDS_PHASE_ROTATE, t);
+
+        /* numbers, interleaving the candidates */
+        for (i = 0, k = 0; i < num_cnt; k = ends[i++]) {
+            for (l = 0; l < lanes; ++l) {
+                for (j = k; j < ends[i]; ++j) {
+                    *p[l]++ = alphabets[l][digits[j] + 1];
+                }
+
+                if (i < num_cnt - 1) {
+                    *p[l]++ = alphabets[l][0];
+
+                    SQIDS_PHASE_BEGIN(t);
+                    sqids_shuffle(alphabets[l]);
+                    SQIDS_PHASE_END(SQIDS_PHASE_SHUFFLE, t);
+                }
+            }
+        }
+
+        for (l = 0; l < lanes; ++l) {
+            *p[l] = 0;
+            p[l] = sqids_encode_pad(sqids, ids[l], p[l], alphabets[l], num_cnt,
+                (base + increment + l) % len);
+            *p[l] = 0;
+        }
+
+        /* checked in order, so the scans stop where serial ones would */
+        for (l = 0; l < lanes; ++l) {
+            SQIDS_PHASE_BEGIN(t);
+            hit = sqids_blocked(sqids, ids[l]);
+            SQIDS_PHASE_END(SQIDS_PHASE_BLOCKLIST, t);
+
+            if (!hit) {
+                memcpy(s, ids[l], n + 1);
+                return sqids_encode_done(sqids, increment + l, n);
+            }
+
+            if (sqids->stats) {
+                sqids_stats_bl_hit(sqids, hit);
+            }
+        }
+    }
+}
+
+/* internal encode */
 static inline int
-sqids_estimate(sqids_t *sqids, unsigned int num_cnt, unsigned long long *nums)
+sqids_encode_internal(sqids_t *sqids, char *s, unsigned int num_cnt,
+    const unsigned long long *nums)
 {
-    int i, result;
-    double log2len = log2(strlen(sqids->alphabet) - 1);
+    int increment;
+    size_t n;
+    sqids_bl_node_t *hit;
+    SQIDS_PHASE_DECL(t);
+
+    for (increment = 0;; ++increment) {
+        /* sanity check */
+        if (increment > sqids->len) {
+            return sqids_encode_done(sqids, increment, 0);
+        }
+
+        sqids_encode_attempt(sqids, s, num_cnt, nums, increment);
 
-    for (i = 0, result = 0; i < num_cnt; ++i) {
-        switch (nums[i]) {
-            case 0:
-                result += 2;
-                break;
-            case 0xFFFFFFFFFFFFFFFFull:
-                result += ceil(log2(nums[i]) / log2len) + 1;
-                break;
-            default:
-                result += ceil(log2(nums[i] + 1) / log2len) + 1;
+        /* handle bad words */
+        hit = NULL;
+        if (sqids->blocklist && !sqids->bl_none) {
+            SQIDS_PHASE_BEGIN(t);
+            hit = sqids_blocked(sqids, s);
+            SQIDS_PHASE_END(SQIDS_PHASE_BLOCKLIST, t);
         }
+
+        if (!hit) {
+            return sqids_encode_done(sqids, increment,
+                sqids->stats ? sqids_encoded_len(sqids, num_cnt, nums) : 0);
+        }
+
+        if (sqids->stats) {
+            sqids_stats_bl_hit(sqids, hit);
+        }
+
+        /* the first hit makes further ones likely - try the next few
+           increments at once */
+        n = strlen(s);
+        if (n <= SQIDS_SPEC_MAX) {
+            return sqids_encode_spec(sqids, s, num_cnt, nums, increment + 1,
+                n);
+        }
+    }
+}
+
+/* count of digits needed to encode a number */
+static inline unsigned int
+sqids_digits(sqids_t *sqids, unsigned long long num)
+{
+    unsigned int i;
+
+    for (i = 0; i < sqids->pow_cnt && num >= sqids->pow[i]; ++i) {}
+
+    return i + 1;
+}
+
+/* exact encoded length */
+size_t
+sqids_encoded_len(sqids_t *sqids, unsigned int num_cnt,
+    const unsigned long long *nums)
+{
+    unsigned int i;
+    size_t result;
+
+    /* prefix + a separator between each two numbers */
+    result = num_cnt ? num_cnt : 1;
+
+    for (i = 0; i < num_cnt; ++i) {
+        result += sqids_digits(sqids, nums[i]);
     }
 
-    return (result > sqids->min_len ? result : sqids->min_len) + 1;
+    return result > sqids->min_len ? result : sqids->min_len;
+}
+
+/* encode into a caller-supplied buffer */
+int
+sqids_encode_buf(sqids_t *sqids, char *buf, unsigned int num_cnt,
+    const unsigned long long *nums)
+{
+    if (sqids_encode_internal(sqids, buf, num_cnt, nums) != 0) {
+        return -1;
+    }
+
+    return sqids_encoded_len(sqids, num_cnt, nums);
 }
 
 /* encode */
 char *
-sqids_encode(sqids_t *sqids, unsigned int num_cnt, unsigned long long *nums)
+sqids_encode(sqids_t *sqids, unsigned int num_cnt,
+    const unsigned long long *nums)
 {
     char *result;
 
     /* allocate string buffer */
-    if (!(result = sqids_mem_alloc(sqids_estimate(sqids, num_cnt, nums)))) {
+    if (!(result = sqids_mem_alloc(sqids_encoded_len(sqids, num_cnt, nums) +
+        1))) {
         sqids_errno = SQIDS_ERR_ALLOC;
         return NULL;
     }
 
     /* encode */
-    if (sqids_encode_internal(sqids, result, num_cnt, nums, 0) != 0) {
+    if (sqids_encode_internal(sqids, result, num_cnt, nums) != 0) {
         sqids_mem_free(result);
         return NULL;
     }
@@ -499,13 +1577,14 @@ sqids_vencode(sqids_t *sqids, unsigned int num_cnt, ...)
     va_end(ap);
 
     /* allocate string buffer */
-    if (!(result = sqids_mem_alloc(sqids_estimate(sqids, num_cnt, nums)))) {
+    if (!(result = sqids_mem_alloc(sqids_encoded_len(sqids, num_cnt, nums) +
+        1))) {
         sqids_errno = SQIDS_ERR_ALLOC;
         return NULL;
     }
 
     /* encode */
-    if (sqids_encode_internal(sqids, result, num_cnt, nums, 0) != 0) {
+    if (sqids_encode_internal(sqids, result, num_cnt, nums) != 0) {
         sqids_mem_free(result);
         return NULL;
     }
@@ -513,34 +1592,70 @@ sqids_vencode(sqids_t *sqids, unsigned int num_cnt, ...)
     return result;
 }
 
+/* check that a length-delimited string contains only alphabet characters */
+static inline int
+sqids_check(sqids_t *sqids, const char *s, size_t n, int len)
+{
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        if (!memchr(sqids->alphabet, s[i], len)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* validate */
+int
+sqids_valid(sqids_t *sqids, const char *s)
+{
+    return sqids_valid_len(sqids, s, strlen(s));
+}
+
+/* length-delimited validate */
+int
+sqids_valid_len(sqids_t *sqids, const char *s, size_t n)
+{
+    return sqids_check(sqids, s, n, sqids->len);
+}
+
 /* decode number count */
 int
-sqids_num_cnt(sqids_t *sqids, char *s)
+sqids_num_cnt(sqids_t *sqids, const char *s)
+{
+    return sqids_num_cnt_len(sqids, s, strlen(s));
+}
+
+/* length-delimited decode number count */
+int
+sqids_num_cnt_len(sqids_t *sqids, const char *s, size_t n)
 {
     int i, j, len, tmp, offset, prefix, separator;
-    char *p;
+    const char *p, *end;
+
+    len = sqids->len;
 
     /* safety first - scan str for unknown characters */
-    for (i = 0, j = strlen(s); i < j; ++i) {
-        if (!strchr(sqids->alphabet, s[i])) {
-            sqids_errno = SQIDS_ERR_INVALID;
-            return 0;
-        }
+    if (!sqids_check(sqids, s, n, len)) {
+        sqids_errno = SQIDS_ERR_INVALID;
+        return -1;
     }
 
     /* empty string - no numbers (technically not an error) */
-    if (!j) {
+    if (!n) {
         return 0;
     }
 
     p = s;
-    len = strlen(sqids->alphabet);
+    end = s + n;
 
     /* extract prefix */
     prefix = *p++;
 
     /* determine the offset */
-    offset = strchr(sqids->alphabet, prefix) - sqids->alphabet;
+    offset = (char *)memchr(sqids->alphabet, prefix, len) - sqids->alphabet;
 
     /* rearrange alphabet back into its original form */
     char alphabet[len + 1];
@@ -556,7 +1671,7 @@ sqids_num_cnt(sqids_t *sqids, char *s)
     }
 
     /* walk the hash */
-    for (i = 0; *p;) {
+    for (i = 0; p < end;) {
         separator = alphabet[0];
 
         /* empty chunk - we're done */
@@ -565,11 +1680,11 @@ sqids_num_cnt(sqids_t *sqids, char *s)
         }
 
         /* do skip */
-        for (; *p && *p != separator; ++p) {}
+        for (; p < end && *p != separator; ++p) {}
         ++i;
 
         /* more numbers - shuffle the alphabet */
-        if (*p == separator) {
+        if (p < end && *p == separator) {
             sqids_shuffle(alphabet);
             ++p;
         }
@@ -580,36 +1695,56 @@ sqids_num_cnt(sqids_t *sqids, char *s)
 
 /* decode */
 int
-sqids_decode(sqids_t *sqids, char *s, unsigned long long *nums,
+sqids_decode(sqids_t *sqids, const char *s, unsigned long long *nums,
     unsigned int num_max)
+{
+    return sqids_decode_len(sqids, s, strlen(s), nums, num_max);
+}
+
+/* length-delimited decode */
+int
+sqids_decode_len(sqids_t *sqids, const char *s, size_t n,
+    unsigned long long *nums, unsigned int num_max)
 {
     unsigned long long num, prev;
     int i, j, len, tmp, offset, prefix, separator;
-    char *p;
+    const char *p, *end;
+    SQIDS_PHASE_DECL(t);
+
+    len = sqids->len;
+
+    if (sqids->stats) {
+        sqids_stats_inc(sqids_stats_shard(sqids)->decodes, 1);
+    }
 
     /* safety first - scan str for unknown characters */
-    for (i = 0, j = strlen(s); i < j; ++i) {
-        if (!strchr(sqids->alphabet, s[i])) {
-            sqids_errno = SQIDS_ERR_INVALID;
-            return -1;
+    SQIDS_PHASE_BEGIN(t);
+    if (!sqids_check(sqids, s, n, len)) {
+        if (sqids->stats) {
+            sqids_stats_inc(sqids_stats_shard(sqids)->invalid, 1);
         }
+
+        sqids_errno = SQIDS_ERR_INVALID;
+        return -1;
     }
+    SQIDS_PHASE_END(SQIDS_PHASE_VALIDATE, t);
 
     /* empty string - nothing to decode (technically not an error) */
-    if (!j) {
+    if (!n) {
         return 0;
     }
 
     p = s;
-    len = strlen(sqids->alphabet);
+    end = s + n;
 
     /* extract prefix */
     prefix = *p++;
 
     /* determine the offset */
-    offset = strchr(sqids->alphabet, prefix) - sqids->alphabet;
+    offset = (char *)memchr(sqids->alphabet, prefix, len) - sqids->alphabet;
 
     /* rearrange alphabet back into its original form */
+    SQIDS_PHASE_BEGIN(t);
     char alphabet[len + 1];
     memcpy(alphabet, sqids->alphabet + offset, len - offset);
     memcpy(alphabet + len - offset, sqids->alphabet, offset);
@@ -621,9 +1756,10 @@ sqids_decode(sqids_t *sqids, char *s, unsigned long long *nums,
         alphabet[j] = alphabet[len - j - 1];
         alphabet[len - j - 1] = tmp;
     }
+    SQIDS_PHASE_END(SQIDS_PHASE_ROTATE, t);
 
     /* walk the hash */
-    for (i = 0; *p && i < num_max;) {
+    for (i = 0; p < end && i < num_max;) {
         separator = alphabet[0];
 
         /* empty chunk - we're done */
@@ -632,24 +1768,32 @@ sqids_decode(sqids_t *sqids, char *s, unsigned long long *nums,
         }
 
         /* do parse */
+        SQIDS_PHASE_BEGIN(t);
         num = 0;
-        for (; *p && *p != separator; ++p) {
+        for (; p < end && *p != separator; ++p) {
             prev = num;
 
             num *= len - 1;
-            num += strchr(alphabet + 1, *p) - alphabet - 1;
+            num += (char *)memchr(alphabet + 1, *p, len - 1) - alphabet - 1;
 
             /* overflow protection */
             if (num < prev) {
+                if (sqids->stats) {
+                    sqids_stats_inc(sqids_stats_shard(sqids)->overflows, 1);
+                }
+
                 sqids_errno = SQIDS_ERR_OVERFLOW;
                 return -1;
             }
         }
         nums[i++] = num;
+        SQIDS_PHASE_END(SQIDS_PHASE_PARSE, t);
 
         /* more numbers - shuffle the alphabet */
-        if (*p == separator) {
+        if (p < end && *p == separator) {
+            SQIDS_PHASE_BEGIN(t);
             sqids_shuffle(alphabet);
+            SQIDS_PHASE_END(SQIDS_PHASE_SHUFFLE, t);
             ++p;
         }
     }
@@ -657,6 +1801,295 @@ sqids_decode(sqids_t *sqids, char *s, unsigned long long *nums,
     return i;
 }
 
+/* canonical decode */
+int
+sqids_decode_canonical(sqids_t *sqids, const char *s, size_t n,
+    unsigned long long *nums, unsigned int num_max)
+{
+    int i, cnt, len, increment;
+
+    /* scratch space lives on the stack, keep it bounded */
+    if (n > SQIDS_CANONICAL_MAX) {
+        sqids_errno = SQIDS_ERR_NONCANONICAL;
+        return -1;
+    }
+
+    /* each number takes a character plus a separator (or the prefix) */
+    char scratch[n + 1];
+    unsigned long long tmp[n / 2 + 1];
+
+    len = sqids->len;
+
+    if ((cnt = sqids_decode_len(sqids, s, n, tmp, n / 2 + 1)) < 0) {
+        return -1;
+    }
+
+    /* encode never produces empty hashes, nor ones of a different length */
+    if (!cnt || cnt > n / 2 || sqids_encoded_len(sqids, cnt, tmp) != n) {
+        sqids_errno = SQIDS_ERR_NONCANONICAL;
+        return -1;
+    }
+
+    /* the prefix tells which retry would have produced this hash */
+    increment = (char *)memchr(sqids->alphabet, *s, len) - sqids->alphabet;
+    increment = (increment - sqids_offset(sqids, cnt, tmp) + len) % len;
+
+    /* without a blocklist, encode never retries */
+    if (increment && (!sqids->blocklist || sqids->bl_none)) {
+        sqids_errno = SQIDS_ERR_NONCANONICAL;
+        return -1;
+    }
+
+    /* re-encode into stack scratch and compare */
+    sqids_encode_attempt(sqids, scratch, cnt, tmp, increment);
+    if (memcmp(scratch, s, n) != 0) {
+        sqids_errno = SQIDS_ERR_NONCANONICAL;
+        return -1;
+    }
+
+    /* the hash itself must not be blocked, but every earlier retry must */
+    if (sqids->blocklist && !sqids->bl_none) {
+        if (sqids_blocked(sqids, scratch)) {
+            sqids_errno = SQIDS_ERR_NONCANONICAL;
+            return -1;
+        }
+
+        for (i = 0; i < increment; ++i) {
+            sqids_encode_attempt(sqids, scratch, cnt, tmp, i);
+
+            if (!sqids_blocked(sqids, scratch)) {
+                sqids_errno = SQIDS_ERR_NONCANONICAL;
+                return -1;
+            }
+        }
+    }
+
+    for (i = 0; i < cnt && i < num_max; ++i) {
+        nums[i] = tmp[i];
+    }
+
+    return i;
+}
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ snapshot stuff                                                        */
+/*****************************************************************************/
+
+/* round up to the alignment of the sections */
+#define SQIDS_SNAPSHOT_ALIGN(n) (((n) + 7) & ~(uint64_t)7)
+
+/* write a compiled sqids structure into a file */
+int
+sqids_snapshot_write(sqids_t *sqids, const char *path)
+{
+    sqids_snapshot_hdr_t hdr;
+    sqids_bl_node_t *iter;
+    sqids_bl_view_t *word;
+    size_t bl_size = 0;
+    uint64_t pad_size;
+    uint32_t *view, i;
+    void *bl = NULL;
+    char *buf;
+    int r;
+
+    /* match functions can't be stored */
+    if (sqids->blocklist && sqids->blocklist->match_func != sqids_bl_match) {
+        sqids_errno = SQIDS_ERR_FORMAT;
+        return -1;
+    }
+
+    if (sqids->blocklist && !(bl = sqids_bl_compile(sqids->blocklist,
+        &bl_size))) {
+        return -1;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, SQIDS_SNAPSHOT_MAGIC, sizeof(SQIDS_SNAPSHOT_MAGIC));
+    hdr.version = SQIDS_SNAPSHOT_VERSION;
+    hdr.order = SQIDS_BL_FILE_ORDER;
+    hdr.len = sqids->len;
+    hdr.min_len = sqids->min_len;
+    hdr.bl_mask = sqids->bl_mask;
+    hdr.pad_depth = sqids->pad_depth;
+    hdr.flags = bl ? SQIDS_SNAPSHOT_BLOCKLIST : 0;
+    hdr.view_cnt = sqids->bl_view_cnt;
+
+    pad_size = (uint64_t)sqids->pad_depth * sqids->len * sqids->min_len;
+    hdr.alphabet = SQIDS_SNAPSHOT_ALIGN(sizeof(hdr));
+    hdr.pad = SQIDS_SNAPSHOT_ALIGN(hdr.alphabet + sqids->len + 1);
+    hdr.view = SQIDS_SNAPSHOT_ALIGN(hdr.pad + pad_size);
+    hdr.bl = SQIDS_SNAPSHOT_ALIGN(hdr.view + hdr.view_cnt * sizeof(uint32_t));
+    hdr.bl_size = bl_size;
+    hdr.size = hdr.bl + bl_size;
+
+    if (hdr.size > 0xFFFFFFFFull) {
+        if (bl) {
+            sqids_mem_free(bl);
+        }
+
+        sqids_errno = SQIDS_ERR_OVERFLOW;
+        return -1;
+    }
+
+    if (!(buf = sqids_mem_alloc(hdr.size))) {
+        if (bl) {
+            sqids_mem_free(bl);
+        }
+
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return -1;
+    }
+
+    memset(buf, 0, hdr.size);
+    memcpy(buf, &hdr, sizeof(hdr));
+    memcpy(buf + hdr.alphabet, sqids->alphabet, sqids->len + 1);
+
+    if (pad_size) {
+        memcpy(buf + hdr.pad, sqids->pad, pad_size);
+    }
+
+    /* view entries follow list order, so store them as word indexes */
+    view = (uint32_t *)(buf + hdr.view);
+    word = sqids->bl_view;
+    if (sqids->blocklist) {
+        i = 0;
+        sqids_bl_foreach(sqids->blocklist->head, iter) {
+            if (word < sqids->bl_view + sqids->bl_view_cnt &&
+                word->node == iter) {
+                *view++ = i | (word++->digits ? 0x80000000u : 0);
+            }
+
+            ++i;
+        }
+    }
+
+    if (bl) {
+        memcpy(buf + hdr.bl, bl, bl_size);
+        sqids_mem_free(bl);
+    }
+
+    r = sqids_file_replace(path, buf, hdr.size);
+    sqids_mem_free(buf);
+
+    return r;
+}
+
+/* map a snapshot and build a sqids structure using it in place */
+sqids_t *
+sqids_snapshot_open(const char *path)
+{
+    const sqids_snapshot_hdr_t *hdr;
+    const uint32_t *view;
+    sqids_bl_view_t *word;
+    sqids_bl_t *bl;
+    sqids_t *result;
+    uint64_t pad_size;
+    uint32_t i, idx;
+    size_t n;
+    char *map;
+
+    if (!(map = sqids_file_map(path, &n))) {
+        return NULL;
+    }
+
+    /* the header, then every section has to stay within the file */
+    hdr = (const sqids_snapshot_hdr_t *)map;
+    pad_size = n < sizeof(*hdr) ? 0 :
+        (uint64_t)hdr->pad_depth * hdr->len * hdr->min_len;
+
+    if (n < sizeof(*hdr) ||
+        memcmp(hdr->magic, SQIDS_SNAPSHOT_MAGIC, sizeof(SQIDS_SNAPSHOT_MAGIC))
+        != 0 || hdr->version != SQIDS_SNAPSHOT_VERSION ||
+        hdr->order != SQIDS_BL_FILE_ORDER || hdr->size != n ||
+        hdr->len < 3 || hdr->len > 0xFFFF ||
+        hdr->pad_depth > SQIDS_PAD_DEPTH ||
+        hdr->alphabet > n || n - hdr->alphabet < hdr->len + 1ull ||
+        map[hdr->alphabet + hdr->len] ||
+        strlen(map + hdr->alphabet) != hdr->len ||
+        hdr->pad > n || n - hdr->pad < pad_size || hdr->view % 8 ||
+        hdr->view > n || n - hdr->view < hdr->view_cnt * 4ull ||
+        (hdr->view_cnt && !(hdr->flags & SQIDS_SNAPSHOT_BLOCKLIST)) ||
+        hdr->bl % 8 || hdr->bl > n || hdr->bl_size > n - hdr->bl) {
+        munmap(map, n);
+        sqids_errno = SQIDS_ERR_FORMAT;
+        return NULL;
+    }
+
+    if (!(result = sqids_mem_alloc(sizeof(sqids_t)))) {
+        munmap(map, n);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    memset(result, 0, sizeof(sqids_t));
+    result->alphabet = map + hdr->alphabet;
+    result->len = hdr->len;
+    result->min_len = hdr->min_len;
+    result->bl_mask = hdr->bl_mask;
+    result->refcnt = 1;
+    result->pad = hdr->pad_depth ? map + hdr->pad : NULL;
+    result->pad_depth = hdr->pad_depth;
+    result->map = map;
+    result->map_len = n;
+    sqids_pow_init(result);
+
+    /* the blocklist uses its words in place too */
+    if ((hdr->flags & SQIDS_SNAPSHOT_BLOCKLIST) && !(result->blocklist =
+        sqids_bl_load_mem(map + hdr->bl, hdr->bl_size, NULL))) {
+        sqids_free(result);
+        return NULL;
+    }
+
+    if (!(bl = result->blocklist)) {
+        return result;
+    }
+
+    /* references to it may outlive ours, so it owns the mapping - and we
+       hold one of them */
+    bl->map = map;
+    bl->map_len = n;
+    bl->frozen = 1;
+
+    /* the view, without having to prune the list again */
+    if (!hdr->view_cnt) {
+        result->bl_none = 1;
+        return result;
+    }
+
+    if (!(result->bl_view = sqids_mem_alloc(
+        hdr->view_cnt * sizeof(sqids_bl_view_t)))) {
+        sqids_free(result);
+        sqids_errno = SQIDS_ERR_ALLOC;
+        return NULL;
+    }
+
+    view = (const uint32_t *)(map + hdr->view);
+    for (i = 0, word = result->bl_view; i < hdr->view_cnt; ++i, ++word) {
+        idx = view[i] & 0x7FFFFFFFu;
+
+        if (idx >= bl->node_cnt) {
+            sqids_free(result);
+            sqids_errno = SQIDS_ERR_FORMAT;
+            return NULL;
+        }
+
+        word->s = (char *)bl->pool + bl->words[idx].fold;
+        word->len = bl->words[idx].len;
+        word->digits = view[i] >> 31;
+        word->gram = word->len ? SQIDS_BL_GRAM(word->s[0], word->s[1]) : 0;
+        word->mask = bl->nodes[idx].mask;
+        word->node = &bl->nodes[idx];
+    }
+
+    result->bl_view_cnt = hdr->view_cnt;
+    result->bl_view_size = hdr->view_cnt * sizeof(sqids_bl_view_t);
+    sqids_bl_view_mask(result);
+
+    return result;
+}
+
 /* }}}                                                                       */
 
 /* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
@@ -1,6 +1,9 @@
 #ifndef SQIDS_H
 #define SQIDS_H 1
 
+#include <stddef.h>
+#include <stdint.h>
+
 /*****************************************************************************/
 /* {{{ version information                                                   */
 /*****************************************************************************/
@@ -21,6 +24,13 @@
 #define SQIDS_ERR_MAX_RETRIES   0x03
 #define SQIDS_ERR_INVALID       0x04
 #define SQIDS_ERR_OVERFLOW      0x05
+#define SQIDS_ERR_IMMUTABLE     0x06
+#define SQIDS_ERR_NOENT         0x07
+#define SQIDS_ERR_NONCANONICAL  0x08
+#define SQIDS_ERR_NOSPACE       0x09
+#define SQIDS_ERR_IO            0x0A
+#define SQIDS_ERR_FORMAT        0x0B
+#define SQIDS_ERR_BUSY          0x0C
 
 extern int *__sqids_errno_addr(void);
 #define sqids_errno (*__sqids_errno_addr())
@@ -36,15 +46,92 @@ extern void (*sqids_mem_free)(void *);
 
 /* }}}                                                                       */
 
+/*****************************************************************************/
+/* {{{ instrumentation stuff                                                 */
+/*****************************************************************************/
+
+/**
+ * encode/decode pipeline phases
+ */
+#define SQIDS_PHASE_OFFSET      0
+#define SQIDS_PHASE_ROTATE      1
+#define SQIDS_PHASE_DIGITS      2
+#define SQIDS_PHASE_PADDING     3
+#define SQIDS_PHASE_SHUFFLE     4
+#define SQIDS_PHASE_BLOCKLIST   5
+#define SQIDS_PHASE_VALIDATE    6
+#define SQIDS_PHASE_PARSE       7
+#define SQIDS_PHASE_CNT         8
+
+/**
+ * phase counters (cycles are TSC ticks on x86, nanoseconds elsewhere)
+ */
+struct sqids_phase_stats_s {
+    unsigned long long calls;
+    unsigned long long cycles;
+};
+typedef struct sqids_phase_stats_s sqids_phase_stats_t;
+
+/**
+ * snapshot the calling thread's phase counters into `SQIDS_PHASE_CNT` slots
+ * returns -1 (and zeroes) if the library was built without
+ * --enable-instrumentation
+ */
+int
+sqids_phase_snapshot(sqids_phase_stats_t *);
+
+/**
+ * reset the calling thread's phase counters
+ */
+void
+sqids_phase_reset(void);
+
+/**
+ * phase name
+ */
+const char *
+sqids_phase_name(int);
+
+/* }}}                                                                       */
+
 /*****************************************************************************/
 /* {{{ blocklist stuff                                                       */
 /*****************************************************************************/
 
+/**
+ * default blocklist languages
+ */
+#define SQIDS_BL_DE     0x01
+#define SQIDS_BL_EN     0x02
+#define SQIDS_BL_ES     0x04
+#define SQIDS_BL_FR     0x08
+#define SQIDS_BL_HI     0x10
+#define SQIDS_BL_IT     0x20
+#define SQIDS_BL_PT     0x40
+#define SQIDS_BL_ALL    0x7F
+
+/**
+ * default blocklist word
+ */
+struct sqids_bl_word_s {
+    const char *s;
+    unsigned int mask;
+};
+typedef struct sqids_bl_word_s sqids_bl_word_t;
+
+/**
+ * every default word once, tagged with its languages, NULL-terminated
+ */
+extern const sqids_bl_word_t sqids_bl_words[];
+
 /**
  * blocklist node
+ * `mask` holds the languages of default words, words added by hand have all
+ * bits set
  */
 struct sqids_bl_node_s {
     char *s;
+    unsigned int mask;
     struct sqids_bl_node_s *prev;
     struct sqids_bl_node_s *next;
 };
@@ -52,11 +139,22 @@ typedef struct sqids_bl_node_s sqids_bl_node_t;
 
 /**
  * blocklist structure
+ * once shared (more than one reference) or used by a sqids structure, a
+ * blocklist becomes immutable
+ * lists loaded from a file keep it mapped, with their words in place
  */
 struct sqids_bl_s {
     sqids_bl_node_t *head;
     sqids_bl_node_t *tail;
     int (*match_func)(char *, char *);
+    unsigned int refcnt;
+    unsigned int frozen;
+    void *map;
+    size_t map_len;
+    const struct sqids_bl_file_word_s *words;
+    const char *pool;
+    sqids_bl_node_t *nodes;
+    unsigned int node_cnt;
 };
 typedef struct sqids_bl_s sqids_bl_t;
 
@@ -67,11 +165,24 @@ sqids_bl_t *
 sqids_bl_new(int (*)(char *, char *));
 
 /**
- * free a list and all its data
+ * take a new reference to a list
+ */
+sqids_bl_t *
+sqids_bl_ref(sqids_bl_t *);
+
+/**
+ * drop a reference to a list, freeing it and all its data with the last one
  */
 void
 sqids_bl_free(sqids_bl_t *);
 
+/**
+ * default blocklist of the given languages (`SQIDS_BL_*` flags)
+ * if the library was built with --disable-default-blocklist, this will return an empty list
+ */
+sqids_bl_t *
+sqids_bl_list_mask(unsigned int, int (*)(char *, char *));
+
 /**
  * default blocklist for `de`
  * if the library was built with --disable-default-blocklist, this will return an empty list
@@ -128,6 +239,20 @@ sqids_bl_list_pt(int (*)(char *, char *));
 sqids_bl_t *
 sqids_bl_list_all(int (*)(char *, char *));
 
+/**
+ * shared, immutable default blocklist by name (`all`, `de`, `en`, `es`, `fr`,
+ * `hi`, `it` or `pt`), built once on first use
+ * returns a new reference
+ */
+sqids_bl_t *
+sqids_bl_default(const char *);
+
+/**
+ * copy a blocklist into a new, mutable one
+ */
+sqids_bl_t *
+sqids_bl_dup(sqids_bl_t *);
+
 /**
  * iterate over a blocklist
  */
@@ -156,6 +281,12 @@ sqids_bl_add_head(sqids_bl_t *, char *);
 sqids_bl_node_t *
 sqids_bl_find(sqids_bl_t *, char *);
 
+/**
+ * search for a string among the words of the given languages
+ */
+sqids_bl_node_t *
+sqids_bl_find_mask(sqids_bl_t *, char *, unsigned int);
+
 /**
  * default list match function
  */
@@ -164,6 +295,84 @@ sqids_bl_match(char *, char *);
 
 /* }}}                                                                       */
 
+/*****************************************************************************/
+/* {{{ blocklist file stuff                                                  */
+/*****************************************************************************/
+
+#define SQIDS_BL_FILE_MAGIC     "SQIDSBL"
+#define SQIDS_BL_FILE_VERSION   1
+#define SQIDS_BL_FILE_ORDER     0x01020304
+
+/**
+ * compiled blocklist file header
+ * the header is followed by `cnt` word records and a pool of nul-terminated
+ * strings - all in host byte order, with no pointers, so the file can be
+ * used in place wherever it's mapped
+ */
+struct sqids_bl_file_hdr_s {
+    char magic[8];
+    uint32_t version;
+    uint32_t order;             /* SQIDS_BL_FILE_ORDER, as written */
+    uint32_t cnt;
+    uint32_t flags;
+    uint64_t words;             /* offset of the records */
+    uint64_t pool;              /* offset of the string pool */
+    uint64_t size;              /* size of the whole file */
+    uint8_t reserved[16];
+};
+typedef struct sqids_bl_file_hdr_s sqids_bl_file_hdr_t;
+
+/**
+ * compiled blocklist word, with offsets into the pool
+ * `fold` is the word as the default match function compares it (lowercase)
+ */
+struct sqids_bl_file_word_s {
+    uint32_t s;
+    uint32_t fold;
+    uint32_t len;
+    uint32_t mask;
+};
+typedef struct sqids_bl_file_word_s sqids_bl_file_word_t;
+
+/**
+ * compile a blocklist into memory (free the result with `sqids_mem_free`)
+ */
+void *
+sqids_bl_compile(sqids_bl_t *, size_t *);
+
+/**
+ * compile a blocklist into a file, replacing it atomically
+ */
+int
+sqids_bl_write(sqids_bl_t *, const char *);
+
+/**
+ * use a compiled blocklist in place (8-byte aligned, kept alive by the
+ * caller for as long as the list)
+ */
+sqids_bl_t *
+sqids_bl_load_mem(const void *, size_t, int (*)(char *, char *));
+
+/**
+ * map a compiled blocklist file read-only and use its words in place
+ */
+sqids_bl_t *
+sqids_bl_load_mmap(const char *, int (*)(char *, char *));
+
+/**
+ * map a whole file read-only
+ */
+void *
+sqids_file_map(const char *, size_t *);
+
+/**
+ * write a file through a temporary one, replacing it atomically
+ */
+int
+sqids_file_replace(const char *, const void *, size_t);
+
+/* }}}                                                                       */
+
 /*****************************************************************************/
 /* {{{ sqids stuff                                                           */
 /*****************************************************************************/
@@ -180,8 +389,24 @@ sqids_bl_match(char *, char *);
  */
 struct sqids_s {
     char *alphabet;
+    unsigned int len;
     unsigned int min_len;
     sqids_bl_t *blocklist;
+    unsigned int bl_mask;
+    unsigned int refcnt;
+    unsigned int pow_cnt;
+    unsigned long long pow[64];
+    char *pad;
+    unsigned int pad_depth;
+    struct sqids_stats_shard_s *stats;
+    unsigned long long *bl_hits;
+    unsigned int bl_cnt;
+    struct sqids_bl_view_s *bl_view;
+    unsigned int bl_view_cnt;
+    size_t bl_view_size;
+    unsigned int bl_none;
+    void *map;
+    size_t map_len;
 };
 typedef struct sqids_s sqids_t;
 
@@ -189,10 +414,31 @@ typedef struct sqids_s sqids_t;
  * allocate a new sqids structure
  */
 sqids_t *
-sqids_new(char *, unsigned int, sqids_bl_t *);
+sqids_new(const char *, unsigned int, sqids_bl_t *);
+
+/**
+ * restrict the blocklist to the given languages (`SQIDS_BL_*` flags) - words
+ * added by hand always apply (call before sharing the structure)
+ */
+void
+sqids_bl_mask_set(sqids_t *, unsigned int);
+
+/**
+ * check an id against the blocklist, as encode does
+ * returns the matching word, or NULL
+ */
+sqids_bl_node_t *
+sqids_blocked(sqids_t *, char *);
+
+/**
+ * take a new reference to a sqids structure
+ */
+sqids_t *
+sqids_ref(sqids_t *);
 
 /**
- * free a sqids structure
+ * drop a reference to a sqids structure, freeing it (and dropping its
+ * blocklist reference) with the last one
  */
 void
 sqids_free(sqids_t *);
@@ -203,11 +449,24 @@ sqids_free(sqids_t *);
 void
 sqids_shuffle(char *);
 
+/**
+ * exact encoded length (not counting the terminator)
+ */
+size_t
+sqids_encoded_len(sqids_t *, unsigned int, const unsigned long long *);
+
+/**
+ * encode into a caller-supplied buffer of at least `sqids_encoded_len() + 1`
+ */
+int
+sqids_encode_buf(sqids_t *, char *, unsigned int, const unsigned long long *);
+
 /**
  * encode
  */
 char *
-sqids_encode(sqids_t *sqids, unsigned int num_cnt, unsigned long long *nums);
+sqids_encode(sqids_t *sqids, unsigned int num_cnt,
+    const unsigned long long *nums);
 
 /**
  * variadic encode
@@ -215,17 +474,417 @@ sqids_encode(sqids_t *sqids, unsigned int num_cnt, unsigned long long *nums);
 char *
 sqids_vencode(sqids_t *sqids, unsigned int num_cnt, ...);
 
+/**
+ * validate (all characters belong to the alphabet)
+ */
+int
+sqids_valid(sqids_t *, const char *);
+
+/**
+ * length-delimited validate
+ */
+int
+sqids_valid_len(sqids_t *, const char *, size_t);
+
 /**
  * numbers count
  */
 int
-sqids_num_cnt(sqids_t *, char *);
+sqids_num_cnt(sqids_t *, const char *);
+
+/**
+ * length-delimited numbers count
+ */
+int
+sqids_num_cnt_len(sqids_t *, const char *, size_t);
 
 /**
  * decode
  */
 int
-sqids_decode(sqids_t *, char *, unsigned long long *, unsigned int);
+sqids_decode(sqids_t *, const char *, unsigned long long *, unsigned int);
+
+/**
+ * length-delimited decode
+ */
+int
+sqids_decode_len(sqids_t *, const char *, size_t, unsigned long long *,
+    unsigned int);
+
+/**
+ * longest hash `sqids_decode_canonical` accepts
+ */
+#define SQIDS_CANONICAL_MAX 4096
+
+/**
+ * length-delimited decode, accepting only the exact hash encode would produce
+ */
+int
+sqids_decode_canonical(sqids_t *, const char *, size_t, unsigned long long *,
+    unsigned int);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ stats stuff                                                           */
+/*****************************************************************************/
+
+/**
+ * counter shards - threads are spread over them round-robin
+ */
+#define SQIDS_STATS_SHARDS 16
+
+/**
+ * retry histogram buckets: 0, 1, 2-3, 4-7, ..., 64-127, 128+
+ */
+#define SQIDS_STATS_RETRY_BUCKETS 9
+
+/**
+ * operational counters, summed over all shards
+ */
+struct sqids_stats_s {
+    unsigned long long encodes;
+    unsigned long long decodes;
+    unsigned long long bytes;
+    unsigned long long retries[SQIDS_STATS_RETRY_BUCKETS];
+    unsigned long long max_retries;
+    unsigned long long invalid;
+    unsigned long long overflows;
+};
+typedef struct sqids_stats_s sqids_stats_t;
+
+/**
+ * start collecting counters (call before sharing the structure)
+ */
+int
+sqids_stats_enable(sqids_t *);
+
+/**
+ * snapshot the counters
+ * returns -1 if they were never enabled
+ */
+int
+sqids_stats_snapshot(sqids_t *, sqids_stats_t *);
+
+/**
+ * snapshot blocklist hits per word, in list order
+ * returns the number of words, or -1 if counters were never enabled
+ */
+int
+sqids_stats_bl_hits(sqids_t *, unsigned long long *, unsigned int);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ arrow stuff                                                           */
+/*****************************************************************************/
+
+/**
+ * data bytes needed to encode an Arrow uint64 column
+ */
+size_t
+sqids_arrow_encoded_size(sqids_t *, size_t, const uint8_t *,
+    const uint64_t *);
+
+/**
+ * encode an Arrow uint64 column (validity bitmap + values) into an Arrow utf8
+ * column (validity bitmap + `n + 1` offsets + data)
+ * NULL input validity means no nulls, NULL output validity is not written
+ */
+int
+sqids_arrow_encode(sqids_t *, size_t, const uint8_t *, const uint64_t *,
+    uint8_t *, int32_t *, char *, size_t);
+
+/**
+ * decode an Arrow utf8 column into an Arrow list<uint64> column
+ * (validity bitmap + `n + 1` offsets + values), invalid hashes become nulls
+ * values need room for half the input data length
+ */
+int
+sqids_arrow_decode(sqids_t *, size_t, const uint8_t *, const int32_t *,
+    const char *, uint8_t *, int32_t *, uint64_t *, size_t);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ batch stuff                                                           */
+/*****************************************************************************/
+
+/**
+ * encode `n` single numbers, the i-th id (nul-terminated) goes to
+ * `out + i * stride`
+ * `stride` must fit the longest id plus the terminator
+ * uses AVX-512 or AVX2 lanes when the cpu supports them
+ */
+int
+sqids_encode_batch(sqids_t *, size_t, const unsigned long long *, char *,
+    size_t);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ minter stuff                                                          */
+/*****************************************************************************/
+
+/**
+ * minter of unique ids from a 64-bit sequence
+ */
+typedef struct sqids_minter_s sqids_minter_t;
+
+/**
+ * allocate a new minter, counting up from `start`
+ * each thread reserves `block` numbers at a time (0 means 1024) and encodes
+ * them up front
+ */
+sqids_minter_t *
+sqids_minter_new(sqids_t *, unsigned long long, unsigned int);
+
+/**
+ * free a minter (no thread may be using it)
+ */
+void
+sqids_minter_free(sqids_minter_t *);
+
+/**
+ * mint the next id, optionally storing its sequence number
+ * the result stays valid until the calling thread mints `block` more ids
+ */
+const char *
+sqids_minter_next(sqids_minter_t *, unsigned long long *);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ scan stuff                                                            */
+/*****************************************************************************/
+
+/**
+ * only report canonical ids
+ */
+#define SQIDS_SCAN_CANONICAL 0x01
+
+/**
+ * an id found by `sqids_scan`
+ */
+struct sqids_match_s {
+    size_t offset;
+    size_t len;
+    const unsigned long long *nums;
+    unsigned int num_cnt;
+};
+typedef struct sqids_match_s sqids_match_t;
+
+/**
+ * find maximal runs of alphabet characters `min_len` to `max_len` long
+ * (0 and anything above `SQIDS_CANONICAL_MAX` mean `SQIDS_CANONICAL_MAX`),
+ * decode them and report each through the callback, which stops the scan by
+ * returning non-zero
+ * returns the number of reported ids
+ */
+int
+sqids_scan(sqids_t *, const char *, size_t, size_t, size_t, int,
+    int (*)(const sqids_match_t *, void *), void *);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ field stuff                                                           */
+/*****************************************************************************/
+
+/**
+ * turn ids into numbers instead of numbers into ids
+ */
+#define SQIDS_FIELD_DECODE 0x01
+
+/**
+ * leave fields that do not convert as they are
+ */
+#define SQIDS_FIELD_KEEP 0x02
+
+/**
+ * rewrite field `field` (counted from 1) of every line of a buffer, copying
+ * everything else as is into `out` and storing the output length
+ * on a field that does not convert, the offset of the field is stored instead
+ */
+int
+sqids_field_rewrite(sqids_t *, const char *, size_t, unsigned int, char, int,
+    char *, size_t, size_t *);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ ring stuff                                                            */
+/*****************************************************************************/
+
+/**
+ * most numbers, and longest id, a ring slot holds
+ */
+#define SQIDS_RING_NUMS     8
+#define SQIDS_RING_ID_MAX   167
+
+/**
+ * shared-memory request ring (Linux only)
+ */
+typedef struct sqids_ring_s sqids_ring_t;
+
+/**
+ * create a ring of `slots` (a power of two) in a new memfd
+ */
+sqids_ring_t *
+sqids_ring_new(unsigned int);
+
+/**
+ * map a ring created by another process, from its (duplicated) descriptor
+ */
+sqids_ring_t *
+sqids_ring_open(int);
+
+/**
+ * the memfd backing a ring, to pass on to other processes
+ */
+int
+sqids_ring_fd(sqids_ring_t *);
+
+/**
+ * spin this many times before sleeping, or giving up on a full ring
+ */
+void
+sqids_ring_spin(sqids_ring_t *, unsigned int);
+
+/**
+ * unmap a ring
+ */
+void
+sqids_ring_free(sqids_ring_t *);
+
+/**
+ * enqueue numbers to encode, returning a ticket (-1 and SQIDS_ERR_BUSY when
+ * the ring is full)
+ */
+long long
+sqids_ring_put_encode(sqids_ring_t *, unsigned int,
+    const unsigned long long *);
+
+/**
+ * enqueue an id to decode, returning a ticket
+ */
+long long
+sqids_ring_put_decode(sqids_ring_t *, const char *, size_t);
+
+/**
+ * wait for a ticket and copy its id (nul-terminated), returning its length
+ */
+int
+sqids_ring_get_encode(sqids_ring_t *, long long, char *, size_t);
+
+/**
+ * wait for a ticket and copy its numbers, returning their count
+ */
+int
+sqids_ring_get_decode(sqids_ring_t *, long long, unsigned long long *,
+    unsigned int);
+
+/**
+ * answer requests with a sqids structure until `sqids_ring_stop`
+ */
+int
+sqids_ring_serve(sqids_ring_t *, sqids_t *);
+
+/**
+ * make `sqids_ring_serve` return
+ */
+void
+sqids_ring_stop(sqids_ring_t *);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ registry stuff                                                        */
+/*****************************************************************************/
+
+/**
+ * registry of compiled sqids structures, interned by
+ * (alphabet, min_len, blocklist id)
+ */
+typedef struct sqids_registry_s sqids_registry_t;
+
+/**
+ * allocate a new registry
+ * least recently used entries are evicted once the registry holds more than
+ * `mem_max` bytes (0 means unlimited)
+ */
+sqids_registry_t *
+sqids_registry_new(size_t mem_max);
+
+/**
+ * free a registry (handles obtained from it stay valid)
+ */
+void
+sqids_registry_free(sqids_registry_t *);
+
+/**
+ * register a blocklist under an id (takes over the passed reference)
+ * id 0 is reserved for "no blocklist"
+ */
+int
+sqids_registry_bl_set(sqids_registry_t *, unsigned int, sqids_bl_t *);
+
+/**
+ * get a shared sqids structure, building it on first use
+ * the result is a new reference and should be released with `sqids_free`
+ */
+sqids_t *
+sqids_registry_get(sqids_registry_t *, const char *, unsigned int,
+    unsigned int);
+
+/* }}}                                                                       */
+
+/*****************************************************************************/
+/* {{{ snapshot stuff                                                        */
+/*****************************************************************************/
+
+#define SQIDS_SNAPSHOT_MAGIC    "SQIDSSN"
+#define SQIDS_SNAPSHOT_VERSION  2
+
+/**
+ * snapshot file header
+ * followed by the shuffled alphabet, the padding tables, the pruned blocklist view (word indexes, the top bit flagging
+ * words with digits) and a compiled blocklist, at 8-byte aligned offsets -
+ * all in host byte order, with no pointers
+ */
+struct sqids_snapshot_hdr_s {
+    char magic[8];
+    uint32_t version;
+    uint32_t order;             /* SQIDS_BL_FILE_ORDER, as written */
+    uint32_t len;
+    uint32_t min_len;
+    uint32_t bl_mask;
+    uint32_t pad_depth;
+    uint32_t flags;             /* SQIDS_SNAPSHOT_BLOCKLIST */
+    uint32_t view_cnt;
+    uint64_t alphabet;
+    uint64_t pad;
+    uint64_t view;              /* blocklist words the alphabet can spell */
+    uint64_t bl;
+    uint64_t bl_size;
+    uint64_t size;
+};
+typedef struct sqids_snapshot_hdr_s sqids_snapshot_hdr_t;
+
+#define SQIDS_SNAPSHOT_BLOCKLIST    0x01
+
+/**
+ * write a compiled sqids structure into a file, replacing it atomically
+ * blocklists must use the default match function
+ */
+int
+sqids_snapshot_write(sqids_t *, const char *);
+
+/**
+ * map a snapshot read-only and build a sqids structure using it in place
+ */
+sqids_t *
+sqids_snapshot_open(const char *);
 
 /* }}}                                                                       */
 
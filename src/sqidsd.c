@@ -0,0 +1,815 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* ppoll, accept4 */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "sqids.h"
+#include "strerror.h"
+#include "sqidsd.h"
+
+/* first read buffer of a connection */
+#define CONN_BUF (64 << 10)
+
+/* pending output above which a connection is not read from */
+#define CONN_OUT_HIGH (4u << 20)
+
+/* numbers per encoded item */
+#define ITEM_NUMS_MAX 1024
+
+/* a client connection, owned by one worker */
+struct conn_s {
+    int fd, eof;
+    unsigned int events;
+    char *in;
+    size_t in_len, in_size;
+    char *out;
+    size_t out_off, out_len, out_size;
+    struct conn_s *prev, *next;
+};
+
+/* a worker thread with its own event loop */
+struct worker_s {
+    pthread_t tid;
+    int epfd;
+    pthread_mutex_t lock;       /* guards the list, added to by the acceptor */
+    struct conn_s *conns;
+};
+
+static sqids_t **ctxs;
+static unsigned int ctx_cnt;
+static int stop_fd = -1;
+static volatile sig_atomic_t stop;
+
+static void
+usage(const char *progname, FILE *out)
+{
+    fputs("\n", out);
+    fputs("Usage:\n", out);
+    fprintf(out, "  %s [options]\n", progname);
+
+    fputs("\n", out);
+    fputs("Options:\n", out);
+    fputs("  -s, --socket              listen on this Unix socket "
+        "[/tmp/sqidsd.sock]\n", out);
+    fputs("  -j, --jobs                set number of worker threads "
+        "[cpus]\n", out);
+    fputs("  -a, --alphabet            set alphabet of context 0 ["
+        SQIDS_DEFAULT_ALPHABET "]\n", out);
+    fputs("  -l, --min-length          set hash minimum length of context 0 "
+        "(0-4096) [0]\n", out);
+    fputs("  -b, --default-blocklist   include a default blocklist in "
+        "context 0\n"
+        "                            (de,en,es,fr,hi,it,pt,none,all) "
+        "[all]\n", out);
+    fputs("  -B, --blocklist-file      use a blocklist compiled by "
+        "sqids-bl instead\n", out);
+    fputs("  -w, --block-word          add a word to the blocklist of "
+        "context 0\n", out);
+    fputs("  -S, --snapshot            add a context from a snapshot "
+        "file\n", out);
+    fputs("  -h, --help                print this message and exit\n", out);
+    fputs("  -v, --version             print version information and exit\n",
+        out);
+
+    fputs("\n", out);
+    exit(out == stderr ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+static unsigned long long
+parse_num(const char *s, char **p)
+{
+    int radix = 10;
+
+    if (*s == '0') {
+        radix = 8;
+        ++s;
+
+        if (*s == 'x' || *s == 'X') {
+            radix = 16;
+            ++s;
+        }
+    }
+
+    return strtoull(s, p, radix);
+}
+
+static void
+on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+/* make room for `n` more bytes */
+static int
+reserve(char **buf, size_t *size, size_t len, size_t n)
+{
+    size_t want = *size ? *size : CONN_BUF;
+    char *p;
+
+    while (want - len < n) {
+        want *= 2;
+    }
+
+    if (want != *size) {
+        if (!(p = realloc(*buf, want))) {
+            return -1;
+        }
+
+        *buf = p;
+        *size = want;
+    }
+
+    return 0;
+}
+
+/* encode the items of a request into `out`, returning the bytes written */
+static long
+serve_encode(sqids_t *sqids, const char *p, const char *end, uint32_t cnt,
+    struct conn_s *conn)
+{
+    unsigned long long nums[ITEM_NUMS_MAX];
+    size_t start = conn->out_len, need;
+    uint32_t i, j, num_cnt;
+    int r;
+
+    for (i = 0; i < cnt; ++i) {
+        if (end - p < 4 || (num_cnt = sqidsd_get_u32(p)) > ITEM_NUMS_MAX ||
+            (size_t)(end - p - 4) / 8 < num_cnt) {
+            return -1;
+        }
+
+        for (p += 4, j = 0; j < num_cnt; ++j, p += 8) {
+            nums[j] = sqidsd_get_u64(p);
+        }
+
+        need = sqids_encoded_len(sqids, num_cnt, nums);
+        if (conn->out_len - start + 4 + need > SQIDSD_FRAME_MAX) {
+            return -1;
+        }
+
+        if (reserve(&conn->out, &conn->out_size, conn->out_len,
+            4 + need + 1) != 0) {
+            return -1;
+        }
+
+        r = sqids_encode_buf(sqids, conn->out + conn->out_len + 4, num_cnt,
+            nums);
+        sqidsd_put_u32(conn->out + conn->out_len,
+            (uint32_t)(r < 0 ? -sqids_errno : r));
+        conn->out_len += 4 + (r < 0 ? 0 : r);
+    }
+
+    return p == end ? (long)(conn->out_len - start) : -1;
+}
+
+/* decode the items of a request into `out`, returning the bytes written */
+static long
+serve_decode(sqids_t *sqids, const char *p, const char *end, uint32_t cnt,
+    int canonical, struct conn_s *conn)
+{
+    unsigned long long nums[SQIDS_CANONICAL_MAX / 2 + 1];
+    size_t start = conn->out_len;
+    uint32_t i, len;
+    char *o;
+    int r, j;
+
+    for (i = 0; i < cnt; ++i) {
+        if (end - p < 4 || (size_t)(end - p - 4) < (len = sqidsd_get_u32(p))) {
+            return -1;
+        }
+        p += 4;
+
+        if (len > SQIDS_CANONICAL_MAX) {
+            sqids_errno = SQIDS_ERR_INVALID;
+            r = -1;
+        } else if (canonical) {
+            r = sqids_decode_canonical(sqids, p, len, nums, len / 2 + 1);
+        } else {
+            r = sqids_decode_len(sqids, p, len, nums, len / 2 + 1);
+        }
+        p += len;
+
+        if (conn->out_len - start + 4 + (r < 0 ? 0 : r) * 8ul >
+            SQIDSD_FRAME_MAX) {
+            return -1;
+        }
+
+        if (reserve(&conn->out, &conn->out_size, conn->out_len,
+            4 + (r < 0 ? 0 : r) * 8) != 0) {
+            return -1;
+        }
+
+        o = sqidsd_put_u32(conn->out + conn->out_len,
+            (uint32_t)(r < 0 ? -sqids_errno : r));
+        for (j = 0; j < r; ++j) {
+            o = sqidsd_put_u64(o, nums[j]);
+        }
+        conn->out_len = o - conn->out;
+    }
+
+    return p == end ? (long)(conn->out_len - start) : -1;
+}
+
+/* answer one request, appending the response to the output */
+static int
+serve(struct conn_s *conn, const sqidsd_req_t *req, const char *payload)
+{
+    sqidsd_res_t res;
+    size_t at;
+    long n = -1;
+
+    if (reserve(&conn->out, &conn->out_size, conn->out_len,
+        sizeof(res)) != 0) {
+        return -1;
+    }
+
+    /* the header goes in front once the length is known */
+    at = conn->out_len;
+    conn->out_len += sizeof(res);
+
+    res.seq = req->seq;
+    res.op = req->op;
+    res.status = 0;
+    res.cnt = req->cnt;
+
+    if (req->ctx >= ctx_cnt) {
+        res.status = SQIDSD_ERR_CTX;
+    } else if (req->op == SQIDSD_OP_ENCODE) {
+        n = serve_encode(ctxs[req->ctx], payload, payload + req->len,
+            req->cnt, conn);
+        res.status = n < 0 ? SQIDSD_ERR_PAYLOAD : 0;
+    } else if (req->op == SQIDSD_OP_DECODE ||
+        req->op == SQIDSD_OP_DECODE_CANONICAL) {
+        n = serve_decode(ctxs[req->ctx], payload, payload + req->len,
+            req->cnt, req->op == SQIDSD_OP_DECODE_CANONICAL, conn);
+        res.status = n < 0 ? SQIDSD_ERR_PAYLOAD : 0;
+    } else {
+        res.status = SQIDSD_ERR_OP;
+    }
+
+    /* failed requests get an empty response */
+    if (res.status) {
+        conn->out_len = at + sizeof(res);
+        res.cnt = 0;
+        n = 0;
+    }
+
+    res.len = n;
+    memcpy(conn->out + at, &res, sizeof(res));
+
+    return 0;
+}
+
+/* answer the complete requests read so far, while output is not backed up */
+static int
+conn_process(struct conn_s *conn)
+{
+    sqidsd_req_t req;
+    size_t pos = 0;
+
+    while (conn->in_len - pos >= sizeof(req) &&
+        conn->out_len - conn->out_off < CONN_OUT_HIGH) {
+        memcpy(&req, conn->in + pos, sizeof(req));
+        if (req.len > SQIDSD_FRAME_MAX) {
+            return -1;
+        }
+
+        if (conn->in_len - pos - sizeof(req) < req.len) {
+            break;
+        }
+
+        if (serve(conn, &req, conn->in + pos + sizeof(req)) != 0) {
+            return -1;
+        }
+
+        pos += sizeof(req) + req.len;
+    }
+
+    memmove(conn->in, conn->in + pos, conn->in_len - pos);
+    conn->in_len -= pos;
+
+    return 0;
+}
+
+/* read what is there */
+static int
+conn_read(struct conn_s *conn)
+{
+    ssize_t r;
+
+    for (;;) {
+        if (reserve(&conn->in, &conn->in_size, conn->in_len, 4096) != 0) {
+            return -1;
+        }
+
+        if ((r = read(conn->fd, conn->in + conn->in_len,
+            conn->in_size - conn->in_len)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+
+        /* the client is done sending, answer what it sent */
+        if (!r) {
+            conn->eof = 1;
+            return 0;
+        }
+
+        conn->in_len += r;
+
+        if (conn->in_len < conn->in_size) {
+            return 0;
+        }
+    }
+}
+
+/* write what the socket takes */
+static int
+conn_write(struct conn_s *conn)
+{
+    ssize_t r;
+
+    while (conn->out_off < conn->out_len) {
+        if ((r = send(conn->fd, conn->out + conn->out_off,
+            conn->out_len - conn->out_off, MSG_NOSIGNAL)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+
+        conn->out_off += r;
+    }
+
+    conn->out_off = conn->out_len = 0;
+
+    return 0;
+}
+
+/* read while output is not backed up, wait for writes while there is some */
+static int
+conn_events(struct worker_s *worker, struct conn_s *conn)
+{
+    struct epoll_event ev;
+    unsigned int events = 0;
+
+    /* after the last response to a closed client, close too */
+    if (conn->eof && conn->out_off == conn->out_len) {
+        return -1;
+    }
+
+    if (!conn->eof && conn->out_len - conn->out_off < CONN_OUT_HIGH) {
+        events |= EPOLLIN;
+    }
+
+    if (conn->out_off < conn->out_len) {
+        events |= EPOLLOUT;
+    }
+
+    if (events == conn->events) {
+        return 0;
+    }
+
+    ev.events = events;
+    ev.data.ptr = conn;
+    conn->events = events;
+
+    return epoll_ctl(worker->epfd, EPOLL_CTL_MOD, conn->fd, &ev);
+}
+
+static void
+conn_close(struct worker_s *worker, struct conn_s *conn)
+{
+    epoll_ctl(worker->epfd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+
+    pthread_mutex_lock(&worker->lock);
+    if (conn->prev) {
+        conn->prev->next = conn->next;
+    } else {
+        worker->conns = conn->next;
+    }
+
+    if (conn->next) {
+        conn->next->prev = conn->prev;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    free(conn->in);
+    free(conn->out);
+    free(conn);
+}
+
+/* hand a new connection to a worker */
+static int
+conn_add(struct worker_s *worker, int fd)
+{
+    struct epoll_event ev;
+    struct conn_s *conn;
+
+    if (!(conn = calloc(1, sizeof(struct conn_s)))) {
+        return -1;
+    }
+
+    conn->fd = fd;
+    conn->events = EPOLLIN;
+
+    ev.events = EPOLLIN;
+    ev.data.ptr = conn;
+
+    /* linked before the worker can see it */
+    pthread_mutex_lock(&worker->lock);
+    conn->next = worker->conns;
+    if (conn->next) {
+        conn->next->prev = conn;
+    }
+    worker->conns = conn;
+
+    if (epoll_ctl(worker->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        worker->conns = conn->next;
+        if (conn->next) {
+            conn->next->prev = NULL;
+        }
+        pthread_mutex_unlock(&worker->lock);
+        free(conn);
+        return -1;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return 0;
+}
+
+static void *
+worker_run(void *arg)
+{
+    struct worker_s *worker = arg;
+    struct epoll_event evs[64];
+    struct conn_s *conn;
+    int i, n, err;
+
+    for (;;) {
+        if ((n = epoll_wait(worker->epfd, evs, 64, -1)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        for (i = 0; i < n; ++i) {
+            /* shutting down */
+            if (!(conn = evs[i].data.ptr)) {
+                return NULL;
+            }
+
+            err = evs[i].events & EPOLLERR;
+
+            if (!err && evs[i].events & EPOLLOUT) {
+                err = conn_write(conn) != 0 || conn_process(conn) != 0;
+            }
+
+            if (!err && evs[i].events & (EPOLLIN | EPOLLHUP)) {
+                err = conn_read(conn) != 0 || conn_process(conn) != 0;
+            }
+
+            /* most responses go out right away */
+            if (!err) {
+                err = conn_write(conn) != 0 || conn_events(worker, conn) != 0;
+            }
+
+            if (err) {
+                conn_close(worker, conn);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* context 0, built the way the sqids cli builds its structure */
+static sqids_t *
+ctx_new(const char *alphabet, int min_len, const char *bl_name,
+    const char *bl_file, char **words, int word_cnt)
+{
+    sqids_bl_t *blocklist = NULL, *shared;
+    sqids_t *sqids;
+    int i;
+
+    if (bl_file) {
+        if (!(blocklist = sqids_bl_load_mmap(bl_file, NULL))) {
+            fprintf(stderr, "sqids_bl_load_mmap(%s): %s\n", bl_file,
+                sqids_strerror(sqids_errno));
+            return NULL;
+        }
+    } else if (strcmp(bl_name, "none") != 0) {
+        if (!(blocklist = sqids_bl_default(bl_name))) {
+            fprintf(stderr, "sqids_bl_default(%s): %s\n", bl_name,
+                sqids_strerror(sqids_errno));
+            return NULL;
+        }
+    }
+
+    if (word_cnt) {
+        shared = blocklist;
+        blocklist = shared ? sqids_bl_dup(shared) : sqids_bl_new(NULL);
+
+        if (shared) {
+            sqids_bl_free(shared);
+        }
+
+        for (i = 0; blocklist && i < word_cnt; ++i) {
+            if (!sqids_bl_add_tail(blocklist, words[i])) {
+                sqids_bl_free(blocklist);
+                blocklist = NULL;
+            }
+        }
+
+        if (!blocklist) {
+            fprintf(stderr, "sqids_bl_add_tail(): %s\n",
+                sqids_strerror(sqids_errno));
+            return NULL;
+        }
+    }
+
+    if (!(sqids = sqids_new(alphabet, min_len, blocklist))) {
+        fprintf(stderr, "sqids_new(): %s\n", sqids_strerror(sqids_errno));
+        if (blocklist) {
+            sqids_bl_free(blocklist);
+        }
+    }
+
+    return sqids;
+}
+
+/* bind a listening socket, replacing a stale one */
+static int
+listen_on(const char *path)
+{
+    struct sockaddr_un addr;
+    struct stat st;
+    int fd, probe;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "--socket: path too long \"%s\"\n", path);
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    /* nobody answering means a previous run left it behind */
+    if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        if ((probe = socket(AF_UNIX, SOCK_STREAM, 0)) >= 0) {
+            if (connect(probe, (struct sockaddr *)&addr, sizeof(addr)) != 0 &&
+                errno == ECONNREFUSED) {
+                unlink(path);
+            }
+            close(probe);
+        }
+    }
+
+    if ((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+        0)) < 0) {
+        fprintf(stderr, "socket(): %s\n", strerror(errno));
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "bind(%s): %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int
+main(int argc, char **argv)
+{
+    char *alphabet = SQIDS_DEFAULT_ALPHABET, *bl_name = "all", *p;
+    char *bl_file = NULL, *path = "/tmp/sqidsd.sock";
+    char *words[argc], *snapshots[argc];
+    int min_len = 0, word_cnt = 0, snapshot_cnt = 0, ch, fd, lfd, r = 0;
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    struct worker_s *workers = NULL;
+    struct epoll_event ev;
+    struct sigaction sa;
+    struct pollfd pfd;
+    sigset_t mask, orig;
+    unsigned int i, started = 0, next = 0;
+    uint64_t one = 1;
+
+    static const struct option longopts[] = {
+        {"socket", required_argument, NULL, 's'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"alphabet", required_argument, NULL, 'a'},
+        {"min-length", required_argument, NULL, 'l'},
+        {"default-blocklist", required_argument, NULL, 'b'},
+        {"blocklist-file", required_argument, NULL, 'B'},
+        {"block-word", required_argument, NULL, 'w'},
+        {"snapshot", required_argument, NULL, 'S'},
+        {"help", no_argument, NULL, 'h'},
+        {"version", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    /* parse command line options */
+    while ((ch = getopt_long(argc, argv, "s:j:a:l:b:B:w:S:hv", longopts,
+        NULL)) != -1) {
+        switch (ch) {
+            case 's':
+                path = optarg;
+                break;
+            case 'j':
+                jobs = parse_num(optarg, &p);
+                if (p == optarg || *p || jobs < 1 || jobs > 1024) {
+                    fprintf(stderr, "--jobs: invalid value \"%s\"\n",
+                        optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'a':
+                alphabet = optarg;
+                break;
+            case 'l':
+                min_len = parse_num(optarg, &p);
+                if (p == optarg || min_len < 0 ||
+                    min_len > SQIDS_CANONICAL_MAX) {
+                    fprintf(stderr, "--min-length: invalid value \"%s\"\n",
+                        optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'b':
+                bl_name = optarg;
+                break;
+            case 'B':
+                bl_file = optarg;
+                break;
+            case 'w':
+                words[word_cnt++] = optarg;
+                break;
+            case 'S':
+                snapshots[snapshot_cnt++] = optarg;
+                break;
+            case 'h':
+                usage(argv[0], stdout);
+                break;
+            case 'v':
+                fputs(SQIDS_VERSION_STRING, stdout);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0], stderr);
+        }
+    }
+
+    if (optind != argc || snapshot_cnt >= 0xFFFF) {
+        usage(argv[0], stderr);
+    }
+
+    jobs = jobs < 1 ? 1 : jobs;
+
+    /* load every context once */
+    if (!(ctxs = calloc(snapshot_cnt + 1, sizeof(sqids_t *)))) {
+        fputs("calloc(): out of memory\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    if (!(ctxs[ctx_cnt++] = ctx_new(alphabet, min_len, bl_name, bl_file,
+        words, word_cnt))) {
+        r = -1;
+    }
+
+    for (ch = 0; r == 0 && ch < snapshot_cnt; ++ch) {
+        if (!(ctxs[ctx_cnt++] = sqids_snapshot_open(snapshots[ch]))) {
+            fprintf(stderr, "sqids_snapshot_open(%s): %s\n", snapshots[ch],
+                sqids_strerror(sqids_errno));
+            r = -1;
+        } else if (ctxs[ctx_cnt - 1]->min_len > SQIDS_CANONICAL_MAX) {
+            /* ids are served up to this length only */
+            fprintf(stderr, "sqids_snapshot_open(%s): min_len above %d\n",
+                snapshots[ch], SQIDS_CANONICAL_MAX);
+            r = -1;
+        }
+    }
+
+    /* signals only interrupt the accept loop */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, &orig);
+
+    lfd = r == 0 ? listen_on(path) : -1;
+    r = lfd < 0 ? -1 : r;
+
+    if (r == 0 && ((stop_fd = eventfd(0, EFD_CLOEXEC)) < 0 ||
+        !(workers = calloc(jobs, sizeof(struct worker_s))))) {
+        fputs("eventfd(): error\n", stderr);
+        r = -1;
+    }
+
+    for (; r == 0 && started < jobs; ++started) {
+        if ((workers[started].epfd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+            r = -1;
+            break;
+        }
+
+        pthread_mutex_init(&workers[started].lock, NULL);
+
+        ev.events = EPOLLIN;
+        ev.data.ptr = NULL;
+        if (epoll_ctl(workers[started].epfd, EPOLL_CTL_ADD, stop_fd,
+            &ev) != 0 || pthread_create(&workers[started].tid, NULL,
+            worker_run, &workers[started]) != 0) {
+            close(workers[started].epfd);
+            pthread_mutex_destroy(&workers[started].lock);
+            r = -1;
+            break;
+        }
+    }
+
+    if (r != 0 && lfd >= 0) {
+        fputs("worker setup failed\n", stderr);
+    }
+
+    /* accept until told to stop, connections go round robin */
+    pfd.fd = lfd;
+    pfd.events = POLLIN;
+    while (r == 0 && !stop) {
+        if (ppoll(&pfd, 1, NULL, &orig) < 0) {
+            continue;
+        }
+
+        while ((fd = accept4(lfd, NULL, NULL,
+            SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+            if (conn_add(&workers[next++ % jobs], fd) != 0) {
+                close(fd);
+            }
+        }
+    }
+
+    /* wake and join every worker, which drops its connections */
+    if (stop_fd >= 0 && write(stop_fd, &one, sizeof(one)) < 0) {
+        fputs("write(): cannot stop workers\n", stderr);
+    }
+
+    for (i = 0; i < started; ++i) {
+        pthread_join(workers[i].tid, NULL);
+
+        while (workers[i].conns) {
+            conn_close(&workers[i], workers[i].conns);
+        }
+        close(workers[i].epfd);
+        pthread_mutex_destroy(&workers[i].lock);
+    }
+    free(workers);
+
+    if (lfd >= 0) {
+        close(lfd);
+        unlink(path);
+    }
+
+    if (stop_fd >= 0) {
+        close(stop_fd);
+    }
+
+    for (i = 0; i < ctx_cnt; ++i) {
+        if (ctxs[i]) {
+            sqids_free(ctxs[i]);
+        }
+    }
+    free(ctxs);
+
+    return r == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
@@ -0,0 +1,108 @@
+#ifndef SQIDSD_H
+#define SQIDSD_H 1
+
+#include <stdint.h>
+#include <string.h>
+
+/*****************************************************************************/
+/* {{{ protocol stuff                                                        */
+/*****************************************************************************/
+
+/*
+ * sqidsd speaks length-prefixed frames over a Unix stream socket, in host
+ * byte order (both ends live on the same machine)
+ *
+ * a request is a header followed by `len` bytes holding `cnt` items:
+ *   encode: uint32 num_cnt, then num_cnt uint64 numbers
+ *   decode: uint32 id length, then the id
+ *
+ * a response echoes `seq` and `op`, followed by `len` bytes holding one
+ * result per item:
+ *   encode: int32 id length, then the id
+ *   decode: int32 num_cnt, then num_cnt uint64 numbers
+ * a negative result is the `sqids_errno` of that item, negated
+ *
+ * requests may be pipelined, responses come back in request order
+ */
+
+#define SQIDSD_OP_ENCODE            1
+#define SQIDSD_OP_DECODE            2
+#define SQIDSD_OP_DECODE_CANONICAL  3
+
+/* frame statuses, besides 0 */
+#define SQIDSD_ERR_OP               1   /* unknown op */
+#define SQIDSD_ERR_CTX              2   /* unknown context */
+#define SQIDSD_ERR_PAYLOAD          3   /* items do not match the payload,
+                                           or the response is too large */
+
+/* largest payload either way, bigger requests close the connection */
+#define SQIDSD_FRAME_MAX (16u << 20)
+
+/**
+ * request header
+ */
+struct sqidsd_req_s {
+    uint32_t len;
+    uint32_t seq;
+    uint16_t op;
+    uint16_t ctx;
+    uint32_t cnt;
+};
+typedef struct sqidsd_req_s sqidsd_req_t;
+
+/**
+ * response header
+ */
+struct sqidsd_res_s {
+    uint32_t len;
+    uint32_t seq;
+    uint16_t op;
+    uint16_t status;
+    uint32_t cnt;
+};
+typedef struct sqidsd_res_s sqidsd_res_t;
+
+/**
+ * unaligned payload access
+ */
+static inline uint32_t
+sqidsd_get_u32(const char *p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+static inline uint64_t
+sqidsd_get_u64(const char *p)
+{
+    uint64_t v;
+
+    memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+static inline char *
+sqidsd_put_u32(char *p, uint32_t v)
+{
+    memcpy(p, &v, sizeof(v));
+
+    return p + sizeof(v);
+}
+
+static inline char *
+sqidsd_put_u64(char *p, uint64_t v)
+{
+    memcpy(p, &v, sizeof(v));
+
+    return p + sizeof(v);
+}
+
+/* }}}                                                                       */
+
+#endif /* !defined(SQIDSD_H) */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
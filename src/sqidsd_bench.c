@@ -0,0 +1,396 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "sqids.h"
+#include "sqidsd.h"
+
+/* what every connection does */
+struct bench_s {
+    const char *path;
+    unsigned int frames, batch, depth, nums, ctx;
+    int op;
+};
+
+/* one connection */
+struct client_s {
+    pthread_t tid;
+    unsigned int id;
+    const struct bench_s *bench;
+    unsigned long long *lat;    /* per response, in nanoseconds */
+    unsigned long long ids;
+    int err;
+};
+
+static void
+usage(const char *progname, FILE *out)
+{
+    fputs("\n", out);
+    fputs("Usage:\n", out);
+    fprintf(out, "  %s [options]\n", progname);
+
+    fputs("\n", out);
+    fputs("Options:\n", out);
+    fputs("  -s, --socket              connect to this Unix socket "
+        "[/tmp/sqidsd.sock]\n", out);
+    fputs("  -c, --connections         set number of connections, one "
+        "thread each [1]\n", out);
+    fputs("  -n, --frames              set number of requests per "
+        "connection [10000]\n", out);
+    fputs("  -b, --batch               set number of items per request "
+        "[100]\n", out);
+    fputs("  -p, --pipeline            set number of requests in flight "
+        "per connection [8]\n", out);
+    fputs("  -k, --numbers             set number of numbers per id [1]\n",
+        out);
+    fputs("  -x, --context             set context [0]\n", out);
+    fputs("  -d, --decode              decode instead of encode\n", out);
+    fputs("  -h, --help                print this message and exit\n", out);
+    fputs("  -v, --version             print version information and exit\n",
+        out);
+
+    fputs("\n", out);
+    exit(out == stderr ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+static unsigned long long
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int
+send_all(int fd, const char *p, size_t n)
+{
+    ssize_t r;
+
+    while (n) {
+        if ((r = send(fd, p, n, MSG_NOSIGNAL)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        p += r;
+        n -= r;
+    }
+
+    return 0;
+}
+
+static int
+recv_all(int fd, char *p, size_t n)
+{
+    ssize_t r;
+
+    while (n) {
+        if ((r = recv(fd, p, n, 0)) <= 0) {
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        p += r;
+        n -= r;
+    }
+
+    return 0;
+}
+
+/* read one response, its payload into `buf` */
+static int
+recv_res(int fd, sqidsd_res_t *res, char *buf)
+{
+    if (recv_all(fd, (char *)res, sizeof(*res)) != 0 ||
+        res->len > SQIDSD_FRAME_MAX) {
+        return -1;
+    }
+
+    return recv_all(fd, buf, res->len);
+}
+
+/* a request of `batch` tuples, `nums` numbers each */
+static size_t
+build_encode(const struct bench_s *bench, unsigned int id, char *frame)
+{
+    sqidsd_req_t req;
+    unsigned int i, j;
+    char *p = frame + sizeof(req);
+
+    for (i = 0; i < bench->batch; ++i) {
+        p = sqidsd_put_u32(p, bench->nums);
+        for (j = 0; j < bench->nums; ++j) {
+            p = sqidsd_put_u64(p, ((unsigned long long)id << 32 | i) *
+                0x9E3779B97F4A7C15ull >> (j * 5 + 16));
+        }
+    }
+
+    req.len = p - frame - sizeof(req);
+    req.seq = 0;
+    req.op = SQIDSD_OP_ENCODE;
+    req.ctx = bench->ctx;
+    req.cnt = bench->batch;
+    memcpy(frame, &req, sizeof(req));
+
+    return p - frame;
+}
+
+/* a request decoding the ids of an encode response */
+static size_t
+build_decode(const struct bench_s *bench, const char *res, char *frame)
+{
+    sqidsd_req_t req;
+    unsigned int i;
+    int32_t len;
+    char *p = frame + sizeof(req);
+
+    for (i = 0; i < bench->batch; ++i) {
+        if ((len = (int32_t)sqidsd_get_u32(res)) < 0) {
+            return 0;
+        }
+
+        p = sqidsd_put_u32(p, len);
+        memcpy(p, res + 4, len);
+        p += len;
+        res += 4 + len;
+    }
+
+    req.len = p - frame - sizeof(req);
+    req.seq = 0;
+    req.op = SQIDSD_OP_DECODE;
+    req.ctx = bench->ctx;
+    req.cnt = bench->batch;
+    memcpy(frame, &req, sizeof(req));
+
+    return p - frame;
+}
+
+static void *
+client_run(void *arg)
+{
+    struct client_s *client = arg;
+    const struct bench_s *bench = client->bench;
+    struct sockaddr_un addr;
+    unsigned long long sent[bench->depth];
+    sqidsd_res_t res;
+    sqidsd_req_t req;
+    size_t len, size;
+    char *frame = NULL, *buf = NULL;
+    unsigned int out = 0, in = 0;
+    int fd;
+
+    client->err = -1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, bench->path, sizeof(addr.sun_path) - 1);
+
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 ||
+        connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "connect(%s): %s\n", bench->path, strerror(errno));
+        goto done;
+    }
+
+    size = sizeof(req) + (size_t)bench->batch * (4 + 8 * bench->nums);
+    if (!(frame = malloc(size)) || !(buf = malloc(SQIDSD_FRAME_MAX))) {
+        fputs("malloc(): out of memory\n", stderr);
+        goto done;
+    }
+
+    len = build_encode(bench, client->id, frame);
+
+    /* ids to decode come from the daemon itself */
+    if (bench->op == SQIDSD_OP_DECODE) {
+        if (send_all(fd, frame, len) != 0 || recv_res(fd, &res, buf) != 0 ||
+            res.status || !(frame = realloc(frame, sizeof(req) + res.len)) ||
+            !(len = build_decode(bench, buf, frame))) {
+            fputs("sqidsd: cannot get ids to decode\n", stderr);
+            goto done;
+        }
+    }
+
+    /* keep `depth` requests in flight */
+    while (in < bench->frames) {
+        while (out < bench->frames && out - in < bench->depth) {
+            memcpy(&req, frame, sizeof(req));
+            req.seq = out;
+            memcpy(frame, &req, sizeof(req));
+
+            sent[out % bench->depth] = now_ns();
+            if (send_all(fd, frame, len) != 0) {
+                fputs("send(): error\n", stderr);
+                goto done;
+            }
+            ++out;
+        }
+
+        if (recv_res(fd, &res, buf) != 0 || res.seq != in || res.status ||
+            res.cnt != bench->batch) {
+            fputs("sqidsd: bad response\n", stderr);
+            goto done;
+        }
+
+        client->lat[in] = now_ns() - sent[in % bench->depth];
+        client->ids += res.cnt;
+        ++in;
+    }
+
+    client->err = 0;
+
+done:
+    if (fd >= 0) {
+        close(fd);
+    }
+    free(frame);
+    free(buf);
+
+    return NULL;
+}
+
+static int
+cmp_ull(const void *a, const void *b)
+{
+    unsigned long long x = *(const unsigned long long *)a;
+    unsigned long long y = *(const unsigned long long *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+int
+main(int argc, char **argv)
+{
+    struct bench_s bench = {"/tmp/sqidsd.sock", 10000, 100, 8, 1, 0,
+        SQIDSD_OP_ENCODE};
+    unsigned long long *lat, ids = 0, start, elapsed, n;
+    unsigned int conns = 1, i;
+    struct client_s *clients;
+    char *p;
+    int ch, err = 0;
+
+    static const struct option longopts[] = {
+        {"socket", required_argument, NULL, 's'},
+        {"connections", required_argument, NULL, 'c'},
+        {"frames", required_argument, NULL, 'n'},
+        {"batch", required_argument, NULL, 'b'},
+        {"pipeline", required_argument, NULL, 'p'},
+        {"numbers", required_argument, NULL, 'k'},
+        {"context", required_argument, NULL, 'x'},
+        {"decode", no_argument, NULL, 'd'},
+        {"help", no_argument, NULL, 'h'},
+        {"version", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    /* parse command line options */
+    while ((ch = getopt_long(argc, argv, "s:c:n:b:p:k:x:dhv", longopts,
+        NULL)) != -1) {
+        switch (ch) {
+            case 's':
+                bench.path = optarg;
+                break;
+            case 'c':
+                conns = strtoul(optarg, &p, 10);
+                err |= *p || !conns || conns > 4096;
+                break;
+            case 'n':
+                bench.frames = strtoul(optarg, &p, 10);
+                err |= *p || !bench.frames;
+                break;
+            case 'b':
+                bench.batch = strtoul(optarg, &p, 10);
+                err |= *p || !bench.batch || bench.batch > 65536;
+                break;
+            case 'p':
+                bench.depth = strtoul(optarg, &p, 10);
+                err |= *p || !bench.depth || bench.depth > 1024;
+                break;
+            case 'k':
+                bench.nums = strtoul(optarg, &p, 10);
+                err |= *p || !bench.nums || bench.nums > 32;
+                break;
+            case 'x':
+                bench.ctx = strtoul(optarg, &p, 10);
+                err |= *p || bench.ctx > 0xFFFF;
+                break;
+            case 'd':
+                bench.op = SQIDSD_OP_DECODE;
+                break;
+            case 'h':
+                usage(argv[0], stdout);
+                break;
+            case 'v':
+                fputs(SQIDS_VERSION_STRING, stdout);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0], stderr);
+        }
+
+        if (err) {
+            fprintf(stderr, "-%c: invalid value \"%s\"\n", ch, optarg);
+            return EXIT_FAILURE;
+        }
+    }
+
+    n = (unsigned long long)conns * bench.frames;
+    if (!(clients = calloc(conns, sizeof(struct client_s))) ||
+        !(lat = malloc(n * sizeof(unsigned long long)))) {
+        fputs("malloc(): out of memory\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    start = now_ns();
+    for (i = 0; i < conns; ++i) {
+        clients[i].id = i;
+        clients[i].bench = &bench;
+        clients[i].lat = lat + (unsigned long long)i * bench.frames;
+        if (pthread_create(&clients[i].tid, NULL, client_run,
+            &clients[i]) != 0) {
+            fputs("pthread_create(): error\n", stderr);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (i = 0; i < conns; ++i) {
+        pthread_join(clients[i].tid, NULL);
+        err |= clients[i].err;
+        ids += clients[i].ids;
+    }
+    elapsed = now_ns() - start;
+
+    if (!err) {
+        qsort(lat, n, sizeof(unsigned long long), cmp_ull);
+
+        printf("%s: %u connections, %u x %u items, %u in flight\n",
+            bench.op == SQIDSD_OP_ENCODE ? "encode" : "decode", conns,
+            bench.frames, bench.batch, bench.depth);
+        printf("  %.0f ids/s, %.0f requests/s\n", ids * 1e9 / elapsed,
+            n * 1e9 / elapsed);
+        printf("  latency us: p50 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+            lat[n / 2] / 1e3, lat[n * 99 / 100] / 1e3,
+            lat[n * 999 / 1000] / 1e3, lat[n - 1] / 1e3);
+    }
+
+    free(lat);
+    free(clients);
+
+    return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
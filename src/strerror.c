@@ -0,0 +1,35 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "sqids.h"
+#include "strerror.h"
+
+/*****************************************************************************/
+/* {{{ error stuff                                                           */
+/*****************************************************************************/
+
+/* describe a `sqids_errno` value */
+char *
+sqids_strerror(int e)
+{
+    switch (e) {
+        case SQIDS_ERR_ALLOC:       return "out of memory";
+        case SQIDS_ERR_ALPHABET:    return "alphabet is too short";
+        case SQIDS_ERR_MAX_RETRIES: return "max retries reached";
+        case SQIDS_ERR_INVALID:     return "invalid hash";
+        case SQIDS_ERR_OVERFLOW:    return "integer overflow";
+        case SQIDS_ERR_IMMUTABLE:   return "blocklist is shared";
+        case SQIDS_ERR_NOENT:       return "no such blocklist";
+        case SQIDS_ERR_NONCANONICAL: return "non-canonical hash";
+        case SQIDS_ERR_NOSPACE:     return "buffer too small";
+        case SQIDS_ERR_IO:          return "i/o error";
+        case SQIDS_ERR_FORMAT:      return "invalid file format";
+        case SQIDS_ERR_BUSY:        return "ring is full";
+        default: return "unknown error";
+    }
+}
+
+/* }}}                                                                       */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
@@ -0,0 +1,22 @@
+#ifndef SQIDS_STRERROR_H
+#define SQIDS_STRERROR_H 1
+
+/*****************************************************************************/
+/* {{{ error stuff                                                           */
+/*****************************************************************************/
+
+/*
+ * shared by the command line tools, not part of the library
+ */
+
+/**
+ * describe a `sqids_errno` value
+ */
+char *
+sqids_strerror(int);
+
+/* }}}                                                                       */
+
+#endif /* !defined(SQIDS_STRERROR_H) */
+
+/* vim: set fen fdm=marker fmr={{{,}}} fdl=0 fdc=1 ts=4 sts=4 sw=4 et: */
@@ -0,0 +1,171 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sqids.h"
+
+#ifndef lengthof
+#define lengthof(x) ((size_t)(sizeof(x) / sizeof(x[0])))
+#endif
+
+/* rows: 0, null, 1, 9, null, 3 */
+uint8_t sqids_arrow_test_validity[] = {0x2D};
+uint64_t sqids_arrow_test_values[] = {0, 12345, 1, 9, 0, 3};
+char *sqids_arrow_test_exp[] = {"bM", NULL, "Uk", "nJ", NULL, "Ef"};
+
+char *sqids_arrow_failures[8] = {};
+
+int
+main(int argc, char **argv)
+{
+    size_t i, n = lengthof(sqids_arrow_test_values), size;
+    int j, r;
+    sqids_t *sqids, *long_sqids;
+    uint8_t enc_validity[1], dec_validity[1];
+    int32_t enc_offsets[lengthof(sqids_arrow_test_values) + 1];
+    int32_t dec_offsets[lengthof(sqids_arrow_test_values) + 1];
+    int32_t big_offsets[2];
+    uint64_t dec_values[64], *big_values;
+    char data[64], *err, *big;
+
+    j = 0;
+    sqids = sqids_new(NULL, 0, sqids_bl_list_all(NULL));
+
+    /* encode a column with nulls */
+    size = sqids_arrow_encoded_size(sqids, n, sqids_arrow_test_validity,
+        sqids_arrow_test_values);
+    r = sqids_arrow_encode(sqids, n, sqids_arrow_test_validity,
+        sqids_arrow_test_values, enc_validity, enc_offsets, data, size);
+
+    for (i = 0; r == 0 && i < n; ++i) {
+        if (!sqids_arrow_test_exp[i]) {
+            r = (enc_validity[0] >> i) & 1 ||
+                enc_offsets[i + 1] != enc_offsets[i];
+        } else {
+            r = !((enc_validity[0] >> i) & 1) ||
+                enc_offsets[i + 1] - enc_offsets[i] !=
+                    strlen(sqids_arrow_test_exp[i]) ||
+                memcmp(data + enc_offsets[i], sqids_arrow_test_exp[i],
+                    enc_offsets[i + 1] - enc_offsets[i]) != 0;
+        }
+    }
+
+    if (r == 0 && enc_offsets[n] == size) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_arrow_encode(...)\n"
+            "  expected: bM,null,Uk,nJ,null,Ef\n"
+            "       got: mismatch at row %d\n",
+            __FILE__,
+            __LINE__,
+            (int)i - 1);
+        sqids_arrow_failures[j++] = err;
+    }
+
+    /* too small data buffer */
+    r = sqids_arrow_encode(sqids, n, sqids_arrow_test_validity,
+        sqids_arrow_test_values, enc_validity, enc_offsets, data, size - 1);
+
+    if (r == -1 && sqids_errno == SQIDS_ERR_NOSPACE) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_arrow_encode(...) into a short buffer\n"
+            "  expected: SQIDS_ERR_NOSPACE\n",
+            __FILE__,
+            __LINE__);
+        sqids_arrow_failures[j++] = err;
+    }
+
+    /* decode it back, corrupting one row into an invalid hash */
+    sqids_arrow_encode(sqids, n, sqids_arrow_test_validity,
+        sqids_arrow_test_values, enc_validity, enc_offsets, data, size);
+    data[enc_offsets[3]] = '-';
+    r = sqids_arrow_decode(sqids, n, enc_validity, enc_offsets, data,
+        dec_validity, dec_offsets, dec_values, lengthof(dec_values));
+
+    if (r == 0 && (dec_validity[0] & 0x3F) == 0x25 && dec_offsets[n] == 3 &&
+        dec_values[0] == 0 && dec_values[1] == 1 && dec_values[2] == 3) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_arrow_decode(...)\n"
+            "  expected: [0],null,[1],null,null,[3]\n"
+            "       got: validity 0x%02X, %d values\n",
+            __FILE__,
+            __LINE__,
+            dec_validity[0] & 0x3F,
+            dec_offsets[n]);
+        sqids_arrow_failures[j++] = err;
+    }
+
+    /* ids padded beyond canonical ones round-trip too, the last one
+       through scratch space as its terminator doesn't fit */
+    long_sqids = sqids_new(NULL, SQIDS_CANONICAL_MAX + 904, NULL);
+    size = sqids_arrow_encoded_size(long_sqids, 1, NULL,
+        sqids_arrow_test_values + 3);
+    big = malloc(size);
+    big_values = malloc((size / 2 + 1) * sizeof(*big_values));
+    r = sqids_arrow_encode(long_sqids, 1, NULL, sqids_arrow_test_values + 3,
+        NULL, big_offsets, big, size);
+    r = r || sqids_arrow_decode(long_sqids, 1, NULL, big_offsets, big,
+        dec_validity, dec_offsets, big_values, size / 2 + 1);
+    dec_values[0] = r ? 0 : big_values[0];
+    free(big_values);
+    free(big);
+    sqids_free(long_sqids);
+
+    if (r == 0 && big_offsets[1] == SQIDS_CANONICAL_MAX + 904 &&
+        (dec_validity[0] & 1) && dec_offsets[1] == 1 && dec_values[0] == 9) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_arrow_encode(...) and sqids_arrow_decode(...) with "
+            "min_len %d\n"
+            "  expected: [9]\n",
+            __FILE__,
+            __LINE__,
+            SQIDS_CANONICAL_MAX + 904);
+        sqids_arrow_failures[j++] = err;
+    }
+
+    sqids_free(sqids);
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_arrow_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_arrow_failures[i], stderr);
+        free(sqids_arrow_failures[i]);
+    }
+
+    return j;
+}
@@ -0,0 +1,144 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sqids.h"
+
+#ifndef lengthof
+#define lengthof(x) ((size_t)(sizeof(x) / sizeof(x[0])))
+#endif
+
+#define SQIDS_BATCH_TEST_N 10003
+#define SQIDS_BATCH_TEST_STRIDE 40
+
+struct sqids_batch_test_s {
+    char *alphabet;
+    unsigned int min_len;
+    int blocklist;
+    int line;
+};
+typedef struct sqids_batch_test_s sqids_batch_test_t;
+
+sqids_batch_test_t sqids_batch_tests[] = {
+    {NULL, 0, 1, __LINE__},
+    {NULL, 16, 1, __LINE__},
+    {NULL, 0, 0, __LINE__},
+    {"0123456789abcdef", 8, 0, __LINE__},
+    {"abcde", 0, 0, __LINE__},
+    {NULL, 0, 0, 0},
+};
+
+char *sqids_batch_failures[lengthof(sqids_batch_tests) + 1] = {};
+
+char sqids_batch_test_out[SQIDS_BATCH_TEST_N * SQIDS_BATCH_TEST_STRIDE];
+unsigned long long sqids_batch_test_nums[SQIDS_BATCH_TEST_N];
+
+int
+main(int argc, char **argv)
+{
+    int i, j, k, r;
+    sqids_batch_test_t *test;
+    sqids_t *sqids;
+    char *exp, *got, *err;
+
+    /* small numbers, with a few wide ones mixed in */
+    for (k = 0; k < SQIDS_BATCH_TEST_N; ++k) {
+        sqids_batch_test_nums[k] = k % 97 == 13 ?
+            0xFFFFFFFFFFFFFFFFull - k : k % 3 == 0 ? 0xFFFFFFFFull - k :
+            (unsigned long long)k * 7919;
+    }
+
+    for (i = 0, j = 0;; ++i) {
+        test = &sqids_batch_tests[i];
+
+        if (!test->line) {
+            break;
+        }
+
+        sqids = sqids_new(test->alphabet, test->min_len,
+            test->blocklist ? sqids_bl_list_all(NULL) : NULL);
+        r = sqids_encode_batch(sqids, SQIDS_BATCH_TEST_N, sqids_batch_test_nums,
+            sqids_batch_test_out, SQIDS_BATCH_TEST_STRIDE);
+
+        for (k = 0, exp = NULL, got = NULL; r == 0 && k < SQIDS_BATCH_TEST_N;
+            ++k) {
+            exp = sqids_encode(sqids, 1, &sqids_batch_test_nums[k]);
+            got = sqids_batch_test_out + k * SQIDS_BATCH_TEST_STRIDE;
+
+            if (strcmp(exp, got) != 0) {
+                break;
+            }
+
+            sqids_mem_free(exp);
+            exp = NULL;
+        }
+
+        if (r == 0 && k == SQIDS_BATCH_TEST_N) {
+            fputc('.', stdout);
+        } else {
+            fputc('F', stdout);
+
+            (void)asprintf(
+                &err,
+                "%s:%d: "
+                "sqids_encode_batch(...)[%d]\n"
+                "  expected: \"%s\",\n"
+                "       got: \"%s\"\n",
+                __FILE__,
+                test->line,
+                k,
+                exp ? exp : "",
+                got ? got : "");
+            sqids_batch_failures[j++] = err;
+        }
+
+        if (exp) {
+            sqids_mem_free(exp);
+        }
+
+        sqids_free(sqids);
+    }
+
+    /* slots too small for the longest id */
+    sqids = sqids_new(NULL, 0, NULL);
+    r = sqids_encode_batch(sqids, 1, sqids_batch_test_nums,
+        sqids_batch_test_out, 12);
+
+    if (r == -1 && sqids_errno == SQIDS_ERR_NOSPACE) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_encode_batch(...) into short slots\n"
+            "  expected: SQIDS_ERR_NOSPACE\n",
+            __FILE__,
+            __LINE__);
+        sqids_batch_failures[j++] = err;
+    }
+
+    sqids_free(sqids);
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_batch_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_batch_failures[i], stderr);
+        free(sqids_batch_failures[i]);
+    }
+
+    return j;
+}
@@ -21,6 +21,13 @@ struct sqids_bl_test_s {
 };
 typedef struct sqids_bl_test_s sqids_bl_test_t;
 
+/* the default match, behind a pointer `sqids_new` does not recognize */
+static int
+sqids_bl_test_match(char *s, char *bad_word)
+{
+    return sqids_bl_match(s, bad_word);
+}
+
 sqids_bl_test_t sqids_bl_tests[] = {
     {{"sexy", NULL}, "sexy", 1, __LINE__},
     {{"sexy", NULL}, "1sexy", 1, __LINE__},
@@ -29,15 +36,24 @@ sqids_bl_test_t sqids_bl_tests[] = {
     {{NULL}, NULL, 0, 0},
 };
 
-char *sqids_bl_failures[lengthof(sqids_bl_tests)] = {};
+char *sqids_bl_failures[lengthof(sqids_bl_tests) + 7] = {};
 
 int
 main(int argc, char **argv)
 {
     int i, j, k, r;
     sqids_bl_test_t *test;
-    sqids_bl_t *bl;
-    char *err;
+    sqids_bl_t *bl, *dup;
+    sqids_bl_node_t *node;
+    sqids_t *a, *b;
+    char *err, *enc, *exp;
+    unsigned long long n;
+    const char *alphabets[] = {
+        NULL,
+        "abcdefghijklmnopqrstuvwxyz",
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+        "0123456789abcdef",
+    };
 
     for (i = 0, j = 0, k = 0;; ++i) {
         test = &sqids_bl_tests[i];
@@ -80,6 +96,191 @@ main(int argc, char **argv)
         sqids_bl_free(bl);
     }
 
+    /* test a blocklist shared between many sqids */
+    bl = sqids_bl_new(sqids_bl_match);
+    sqids_bl_add_tail(bl, "86Rf07");
+    a = sqids_new(NULL, 0, sqids_bl_ref(bl));
+    b = sqids_new("0123456789abcdef", 0, sqids_bl_ref(bl));
+    r = sqids_bl_add_tail(bl, "sexy") == NULL &&
+        sqids_errno == SQIDS_ERR_IMMUTABLE;
+    sqids_bl_free(bl);
+    sqids_free(b);
+    enc = sqids_vencode(a, 3, 1ull, 2ull, 3ull);
+    r = r && strcmp(enc, "se8ojk") == 0;
+    sqids_mem_free(enc);
+    sqids_free(a);
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_ref(...)\n"
+            "  expected: shared immutable blocklist\n",
+            __FILE__,
+            __LINE__);
+        sqids_bl_failures[k++] = err;
+    }
+
+    /* a list a structure was built with can't change behind its back */
+    bl = sqids_bl_new(NULL);
+    a = sqids_new(NULL, 0, bl);
+    r = sqids_bl_add_tail(bl, "86Rf07") == NULL &&
+        sqids_bl_add_head(bl, "86Rf07") == NULL &&
+        sqids_errno == SQIDS_ERR_IMMUTABLE;
+    dup = sqids_bl_dup(bl);
+    r = r && sqids_bl_add_tail(dup, "86Rf07") != NULL;
+    sqids_bl_free(dup);
+    enc = sqids_vencode(a, 3, 1ull, 2ull, 3ull);
+    r = r && strcmp(enc, "86Rf07") == 0;
+    sqids_mem_free(enc);
+    sqids_free(a);
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_add_tail(...) after sqids_new(...)\n"
+            "  expected: SQIDS_ERR_IMMUTABLE\n",
+            __FILE__,
+            __LINE__);
+        sqids_bl_failures[k++] = err;
+    }
+
+    /* default lists are built once and shared */
+    bl = sqids_bl_default("en");
+    dup = sqids_bl_default("en");
+    r = bl && bl == dup && sqids_bl_add_tail(bl, "sexy") == NULL &&
+        sqids_errno == SQIDS_ERR_IMMUTABLE;
+    sqids_bl_free(dup);
+    dup = sqids_bl_dup(bl);
+    r = r && dup != bl && sqids_bl_add_tail(dup, "sexy") != NULL;
+    sqids_bl_free(dup);
+    sqids_bl_free(bl);
+    r = r && sqids_bl_default("xx") == NULL && sqids_errno == SQIDS_ERR_NOENT;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_default(...)\n"
+            "  expected: shared immutable blocklist\n",
+            __FILE__,
+            __LINE__);
+        sqids_bl_failures[k++] = err;
+    }
+
+    /* one list, languages picked per sqids structure */
+    bl = sqids_bl_new(sqids_bl_match);
+    sqids_bl_add_tail(bl, "86Rf07")->mask = SQIDS_BL_EN;
+    a = sqids_new(NULL, 0, sqids_bl_ref(bl));
+    b = sqids_new(NULL, 0, bl);
+    sqids_bl_mask_set(a, SQIDS_BL_DE | SQIDS_BL_FR);
+    sqids_bl_mask_set(b, SQIDS_BL_EN);
+    enc = sqids_vencode(a, 3, 1ull, 2ull, 3ull);
+    r = strcmp(enc, "86Rf07") == 0;
+    sqids_mem_free(enc);
+    enc = sqids_vencode(b, 3, 1ull, 2ull, 3ull);
+    r = r && strcmp(enc, "se8ojk") == 0;
+    sqids_mem_free(enc);
+    sqids_free(b);
+    sqids_free(a);
+
+#if defined(SQIDS_DEFAULT_BLOCKLIST) && SQIDS_DEFAULT_BLOCKLIST == 1
+    /* the combined list is the union of the languages */
+    bl = sqids_bl_list_de(NULL);
+    for (i = 0, node = bl->head; node; node = node->next, ++i) {
+        r = r && (node->mask & SQIDS_BL_DE);
+    }
+    r = r && i == 30;
+    sqids_bl_free(bl);
+    bl = sqids_bl_list_all(NULL);
+    for (i = 0, node = bl->head; node; node = node->next, ++i) {}
+    r = r && i == 560;
+    sqids_bl_free(bl);
+#endif
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_mask_set(...)\n"
+            "  expected: per-structure languages\n",
+            __FILE__,
+            __LINE__);
+        sqids_bl_failures[k++] = err;
+    }
+
+    /* pruned views encode like the full list, whatever the case */
+    for (i = 0, r = 1; i < lengthof(alphabets); ++i) {
+        bl = sqids_bl_list_all(NULL);
+        sqids_bl_add_tail(bl, "86Rf07");
+        sqids_bl_add_tail(bl, "JdK");
+        a = sqids_new(alphabets[i], 0, sqids_bl_ref(bl));
+        dup = sqids_bl_dup(bl);
+        dup->match_func = sqids_bl_test_match;
+        b = sqids_new(alphabets[i], 0, dup);
+        r = r && !b->bl_view && !b->bl_none &&
+            (a->bl_view == NULL) == a->bl_none;
+        for (node = bl->head; node; node = node->next) {
+            r = r && (!sqids_blocked(a, node->s) || sqids_blocked(b, node->s));
+        }
+        for (n = 0; r && n < 5000; ++n) {
+            enc = sqids_encode(a, 1, &n);
+            exp = sqids_encode(b, 1, &n);
+            r = strcmp(enc, exp) == 0;
+            sqids_mem_free(enc);
+            sqids_mem_free(exp);
+        }
+        sqids_free(b);
+        sqids_free(a);
+        sqids_bl_free(bl);
+    }
+
+    /* nothing to check when no word can be spelled */
+    bl = sqids_bl_new(sqids_bl_match);
+    sqids_bl_add_tail(bl, "sexy");
+    sqids_bl_add_tail(bl, "1234")->mask = SQIDS_BL_EN;
+    a = sqids_new("0123456789", 0, sqids_bl_ref(bl));
+    b = sqids_new("xyz", 0, bl);
+    r = r && a->bl_view_cnt == 1 && !a->bl_none && b->bl_none;
+    sqids_bl_mask_set(a, SQIDS_BL_DE);
+    r = r && a->bl_none && sqids_blocked(a, "1234") == NULL;
+    sqids_bl_mask_set(a, SQIDS_BL_ALL);
+    r = r && !a->bl_none && sqids_blocked(a, "1234") != NULL;
+    sqids_free(b);
+    sqids_free(a);
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_blocked(...)\n"
+            "  expected: pruned blocklist matching the full one\n",
+            __FILE__,
+            __LINE__);
+        sqids_bl_failures[k++] = err;
+    }
+
     fputs("\n", stdout);
 
     if (k) {
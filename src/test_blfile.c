@@ -0,0 +1,199 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "sqids.h"
+
+#define SQIDS_BLFILE_TEST_PATH "test_blfile.sqbl"
+
+char *sqids_blfile_failures[4] = {};
+
+/* overwrite part of a file */
+static void
+sqids_blfile_test_patch(const char *path, long off, const void *p, size_t n)
+{
+    FILE *f = fopen(path, "r+b");
+
+    fseek(f, off, SEEK_SET);
+    fwrite(p, 1, n, f);
+    fclose(f);
+}
+
+int
+main(int argc, char **argv)
+{
+    int i, k = 0, r;
+    sqids_bl_t *bl, *loaded, *empty;
+    sqids_bl_node_t *a, *b;
+    sqids_t *x, *y;
+    unsigned long long n;
+    char *err, *enc, *exp;
+    uint32_t version = SQIDS_BL_FILE_VERSION + 1;
+    struct stat st;
+
+    /* before the first write, as the umask is only read once */
+    umask(027);
+
+    /* a round trip keeps the words, their order and their languages */
+    bl = sqids_bl_list_all(NULL);
+    sqids_bl_add_tail(bl, "86Rf07");
+    sqids_bl_add_tail(bl, "SeXy");
+    r = sqids_bl_write(bl, SQIDS_BLFILE_TEST_PATH) == 0 &&
+        (loaded = sqids_bl_load_mmap(SQIDS_BLFILE_TEST_PATH, NULL)) != NULL;
+
+    for (i = 0, a = bl->head, b = r ? loaded->head : NULL; r && a && b;
+        a = a->next, b = b->next, ++i) {
+        r = strcmp(a->s, b->s) == 0 && a->mask == b->mask &&
+            (b->prev ? b->prev->next == b : loaded->head == b);
+    }
+    r = r && !a && !b && loaded->tail->next == NULL;
+
+    /* and encodes the same, matching against the folded words in place */
+    if (r) {
+        x = sqids_new(NULL, 0, sqids_bl_ref(bl));
+        y = sqids_new(NULL, 0, sqids_bl_ref(loaded));
+        r = y->bl_view_cnt == x->bl_view_cnt &&
+            y->bl_view_size < x->bl_view_size;
+        for (n = 0; r && n < 3000; ++n) {
+            exp = sqids_encode(x, 1, &n);
+            enc = sqids_encode(y, 1, &n);
+            r = strcmp(exp, enc) == 0;
+            sqids_mem_free(exp);
+            sqids_mem_free(enc);
+        }
+        sqids_free(y);
+        sqids_free(x);
+        sqids_bl_free(loaded);
+
+        /* words can still be added to a private mapped list */
+        loaded = NULL;
+        r = r && (loaded = sqids_bl_load_mmap(SQIDS_BLFILE_TEST_PATH,
+            NULL)) != NULL;
+        r = r && sqids_bl_add_tail(loaded, "brand") == loaded->tail &&
+            sqids_bl_find(loaded, "xbrandx") == loaded->tail &&
+            sqids_bl_find(loaded, "86rf07x") != NULL;
+        if (loaded) {
+            sqids_bl_free(loaded);
+        }
+    }
+
+    sqids_bl_free(bl);
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_load_mmap(...)\n"
+            "  expected: the written blocklist\n",
+            __FILE__,
+            __LINE__);
+        sqids_blfile_failures[k++] = err;
+    }
+
+    /* empty lists */
+    bl = sqids_bl_new(NULL);
+    r = sqids_bl_write(bl, SQIDS_BLFILE_TEST_PATH) == 0 &&
+        (empty = sqids_bl_load_mmap(SQIDS_BLFILE_TEST_PATH, NULL)) != NULL &&
+        !empty->head && !empty->tail;
+    if (r) {
+        x = sqids_new(NULL, 0, empty);
+        r = x->bl_none;
+        sqids_free(x);
+    }
+    sqids_bl_free(bl);
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_load_mmap(...)\n"
+            "  expected: an empty blocklist\n",
+            __FILE__,
+            __LINE__);
+        sqids_blfile_failures[k++] = err;
+    }
+
+    /* files get the permissions open() would give them */
+    st.st_mode = 0;
+    r = stat(SQIDS_BLFILE_TEST_PATH, &st) == 0 && (st.st_mode & 0777) == 0640;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_write(...) with umask 027\n"
+            "  expected: 0640\n"
+            "  returned: %04o\n",
+            __FILE__,
+            __LINE__,
+            (unsigned int)(st.st_mode & 0777));
+        sqids_blfile_failures[k++] = err;
+    }
+
+    /* broken files are refused */
+    bl = sqids_bl_new(NULL);
+    sqids_bl_add_tail(bl, "sexy");
+    sqids_bl_write(bl, SQIDS_BLFILE_TEST_PATH);
+    sqids_bl_free(bl);
+
+    r = sqids_bl_load_mmap("no/such/file", NULL) == NULL &&
+        sqids_errno == SQIDS_ERR_IO;
+    sqids_blfile_test_patch(SQIDS_BLFILE_TEST_PATH,
+        offsetof(sqids_bl_file_hdr_t, version), &version, sizeof(version));
+    r = r && sqids_bl_load_mmap(SQIDS_BLFILE_TEST_PATH, NULL) == NULL &&
+        sqids_errno == SQIDS_ERR_FORMAT;
+    r = r && truncate(SQIDS_BLFILE_TEST_PATH, 70) == 0 &&
+        sqids_bl_load_mmap(SQIDS_BLFILE_TEST_PATH, NULL) == NULL &&
+        sqids_errno == SQIDS_ERR_FORMAT;
+    unlink(SQIDS_BLFILE_TEST_PATH);
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_bl_load_mmap(...)\n"
+            "  expected: broken files refused\n",
+            __FILE__,
+            __LINE__);
+        sqids_blfile_failures[k++] = err;
+    }
+
+    fputs("\n", stdout);
+
+    if (k) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_blfile_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_blfile_failures[i], stderr);
+        free(sqids_blfile_failures[i]);
+    }
+
+    return k;
+}
@@ -0,0 +1,153 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sqids.h"
+
+#define SQIDS_FIELD_TEST_LINES 2000
+
+char *sqids_field_failures[5] = {};
+
+int
+main(int argc, char **argv)
+{
+    int i, j, r;
+    sqids_t *sqids;
+    size_t n, len, pos;
+    char *buf, *enc, *dec, *err, out[256];
+    const char *in, *exp;
+
+    j = 0;
+    sqids = sqids_new(NULL, 0, sqids_bl_list_all(NULL));
+
+    /* quotes, crlf, empty fields and short lines */
+    in = "a,\"1 2 3\",x\nb,1 2 3\r\nshort\nc,,\"y,z\"\n,\"\",\nd,1 2 3";
+    exp = "a,\"86Rf07\",x\nb,86Rf07\r\nshort\nc,,\"y,z\"\n,\"\",\nd,86Rf07";
+    r = sqids_field_rewrite(sqids, in, strlen(in), 2, ',', 0, out,
+        sizeof(out), &n);
+
+    if (r == 0 && n == strlen(exp) && memcmp(out, exp, n) == 0) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_field_rewrite(\"%s\", 2, ',')\n"
+            "  expected: \"%s\",\n"
+            "       got: \"%.*s\"\n",
+            __FILE__,
+            __LINE__,
+            in,
+            exp,
+            r == 0 ? (int)n : 0,
+            out);
+        sqids_field_failures[j++] = err;
+    }
+
+    /* fields that do not convert */
+    in = "id\tuser\n1\t7\n2\t18446744073709551616\n";
+    r = sqids_field_rewrite(sqids, in, strlen(in), 2, '\t', 0, out,
+        sizeof(out), &n);
+    r = r == -1 && sqids_errno == SQIDS_ERR_INVALID && n == 3;
+    r = r && sqids_field_rewrite(sqids, in + 8, strlen(in + 8), 2, '\t', 0,
+        out, sizeof(out), &n) == -1 && sqids_errno == SQIDS_ERR_OVERFLOW &&
+        n == 6;
+    r = r && sqids_field_rewrite(sqids, in, strlen(in), 2, '\t',
+        SQIDS_FIELD_KEEP, out, sizeof(out), &n) == 0 && n > 8 &&
+        memcmp(out, "id\tuser\n1\t", 10) == 0 &&
+        memcmp(out + n - 22, "\t18446744073709551616\n", 22) == 0;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_field_rewrite(...) with invalid fields\n"
+            "  expected: their offsets, or kept as is\n",
+            __FILE__,
+            __LINE__);
+        sqids_field_failures[j++] = err;
+    }
+
+    /* small output buffers */
+    in = "1,2,3\n";
+    r = sqids_field_rewrite(sqids, in, strlen(in), 3, ',', 0, out, 5, &n);
+
+    if (r == -1 && sqids_errno == SQIDS_ERR_NOSPACE) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_field_rewrite(\"1,2,3\\n\", ...) into 5 bytes\n"
+            "  expected: SQIDS_ERR_NOSPACE\n",
+            __FILE__,
+            __LINE__);
+        sqids_field_failures[j++] = err;
+    }
+
+    /* a round trip leaves everything else untouched */
+    len = SQIDS_FIELD_TEST_LINES * 64;
+    buf = malloc(len);
+    enc = malloc(len * 2);
+    dec = malloc(len);
+    for (i = 0, pos = 0; i < SQIDS_FIELD_TEST_LINES; ++i) {
+        pos += sprintf(buf + pos, "%d\t%llu %d\t\"x\ty\"\n", i,
+            (unsigned long long)i * 2654435761u, i % 7);
+    }
+
+    r = sqids_field_rewrite(sqids, buf, pos, 2, '\t', 0, enc, len * 2,
+        &n) == 0 &&
+        sqids_field_rewrite(sqids, enc, n, 2, '\t', SQIDS_FIELD_DECODE, dec,
+        len, &n) == 0 &&
+        n == pos && memcmp(buf, dec, n) == 0;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_field_rewrite(...) over %d lines, encoded and decoded\n"
+            "  expected: the same lines\n",
+            __FILE__,
+            __LINE__,
+            SQIDS_FIELD_TEST_LINES);
+        sqids_field_failures[j++] = err;
+    }
+
+    free(dec);
+    free(enc);
+    free(buf);
+    sqids_free(sqids);
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_field_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_field_failures[i], stderr);
+        free(sqids_field_failures[i]);
+    }
+
+    return j;
+}
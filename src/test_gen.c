@@ -0,0 +1,116 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sqids.h"
+#include "gen_plain.h"
+#include "gen_padded.h"
+
+#ifndef lengthof
+#define lengthof(x) ((size_t)(sizeof(x) / sizeof(x[0])))
+#endif
+
+/* a generated encoder/decoder, along with the library equivalent */
+struct sqids_gen_test_s {
+    char *name;
+    unsigned int min_len;
+    char *(*encode)(unsigned int, const unsigned long long *);
+    int (*decode)(const char *, unsigned long long *, unsigned int);
+    int (*num_cnt)(const char *);
+};
+typedef struct sqids_gen_test_s sqids_gen_test_t;
+
+sqids_gen_test_t sqids_gen_tests[] = {
+    {"gen_plain", 0, gen_plain_encode, gen_plain_decode, gen_plain_num_cnt},
+    {"gen_padded", 16, gen_padded_encode, gen_padded_decode,
+        gen_padded_num_cnt},
+    {NULL, 0, NULL, NULL, NULL},
+};
+
+char *sqids_gen_failures[lengthof(sqids_gen_tests)] = {};
+
+int
+main(int argc, char **argv)
+{
+    int i, j, k, cnt, n;
+    sqids_gen_test_t *test;
+    sqids_t *sqids;
+    unsigned long long nums[8], dec[8];
+    char *exp, *enc, *err;
+
+    for (i = 0, j = 0;; ++i) {
+        test = &sqids_gen_tests[i];
+
+        if (!test->name) {
+            break;
+        }
+
+        sqids = sqids_new(NULL, test->min_len, sqids_bl_list_all(NULL));
+
+        /* tuples of 1..8 numbers, deeper than the baked shuffles */
+        for (k = 0, enc = exp = NULL; k < 20000; ++k) {
+            cnt = k % lengthof(nums) + 1;
+            for (n = 0; n < cnt; ++n) {
+                nums[n] = k < 10000 ? (unsigned long long)k * (n + 1) :
+                    (unsigned long long)k * 0x9E3779B97F4A7C15ull >> (n * 7);
+            }
+
+            exp = sqids_encode(sqids, cnt, nums);
+            enc = test->encode(cnt, nums);
+
+            if (strcmp(exp, enc) != 0 || test->num_cnt(enc) != cnt ||
+                test->decode(enc, dec, cnt) != cnt ||
+                memcmp(dec, nums, cnt * sizeof(nums[0])) != 0) {
+                break;
+            }
+
+            sqids_mem_free(exp);
+            free(enc);
+        }
+
+        if (k == 20000) {
+            fputc('.', stdout);
+        } else {
+            fputc('F', stdout);
+
+            (void)asprintf(
+                &err,
+                "%s:%d: "
+                "%s_encode(...)\n"
+                "  expected: \"%s\",\n"
+                "       got: \"%s\"\n",
+                __FILE__,
+                __LINE__,
+                test->name,
+                exp,
+                enc);
+            sqids_gen_failures[j++] = err;
+
+            sqids_mem_free(exp);
+            free(enc);
+        }
+
+        sqids_free(sqids);
+    }
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_gen_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_gen_failures[i], stderr);
+        free(sqids_gen_failures[i]);
+    }
+
+    return j;
+}
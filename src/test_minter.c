@@ -0,0 +1,172 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "sqids.h"
+
+#ifndef lengthof
+#define lengthof(x) ((size_t)(sizeof(x) / sizeof(x[0])))
+#endif
+
+#define SQIDS_MINTER_TEST_THREADS 8
+#define SQIDS_MINTER_TEST_IDS 5000
+#define SQIDS_MINTER_TEST_START 1000000
+
+char *sqids_minter_failures[4] = {};
+
+sqids_t *sqids_minter_test_sqids;
+sqids_minter_t *sqids_minter_test_minter;
+unsigned char sqids_minter_test_seen[SQIDS_MINTER_TEST_THREADS *
+    SQIDS_MINTER_TEST_IDS + 64 * SQIDS_MINTER_TEST_THREADS];
+int sqids_minter_test_bad[SQIDS_MINTER_TEST_THREADS];
+
+static void *
+sqids_minter_test_thread(void *arg)
+{
+    unsigned long long seq;
+    const char *id;
+    char *exp;
+    int i;
+
+    for (i = 0; i < SQIDS_MINTER_TEST_IDS; ++i) {
+        id = sqids_minter_next(sqids_minter_test_minter, &seq);
+        exp = sqids_encode(sqids_minter_test_sqids, 1, &seq);
+
+        /* each thread only marks its own sequence numbers */
+        if (!id || strcmp(id, exp) != 0 || seq < SQIDS_MINTER_TEST_START ||
+            seq - SQIDS_MINTER_TEST_START >=
+                lengthof(sqids_minter_test_seen) ||
+            sqids_minter_test_seen[seq - SQIDS_MINTER_TEST_START]++) {
+            ++sqids_minter_test_bad[(size_t)arg];
+        }
+
+        sqids_mem_free(exp);
+    }
+
+    return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+    int i, j, bad;
+    sqids_minter_t *minter;
+    pthread_t threads[SQIDS_MINTER_TEST_THREADS];
+    unsigned long long seq;
+    const char *id;
+    char *err;
+
+    j = 0;
+
+    /* unique, correctly encoded ids from many threads */
+    sqids_minter_test_sqids = sqids_new(NULL, 10, sqids_bl_list_all(NULL));
+    sqids_minter_test_minter = sqids_minter_new(sqids_minter_test_sqids,
+        SQIDS_MINTER_TEST_START, 64);
+
+    for (i = 0; i < SQIDS_MINTER_TEST_THREADS; ++i) {
+        pthread_create(&threads[i], NULL, sqids_minter_test_thread,
+            (void *)(size_t)i);
+    }
+
+    for (i = 0; i < SQIDS_MINTER_TEST_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (i = 0, bad = 0; i < SQIDS_MINTER_TEST_THREADS; ++i) {
+        bad += sqids_minter_test_bad[i];
+    }
+
+    if (!bad) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_minter_next(...) from %d threads\n"
+            "  expected: unique ids,\n"
+            "       got: %d bad ones\n",
+            __FILE__,
+            __LINE__,
+            SQIDS_MINTER_TEST_THREADS,
+            bad);
+        sqids_minter_failures[j++] = err;
+    }
+
+    sqids_minter_free(sqids_minter_test_minter);
+    sqids_free(sqids_minter_test_sqids);
+
+    /* running out of sequence numbers */
+    sqids_minter_test_sqids = sqids_new(NULL, 0, NULL);
+    minter = sqids_minter_new(sqids_minter_test_sqids,
+        0xFFFFFFFFFFFFFFFFull - 9, 4);
+
+    for (i = 0; (id = sqids_minter_next(minter, &seq)); ++i) {}
+
+    if (i == 10 && sqids_errno == SQIDS_ERR_OVERFLOW &&
+        seq == 0xFFFFFFFFFFFFFFFFull) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_minter_next(...) at the end of the sequence\n"
+            "  expected: 10 ids, then SQIDS_ERR_OVERFLOW,\n"
+            "       got: %d ids\n",
+            __FILE__,
+            __LINE__,
+            i);
+        sqids_minter_failures[j++] = err;
+    }
+
+    sqids_minter_free(minter);
+
+    /* blocks too large to allocate are refused up front */
+    minter = sqids_minter_new(sqids_minter_test_sqids, 0, 0x20000000u);
+
+    if (!minter && sqids_errno == SQIDS_ERR_OVERFLOW) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_minter_new(...) with 2^29 numbers per block\n"
+            "  expected: SQIDS_ERR_OVERFLOW\n",
+            __FILE__,
+            __LINE__);
+        sqids_minter_failures[j++] = err;
+
+        if (minter) {
+            sqids_minter_free(minter);
+        }
+    }
+
+    sqids_free(sqids_minter_test_sqids);
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_minter_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_minter_failures[i], stderr);
+        free(sqids_minter_failures[i]);
+    }
+
+    return j;
+}
@@ -0,0 +1,257 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "sqids.h"
+
+#ifndef lengthof
+#define lengthof(x) ((size_t)(sizeof(x) / sizeof(x[0])))
+#endif
+
+#define SQIDS_REGISTRY_TEST_THREADS 8
+
+struct sqids_registry_test_s {
+    char *alphabet;
+    unsigned int min_len;
+    unsigned int bl_id;
+    char *exp;
+    int line;
+};
+typedef struct sqids_registry_test_s sqids_registry_test_t;
+
+sqids_registry_test_t sqids_registry_tests[] = {
+    {SQIDS_DEFAULT_ALPHABET, 0, 0, "86Rf07", __LINE__},
+    {SQIDS_DEFAULT_ALPHABET, 10, 0, "86Rf07xd4z", __LINE__},
+    {SQIDS_DEFAULT_ALPHABET, 0, 1, "se8ojk", __LINE__},
+    {"FxnXM1kBN6cuhsAvjW3Co7l2RePyY8DwaU04Tzt9fHQrqSVKdpimLGIJOgb5ZE", 0, 0,
+        "B4aajs", __LINE__},
+    {NULL, 0, 0, NULL, 0},
+};
+
+char *sqids_registry_failures[lengthof(sqids_registry_tests) + 4] = {};
+
+sqids_registry_t *sqids_registry_test_reg;
+sqids_t *sqids_registry_test_handles[SQIDS_REGISTRY_TEST_THREADS];
+sqids_bl_t *sqids_registry_test_bl;
+
+/* replace blocklist 1 while sqids_new runs, outside the registry lock */
+static void *
+sqids_registry_test_alloc(unsigned int size)
+{
+    sqids_bl_t *bl = sqids_registry_test_bl;
+
+    if (bl && size == sizeof(sqids_t)) {
+        sqids_registry_test_bl = NULL;
+        sqids_registry_bl_set(sqids_registry_test_reg, 1, bl);
+    }
+
+    return malloc(size);
+}
+
+static void *
+sqids_registry_test_thread(void *arg)
+{
+    sqids_registry_test_handles[(size_t)arg] = sqids_registry_get(
+        sqids_registry_test_reg, "0123456789abcdef", 8, 0);
+
+    return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+    int i, j;
+    sqids_registry_test_t *test;
+    sqids_registry_t *reg;
+    sqids_bl_t *bl;
+    sqids_t *sqids, *again;
+    pthread_t threads[SQIDS_REGISTRY_TEST_THREADS];
+    void *(*alloc)(unsigned int);
+    char *enc, *err;
+
+    reg = sqids_registry_new(0);
+    bl = sqids_bl_new(sqids_bl_match);
+    sqids_bl_add_tail(bl, "86Rf07");
+    sqids_registry_bl_set(reg, 1, bl);
+
+    for (i = 0, j = 0;; ++i) {
+        test = &sqids_registry_tests[i];
+
+        if (!test->exp || !test->line) {
+            break;
+        }
+
+        sqids = sqids_registry_get(reg, test->alphabet, test->min_len,
+            test->bl_id);
+        again = sqids_registry_get(reg, test->alphabet, test->min_len,
+            test->bl_id);
+        enc = sqids_vencode(sqids, 3, 1ull, 2ull, 3ull);
+
+        if (sqids == again && strcmp(enc, test->exp) == 0) {
+            fputc('.', stdout);
+        } else {
+            fputc('F', stdout);
+
+            (void)asprintf(
+                &err,
+                "%s:%d: "
+                "sqids_registry_get(...)\n"
+                "  expected: \"%s\" (shared),\n"
+                "       got: \"%s\" (%s)\n",
+                __FILE__,
+                test->line,
+                test->exp,
+                enc,
+                sqids == again ? "shared" : "not shared");
+            sqids_registry_failures[j++] = err;
+        }
+
+        sqids_mem_free(enc);
+        sqids_free(again);
+        sqids_free(sqids);
+    }
+
+    /* a structure built with a list replaced meanwhile is not kept */
+    sqids_registry_test_reg = reg;
+    sqids_registry_test_bl = sqids_bl_new(sqids_bl_match);
+    alloc = sqids_mem_alloc;
+    sqids_mem_alloc = sqids_registry_test_alloc;
+    sqids = sqids_registry_get(reg, NULL, 6, 1);
+    sqids_mem_alloc = alloc;
+    again = sqids_registry_get(reg, NULL, 6, 1);
+    enc = sqids_vencode(sqids, 3, 1ull, 2ull, 3ull);
+
+    if (sqids == again && strcmp(enc, "86Rf07") == 0) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_registry_bl_set(...) during sqids_registry_get(...)\n"
+            "  expected: \"86Rf07\" (shared),\n"
+            "       got: \"%s\" (%s)\n",
+            __FILE__,
+            __LINE__,
+            enc,
+            sqids == again ? "shared" : "not shared");
+        sqids_registry_failures[j++] = err;
+    }
+
+    sqids_mem_free(enc);
+    sqids_free(again);
+    sqids_free(sqids);
+
+    /* concurrent lookups of a missing entry all get the same structure */
+    for (i = 0; i < SQIDS_REGISTRY_TEST_THREADS; ++i) {
+        pthread_create(&threads[i], NULL, sqids_registry_test_thread,
+            (void *)(size_t)i);
+    }
+
+    for (i = 0; i < SQIDS_REGISTRY_TEST_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (i = 1; i < SQIDS_REGISTRY_TEST_THREADS; ++i) {
+        if (sqids_registry_test_handles[i] != sqids_registry_test_handles[0]) {
+            break;
+        }
+    }
+
+    if (i == SQIDS_REGISTRY_TEST_THREADS && sqids_registry_test_handles[0]) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_registry_get(...) from %d threads\n"
+            "  expected: a single shared structure\n",
+            __FILE__,
+            __LINE__,
+            SQIDS_REGISTRY_TEST_THREADS);
+        sqids_registry_failures[j++] = err;
+    }
+
+    for (i = 0; i < SQIDS_REGISTRY_TEST_THREADS; ++i) {
+        sqids_free(sqids_registry_test_handles[i]);
+    }
+
+    sqids_registry_free(reg);
+
+    /* a tiny budget evicts, but handles stay usable */
+    reg = sqids_registry_new(1);
+    sqids = sqids_registry_get(reg, NULL, 0, 0);
+    again = sqids_registry_get(reg, NULL, 0, 0);
+    enc = sqids_vencode(sqids, 3, 1ull, 2ull, 3ull);
+
+    if (sqids != again && strcmp(enc, "86Rf07") == 0) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_registry_get(...) with a tiny budget\n"
+            "  expected: \"86Rf07\" (evicted),\n"
+            "       got: \"%s\" (%s)\n",
+            __FILE__,
+            __LINE__,
+            enc,
+            sqids != again ? "evicted" : "not evicted");
+        sqids_registry_failures[j++] = err;
+    }
+
+    sqids_mem_free(enc);
+    sqids_free(again);
+    sqids_free(sqids);
+    sqids_registry_free(reg);
+
+    /* id 0 can't be given a blocklist, which stays the caller's */
+    reg = sqids_registry_new(0);
+    bl = sqids_bl_list_en(NULL);
+
+    if (sqids_registry_bl_set(reg, 0, bl) == -1 &&
+        sqids_errno == SQIDS_ERR_INVALID) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_registry_bl_set(..., 0, ...)\n"
+            "  expected: -1 (SQIDS_ERR_INVALID)\n",
+            __FILE__,
+            __LINE__);
+        sqids_registry_failures[j++] = err;
+    }
+
+    sqids_bl_free(bl);
+    sqids_registry_free(reg);
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_registry_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_registry_failures[i], stderr);
+        free(sqids_registry_failures[i]);
+    }
+
+    return j;
+}
@@ -0,0 +1,327 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/wait.h>
+
+#include "sqids.h"
+
+#define SQIDS_RING_TEST_SLOTS 64
+#define SQIDS_RING_TEST_THREADS 4
+#define SQIDS_RING_TEST_DEPTH 15
+#define SQIDS_RING_TEST_IDS 5000
+
+char *sqids_ring_failures[5] = {};
+
+/* what a producer thread shares */
+struct ring_test_s {
+    pthread_t tid;
+    sqids_ring_t *ring;
+    sqids_t *sqids;
+    unsigned int id;
+    int ok;
+};
+
+/* the numbers of a producer's i-th id */
+static unsigned int
+ring_test_nums(unsigned int id, unsigned int i, unsigned long long *nums)
+{
+    unsigned int j, n = i % 3 + 1;
+
+    for (j = 0; j < n; ++j) {
+        nums[j] = ((unsigned long long)id << 32 | i) *
+            0x9E3779B97F4A7C15ull >> (j * 20);
+    }
+
+    return n;
+}
+
+/* a request in flight */
+struct ring_test_req_s {
+    long long ticket;
+    unsigned int i;
+    int decode;
+};
+
+/* keep a few requests in flight, decoding every id that comes back */
+static void *
+ring_test_produce(void *arg)
+{
+    struct ring_test_s *test = arg;
+    struct ring_test_req_s fifo[SQIDS_RING_TEST_DEPTH], *req;
+    char ids[SQIDS_RING_TEST_DEPTH][SQIDS_RING_ID_MAX + 1];
+    unsigned int idx[SQIDS_RING_TEST_DEPTH];
+    unsigned long long nums[3], back[SQIDS_RING_NUMS];
+    unsigned int i, n, head = 0, len = 0, ids_head = 0, ids_len = 0, enc = 0;
+    long long ticket;
+    char *id, *exp;
+    int r;
+
+    test->ok = 1;
+
+    while (test->ok && (len || ids_len || enc < SQIDS_RING_TEST_IDS)) {
+        /* ids waiting to be decoded go first */
+        ticket = -1;
+        if (len < SQIDS_RING_TEST_DEPTH && ids_len) {
+            id = ids[ids_head];
+            if ((ticket = sqids_ring_put_decode(test->ring, id,
+                strlen(id))) >= 0) {
+                req = &fifo[(head + len++) % SQIDS_RING_TEST_DEPTH];
+                req->ticket = ticket;
+                req->i = idx[ids_head];
+                req->decode = 1;
+                ids_head = (ids_head + 1) % SQIDS_RING_TEST_DEPTH;
+                --ids_len;
+            }
+        } else if (len < SQIDS_RING_TEST_DEPTH && enc < SQIDS_RING_TEST_IDS) {
+            n = ring_test_nums(test->id, enc, nums);
+            if ((ticket = sqids_ring_put_encode(test->ring, n, nums)) >= 0) {
+                req = &fifo[(head + len++) % SQIDS_RING_TEST_DEPTH];
+                req->ticket = ticket;
+                req->i = enc++;
+                req->decode = 0;
+            }
+        } else {
+            sqids_errno = SQIDS_ERR_BUSY;
+        }
+
+        if (ticket >= 0) {
+            continue;
+        }
+
+        /* a full ring may be waiting on our own oldest ticket */
+        test->ok = sqids_errno == SQIDS_ERR_BUSY;
+        if (!len) {
+            sched_yield();
+            continue;
+        }
+
+        req = &fifo[head];
+        head = (head + 1) % SQIDS_RING_TEST_DEPTH;
+        --len;
+        n = ring_test_nums(test->id, req->i, nums);
+
+        if (req->decode) {
+            r = sqids_ring_get_decode(test->ring, req->ticket, back,
+                SQIDS_RING_NUMS);
+            test->ok = r == (int)n && memcmp(back, nums, n * sizeof(*nums)) ==
+                0;
+        } else {
+            i = (ids_head + ids_len++) % SQIDS_RING_TEST_DEPTH;
+            idx[i] = req->i;
+            r = sqids_ring_get_encode(test->ring, req->ticket, ids[i],
+                sizeof(ids[i]));
+            exp = sqids_encode(test->sqids, n, nums);
+            test->ok = r >= 0 && exp && strcmp(ids[i], exp) == 0;
+            sqids_mem_free(exp);
+        }
+    }
+
+    /* every ticket is collected, even after a failure */
+    for (; len; --len, head = (head + 1) % SQIDS_RING_TEST_DEPTH) {
+        sqids_ring_get_encode(test->ring, fifo[head].ticket, ids[0],
+            sizeof(ids[0]));
+    }
+
+    return NULL;
+}
+
+static void *
+ring_test_serve(void *arg)
+{
+    struct ring_test_s *test = arg;
+
+    test->ok = sqids_ring_serve(test->ring, test->sqids) == 0;
+
+    return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+    struct ring_test_s server, producers[SQIDS_RING_TEST_THREADS];
+    unsigned long long nums[SQIDS_RING_NUMS + 1];
+    int i, k, r, status;
+    sqids_ring_t *ring, *peer;
+    sqids_t *sqids;
+    char id[SQIDS_RING_ID_MAX + 1], *exp, *err;
+    long long ticket;
+    FILE *fp;
+    pid_t pid;
+
+    k = 0;
+    sqids = sqids_new(NULL, 8, sqids_bl_list_all(NULL));
+    ring = sqids_ring_new(SQIDS_RING_TEST_SLOTS);
+
+    /* another process maps the ring and encodes through it */
+    if (!(pid = fork())) {
+        r = (peer = sqids_ring_open(sqids_ring_fd(ring))) != NULL;
+        for (i = 0; r && i < 1000; ++i) {
+            nums[0] = i * 7919ull;
+            exp = NULL;
+            while ((ticket = sqids_ring_put_encode(peer, 1, nums)) < 0 &&
+                sqids_errno == SQIDS_ERR_BUSY) {
+                sched_yield();
+            }
+            r = sqids_ring_get_encode(peer, ticket, id, sizeof(id)) >= 0 &&
+                (exp = sqids_encode(sqids, 1, nums)) &&
+                strcmp(id, exp) == 0;
+            sqids_mem_free(exp);
+        }
+        if (peer) {
+            sqids_ring_free(peer);
+        }
+        _exit(r ? 0 : 1);
+    }
+
+    server.ring = ring;
+    server.sqids = sqids;
+    r = pthread_create(&server.tid, NULL, ring_test_serve, &server) == 0;
+
+    /* producers racing for slots get what the library gives */
+    for (i = 0; i < SQIDS_RING_TEST_THREADS; ++i) {
+        producers[i].ring = ring;
+        producers[i].sqids = sqids;
+        producers[i].id = i;
+        r = r && pthread_create(&producers[i].tid, NULL, ring_test_produce,
+            &producers[i]) == 0;
+    }
+
+    for (i = 0; i < SQIDS_RING_TEST_THREADS; ++i) {
+        pthread_join(producers[i].tid, NULL);
+        r = r && producers[i].ok;
+    }
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "%d threads encoding and decoding %d ids each\n"
+            "  expected: what sqids_encode and sqids_decode give\n",
+            __FILE__,
+            __LINE__,
+            SQIDS_RING_TEST_THREADS,
+            SQIDS_RING_TEST_IDS);
+        sqids_ring_failures[k++] = err;
+    }
+
+    r = waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+        WEXITSTATUS(status) == 0;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_ring_open from a child process\n"
+            "  expected: 1000 ids encoded through the shared ring\n",
+            __FILE__,
+            __LINE__);
+        sqids_ring_failures[k++] = err;
+    }
+
+    /* errors travel back with the result, bad tickets are refused */
+    r = sqids_ring_get_decode(ring, sqids_ring_put_decode(ring, "a-b", 3),
+        nums, SQIDS_RING_NUMS) == -1 && sqids_errno == SQIDS_ERR_INVALID;
+    r = r && sqids_ring_put_encode(ring, SQIDS_RING_NUMS + 1, nums) == -1 &&
+        sqids_errno == SQIDS_ERR_NOSPACE;
+    ticket = sqids_ring_put_encode(ring, 1, nums);
+    r = r && sqids_ring_get_encode(ring, ticket + 1, id, sizeof(id)) == -1 &&
+        sqids_errno == SQIDS_ERR_INVALID;
+    r = r && sqids_ring_get_encode(ring, ticket, id, 2) == -1 &&
+        sqids_errno == SQIDS_ERR_NOSPACE;
+    r = r && sqids_ring_get_encode(ring, ticket, id, sizeof(id)) == -1 &&
+        sqids_errno == SQIDS_ERR_INVALID;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "ring errors\n"
+            "  expected: SQIDS_ERR_INVALID for a bad id and stale tickets, "
+            "SQIDS_ERR_NOSPACE for too many numbers and a short buffer\n",
+            __FILE__,
+            __LINE__);
+        sqids_ring_failures[k++] = err;
+    }
+
+    /* a file that is not a ring */
+    r = (fp = tmpfile()) != NULL && fwrite(id, 1, sizeof(id), fp) ==
+        sizeof(id) && fflush(fp) == 0 && !sqids_ring_open(fileno(fp)) &&
+        sqids_errno == SQIDS_ERR_FORMAT;
+    if (fp) {
+        fclose(fp);
+    }
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_ring_open of a plain file\n"
+            "  expected: SQIDS_ERR_FORMAT\n",
+            __FILE__,
+            __LINE__);
+        sqids_ring_failures[k++] = err;
+    }
+
+    /* stopping wakes a sleeping server */
+    usleep(50000);
+    sqids_ring_stop(ring);
+    r = pthread_join(server.tid, NULL) == 0 && server.ok;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_ring_stop\n"
+            "  expected: sqids_ring_serve returns 0\n",
+            __FILE__,
+            __LINE__);
+        sqids_ring_failures[k++] = err;
+    }
+
+    sqids_ring_free(ring);
+    sqids_free(sqids);
+
+    fputs("\n", stdout);
+
+    if (k) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_ring_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_ring_failures[i], stderr);
+        free(sqids_ring_failures[i]);
+    }
+
+    return k;
+}
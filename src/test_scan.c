@@ -0,0 +1,175 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sqids.h"
+
+#ifndef lengthof
+#define lengthof(x) ((size_t)(sizeof(x) / sizeof(x[0])))
+#endif
+
+#define SQIDS_SCAN_TEST_IDS 2000
+
+char *sqids_scan_failures[4] = {};
+
+/* what the callback saw */
+struct sqids_scan_test_s {
+    int cnt;
+    size_t offsets[SQIDS_SCAN_TEST_IDS];
+    unsigned int num_cnts[SQIDS_SCAN_TEST_IDS];
+    unsigned long long nums[SQIDS_SCAN_TEST_IDS];
+};
+typedef struct sqids_scan_test_s sqids_scan_test_t;
+
+sqids_scan_test_t sqids_scan_test;
+
+static int
+sqids_scan_test_cb(const sqids_match_t *match, void *arg)
+{
+    sqids_scan_test_t *test = arg;
+
+    if (test->cnt >= SQIDS_SCAN_TEST_IDS) {
+        return 1;
+    }
+
+    test->offsets[test->cnt] = match->offset;
+    test->num_cnts[test->cnt] = match->num_cnt;
+    test->nums[test->cnt++] = match->nums[0];
+
+    return 0;
+}
+
+static int
+sqids_scan_test_stop(const sqids_match_t *match, void *arg)
+{
+    return 1;
+}
+
+int
+main(int argc, char **argv)
+{
+    int i, j, k, cnt;
+    sqids_t *sqids;
+    size_t offsets[SQIDS_SCAN_TEST_IDS], pos;
+    char *buf, *enc, *err;
+    static const char *seps[] = {" ", "/", "&x=", ", ", "-\n", "\t\xC3\xA9"};
+
+    j = 0;
+    sqids = sqids_new(NULL, 0, sqids_bl_list_all(NULL));
+
+    /* a log line, only the canonical id is reported */
+    buf = "GET /u/86Rf07 HTTP/1.1 ref=se8ojk;";
+    memset(&sqids_scan_test, 0, sizeof(sqids_scan_test));
+    cnt = sqids_scan(sqids, buf, strlen(buf), 5, 0, SQIDS_SCAN_CANONICAL,
+        sqids_scan_test_cb, &sqids_scan_test);
+
+    if (cnt == 1 && sqids_scan_test.offsets[0] == 7 &&
+        sqids_scan_test.num_cnts[0] == 3 && sqids_scan_test.nums[0] == 1) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_scan(\"%s\", ...)\n"
+            "  expected: [1, 2, 3] at offset 7,\n"
+            "       got: %d ids\n",
+            __FILE__,
+            __LINE__,
+            buf,
+            cnt);
+        sqids_scan_failures[j++] = err;
+    }
+
+    /* many ids crossing block boundaries, one at the very end */
+    buf = malloc(SQIDS_SCAN_TEST_IDS * 16);
+    for (i = 0, pos = 0; i < SQIDS_SCAN_TEST_IDS; ++i) {
+        unsigned long long num = (unsigned long long)i * i * 7919;
+
+        strcpy(buf + pos, seps[i % lengthof(seps)]);
+        pos += strlen(seps[i % lengthof(seps)]);
+
+        enc = sqids_encode(sqids, 1, &num);
+        offsets[i] = pos;
+        strcpy(buf + pos, enc);
+        pos += strlen(enc);
+        sqids_mem_free(enc);
+    }
+
+    memset(&sqids_scan_test, 0, sizeof(sqids_scan_test));
+    cnt = sqids_scan(sqids, buf, pos, 2, 0, SQIDS_SCAN_CANONICAL,
+        sqids_scan_test_cb, &sqids_scan_test);
+
+    for (k = 0; k < cnt && k < SQIDS_SCAN_TEST_IDS; ++k) {
+        if (sqids_scan_test.offsets[k] != offsets[k] ||
+            sqids_scan_test.num_cnts[k] != 1 ||
+            sqids_scan_test.nums[k] != (unsigned long long)k * k * 7919) {
+            break;
+        }
+    }
+
+    if (cnt == SQIDS_SCAN_TEST_IDS && k == cnt) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_scan(...) over %d ids\n"
+            "  expected: all of them,\n"
+            "       got: %d, first mismatch at %d\n",
+            __FILE__,
+            __LINE__,
+            SQIDS_SCAN_TEST_IDS,
+            cnt,
+            k);
+        sqids_scan_failures[j++] = err;
+    }
+
+    /* the callback stops the scan */
+    cnt = sqids_scan(sqids, buf, pos, 2, 0, SQIDS_SCAN_CANONICAL,
+        sqids_scan_test_stop, NULL);
+
+    if (cnt == 1) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_scan(...) with a stopping callback\n"
+            "  expected: 1 id,\n"
+            "       got: %d\n",
+            __FILE__,
+            __LINE__,
+            cnt);
+        sqids_scan_failures[j++] = err;
+    }
+
+    free(buf);
+    sqids_free(sqids);
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_scan_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_scan_failures[i], stderr);
+        free(sqids_scan_failures[i]);
+    }
+
+    return j;
+}
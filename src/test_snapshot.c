@@ -0,0 +1,178 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sqids.h"
+
+#define SQIDS_SNAPSHOT_TEST_PATH "test_snapshot.sqsn"
+
+struct sqids_snapshot_test_s {
+    char *alphabet;
+    unsigned int min_len;
+    int blocklist;
+    unsigned int bl_mask;
+    int line;
+};
+typedef struct sqids_snapshot_test_s sqids_snapshot_test_t;
+
+sqids_snapshot_test_t sqids_snapshot_tests[] = {
+    {NULL, 0, 1, SQIDS_BL_ALL, __LINE__},
+    {NULL, 12, 1, SQIDS_BL_EN | SQIDS_BL_FR, __LINE__},
+    {"0123456789abcdef", 40, 0, 0, __LINE__},
+    {"abcdefghijklmnopqrstuvwxyz", 5, 1, SQIDS_BL_DE, __LINE__},
+    {NULL, 0, 0, 0, 0},
+};
+
+char *sqids_snapshot_failures[sizeof(sqids_snapshot_tests) /
+    sizeof(sqids_snapshot_tests[0]) + 2] = {};
+
+/* the default match, behind a pointer snapshots can't store */
+static int
+sqids_snapshot_test_match(char *s, char *bad_word)
+{
+    return sqids_bl_match(s, bad_word);
+}
+
+int
+main(int argc, char **argv)
+{
+    int i, j, k, r, cnt;
+    sqids_snapshot_test_t *test;
+    sqids_bl_t *bl;
+    sqids_t *x, *y;
+    unsigned long long nums[3], dec[3];
+    char *err, *enc, *exp;
+
+    for (i = 0, k = 0;; ++i) {
+        test = &sqids_snapshot_tests[i];
+
+        if (!test->line) {
+            break;
+        }
+
+        bl = NULL;
+        if (test->blocklist) {
+            bl = sqids_bl_list_all(NULL);
+            sqids_bl_add_tail(bl, "86Rf07");
+        }
+
+        x = sqids_new(test->alphabet, test->min_len, bl);
+        if (test->blocklist) {
+            sqids_bl_mask_set(x, test->bl_mask);
+        }
+
+        y = NULL;
+        r = sqids_snapshot_write(x, SQIDS_SNAPSHOT_TEST_PATH) == 0 &&
+            (y = sqids_snapshot_open(SQIDS_SNAPSHOT_TEST_PATH)) != NULL;
+
+        /* the alphabet and the padding are used in place */
+        r = r && strcmp(x->alphabet, y->alphabet) == 0 &&
+            (char *)y->alphabet >= (char *)y->map &&
+            (char *)y->alphabet < (char *)y->map + y->map_len &&
+            y->pad_depth == x->pad_depth && y->bl_mask == x->bl_mask &&
+            y->bl_none == x->bl_none && y->bl_view_cnt == x->bl_view_cnt &&
+            !y->blocklist == !x->blocklist;
+
+        for (j = 0; r && j < 3000; ++j) {
+            cnt = j % 3 + 1;
+            nums[0] = j;
+            nums[1] = (unsigned long long)j * 0x9E3779B97F4A7C15ull;
+            nums[2] = j * 7;
+
+            exp = sqids_encode(x, cnt, nums);
+            enc = sqids_encode(y, cnt, nums);
+            r = strcmp(exp, enc) == 0 && sqids_decode(y, enc, dec, 3) == cnt &&
+                memcmp(dec, nums, cnt * sizeof(nums[0])) == 0;
+            sqids_mem_free(exp);
+            sqids_mem_free(enc);
+        }
+
+        /* the blocklist keeps the file mapped past the structure */
+        bl = y && y->blocklist ? sqids_bl_ref(y->blocklist) : NULL;
+
+        if (y) {
+            sqids_free(y);
+        }
+        sqids_free(x);
+
+        if (bl) {
+            r = r && sqids_bl_find(bl, "86Rf07") != NULL;
+            sqids_bl_free(bl);
+        }
+
+        if (r) {
+            fputc('.', stdout);
+        } else {
+            fputc('F', stdout);
+
+            (void)asprintf(
+                &err,
+                "%s:%d: "
+                "sqids_snapshot_open(...)\n"
+                "  expected: the written sqids structure\n",
+                __FILE__,
+                test->line);
+            sqids_snapshot_failures[k++] = err;
+        }
+    }
+
+    /* what can't be stored or read back is refused */
+    bl = sqids_bl_new(sqids_snapshot_test_match);
+    x = sqids_new(NULL, 0, bl);
+    r = sqids_snapshot_write(x, SQIDS_SNAPSHOT_TEST_PATH) != 0 &&
+        sqids_errno == SQIDS_ERR_FORMAT;
+    sqids_free(x);
+    r = r && sqids_snapshot_open("no/such/file") == NULL &&
+        sqids_errno == SQIDS_ERR_IO;
+    /* a large min_len is written and read back like any other */
+    x = sqids_new(NULL, 2000, NULL);
+    r = r && sqids_snapshot_write(x, SQIDS_SNAPSHOT_TEST_PATH) == 0 &&
+        (y = sqids_snapshot_open(SQIDS_SNAPSHOT_TEST_PATH)) != NULL &&
+        y->min_len == 2000 && y->pow_cnt == x->pow_cnt &&
+        memcmp(y->pow, x->pow, x->pow_cnt * sizeof(x->pow[0])) == 0;
+    if (r) {
+        sqids_free(y);
+    }
+    sqids_free(x);
+    r = r && truncate(SQIDS_SNAPSHOT_TEST_PATH, 100) == 0 &&
+        sqids_snapshot_open(SQIDS_SNAPSHOT_TEST_PATH) == NULL &&
+        sqids_errno == SQIDS_ERR_FORMAT;
+    unlink(SQIDS_SNAPSHOT_TEST_PATH);
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_snapshot_write(...)\n"
+            "  expected: unusable snapshots refused\n",
+            __FILE__,
+            __LINE__);
+        sqids_snapshot_failures[k++] = err;
+    }
+
+    fputs("\n", stdout);
+
+    if (k) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_snapshot_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_snapshot_failures[i], stderr);
+        free(sqids_snapshot_failures[i]);
+    }
+
+    return k;
+}
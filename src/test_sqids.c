@@ -68,6 +68,11 @@ sqids_sqids_test_t sqids_sqids_tests[] = {
         "wUgx9JEczPzMrb9PIGcLPjwmH7xaWOpdQmk1zHw4XMRX6MOh1s96qWVxdb9fdEvat4KzH"
         "INW7VMoglaKdCy3z5bnEsVYEQxl4ICjo", __LINE__},
 
+    {SQIDS_DEFAULT_ALPHABET, 10, 3, {1, 2, 3}, "86Rf07xd4z", __LINE__},
+    {SQIDS_DEFAULT_ALPHABET, 62, 3, {1, 2, 3},
+        "86Rf07xd4zBmiJXQG6otHEbew02c3PWsUOLZxADhCpKj7aVFv9I8RquYrNlSTM",
+        __LINE__},
+
 #if defined(SQIDS_DEFAULT_BLOCKLIST) && SQIDS_DEFAULT_BLOCKLIST == 1
     {SQIDS_DEFAULT_ALPHABET, 0, 1, {4572721}, "JExTR", __LINE__},
 #endif
@@ -75,16 +80,28 @@ sqids_sqids_test_t sqids_sqids_tests[] = {
     {NULL, 0, 0, {}, NULL, 0},
 };
 
-char *sqids_sqids_failures[lengthof(sqids_sqids_tests) + 2] = {};
+char *sqids_sqids_non_canonical[] = {
+    "",
+    "86Rf07xd4z",
+    "86Rf07x",
+    "8",
+    "JExTR",
+    NULL,
+};
+
+char *sqids_sqids_failures[lengthof(sqids_sqids_tests) * 3 +
+    lengthof(sqids_sqids_non_canonical) + 6] = {};
 
 int
 main(int argc, char **argv)
 {
-    int i, j;
+    int i, j, k, n, r, cnt, hits;
     sqids_sqids_test_t *test;
     sqids_bl_t *bl;
     sqids_t *sqids;
-    char *enc, *err;
+    char *enc, *err, *buf, word[5];
+    unsigned long long nums[128], dec[8];
+    sqids_stats_t stats;
 
     for (i = 0, j = 0;; ++i) {
         test = &sqids_sqids_tests[i];
@@ -119,7 +136,152 @@ main(int argc, char **argv)
             sqids_sqids_failures[j++] = err;
         }
 
+        /* decode from a slice followed by valid alphabet characters */
+        n = strlen(enc);
+        buf = malloc(n + 3);
+        memcpy(buf, enc, n);
+        memcpy(buf + n, "abc", 3);
+        k = sqids_decode_len(sqids, buf, n, nums, lengthof(nums));
+
+        if (k == test->num_cnt &&
+            memcmp(nums, test->nums, k * sizeof(nums[0])) == 0) {
+            fputc('.', stdout);
+        } else {
+            fputc('F', stdout);
+
+            (void)asprintf(
+                &err,
+                "%s:%d: "
+                "sqids_decode_len(\"%s\")\n"
+                "  expected: %d numbers,\n"
+                "       got: %d numbers\n",
+                __FILE__,
+                test->line,
+                enc,
+                test->num_cnt,
+                k);
+            sqids_sqids_failures[j++] = err;
+        }
+
+        /* whatever encode produces must be canonical */
+        k = sqids_decode_canonical(sqids, enc, n, nums, lengthof(nums));
+
+        if (k == test->num_cnt &&
+            memcmp(nums, test->nums, k * sizeof(nums[0])) == 0) {
+            fputc('.', stdout);
+        } else {
+            fputc('F', stdout);
+
+            (void)asprintf(
+                &err,
+                "%s:%d: "
+                "sqids_decode_canonical(\"%s\")\n"
+                "  expected: %d numbers,\n"
+                "       got: %d numbers\n",
+                __FILE__,
+                test->line,
+                enc,
+                test->num_cnt,
+                k);
+            sqids_sqids_failures[j++] = err;
+        }
+
+        free(buf);
+        sqids_mem_free(enc);
+        sqids_free(sqids);
+    }
+
+    /* aliases of valid hashes must be rejected */
+    sqids = sqids_new(NULL, 0, NULL);
+    for (i = 0; sqids_sqids_non_canonical[i]; ++i) {
+        buf = sqids_sqids_non_canonical[i];
+        k = sqids_decode_canonical(sqids, buf, strlen(buf), nums,
+            lengthof(nums));
+
+        if (k == -1 && sqids_errno == SQIDS_ERR_NONCANONICAL) {
+            fputc('.', stdout);
+        } else {
+            fputc('F', stdout);
+
+            (void)asprintf(
+                &err,
+                "%s:%d: "
+                "sqids_decode_canonical(\"%s\")\n"
+                "  expected: SQIDS_ERR_NONCANONICAL,\n"
+                "       got: %d\n",
+                __FILE__,
+                __LINE__,
+                buf,
+                k);
+            sqids_sqids_failures[j++] = err;
+        }
+    }
+    sqids_free(sqids);
+
+    /* test exact encoded lengths, including padding across shuffles */
+    for (k = 0; k <= 130; ++k) {
+        unsigned long long lens[] = {0, 1, 60, 61, 3721, 4572721,
+            0xFFFFFFFFFFFFFFFFull};
+
+        sqids = sqids_new(NULL, k, sqids_bl_list_all(NULL));
+
+        for (i = 0; i < lengthof(lens); ++i) {
+            enc = sqids_encode(sqids, i + 1, lens);
+            n = sqids_encoded_len(sqids, i + 1, lens);
+
+            if (strlen(enc) != n || n < k) {
+                break;
+            }
+
+            sqids_mem_free(enc);
+        }
+
+        sqids_free(sqids);
+
+        if (i < lengthof(lens)) {
+            break;
+        }
+    }
+
+    if (k > 130) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_encoded_len(...) with min_len %d\n"
+            "  expected: %d,\n"
+            "       got: %d\n",
+            __FILE__,
+            __LINE__,
+            k,
+            (int)strlen(enc),
+            n);
+        sqids_sqids_failures[j++] = err;
         sqids_mem_free(enc);
+    }
+
+    /* a min_len too long for the pad table pads the slow way */
+    sqids = sqids_new(NULL, 2000, NULL);
+    enc = sqids ? sqids_encode(sqids, 0, NULL) : NULL;
+    if (enc && strlen(enc) == 2000) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_encode(...) with no numbers and min_len 2000\n"
+            "  expected: a 2000 characters hash\n",
+            __FILE__,
+            __LINE__);
+        sqids_sqids_failures[j++] = err;
+    }
+    sqids_mem_free(enc);
+    if (sqids) {
         sqids_free(sqids);
     }
 
@@ -163,6 +325,60 @@ main(int argc, char **argv)
         sqids_sqids_failures[j++] = err;
     }
 
+    /* speculative retries land where serial ones would - canonical decode
+       replays the serial ones */
+    bl = sqids_bl_new(sqids_bl_match);
+    for (i = 0; i < 10000; i += 37) {
+        word[0] = (i % 2 ? 'A' : 'a') + i / 1000;
+        word[1] = 'a' + i / 100 % 10;
+        word[2] = 'a' + i / 10 % 10;
+        word[3] = 'a' + i % 10;
+        word[4] = 0;
+        sqids_bl_add_tail(bl, word);
+    }
+
+    for (k = 0, r = 1, hits = 0; r && k < 3; ++k) {
+        sqids = sqids_new("abcdefghij", k * 20, sqids_bl_ref(bl));
+        sqids_stats_enable(sqids);
+
+        for (i = 0; r && i < 3000; ++i) {
+            cnt = i % 6 + 1;
+            for (n = 0; n < cnt; ++n) {
+                nums[n] = (unsigned long long)i * (n + 3);
+            }
+
+            if (!(enc = sqids_encode(sqids, cnt, nums))) {
+                r = sqids_errno == SQIDS_ERR_MAX_RETRIES;
+                continue;
+            }
+
+            r = sqids_decode_canonical(sqids, enc, strlen(enc), dec, cnt) ==
+                cnt && memcmp(dec, nums, cnt * sizeof(nums[0])) == 0;
+            sqids_mem_free(enc);
+        }
+
+        /* most of them retried */
+        sqids_stats_snapshot(sqids, &stats);
+        hits += stats.encodes - stats.retries[0];
+        sqids_free(sqids);
+    }
+    sqids_bl_free(bl);
+
+    if (r && hits > 1000) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_encode(...)\n"
+            "  expected: canonical hashes after retries\n",
+            __FILE__,
+            __LINE__);
+        sqids_sqids_failures[j++] = err;
+    }
+
     fputs("\n", stdout);
 
     if (j) {
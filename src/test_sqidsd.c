@@ -0,0 +1,312 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "sqids.h"
+#include "sqidsd.h"
+
+#define SQIDSD_TEST_PATH "test_sqidsd.sock"
+#define SQIDSD_TEST_IDS 500
+
+char *sqidsd_failures[5] = {};
+
+/* connect, waiting for the daemon to come up */
+static int
+sqidsd_test_connect(void)
+{
+    struct sockaddr_un addr;
+    int fd, i;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, SQIDSD_TEST_PATH);
+
+    for (i = 0; i < 500; ++i) {
+        if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+            return -1;
+        }
+
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+            return fd;
+        }
+
+        close(fd);
+        usleep(10000);
+    }
+
+    return -1;
+}
+
+/* append a request header for a payload written after it */
+static char *
+sqidsd_test_req(char *p, char *end, uint32_t seq, uint16_t op, uint16_t ctx,
+    uint32_t cnt)
+{
+    sqidsd_req_t req;
+
+    req.len = end - p - sizeof(req);
+    req.seq = seq;
+    req.op = op;
+    req.ctx = ctx;
+    req.cnt = cnt;
+    memcpy(p, &req, sizeof(req));
+
+    return end;
+}
+
+/* read a response */
+static int
+sqidsd_test_res(int fd, sqidsd_res_t *res, char *buf)
+{
+    size_t n;
+    ssize_t r;
+    char *p;
+
+    for (p = (char *)res, n = sizeof(*res); n; p += r, n -= r) {
+        if ((r = read(fd, p, n)) <= 0) {
+            return -1;
+        }
+    }
+
+    for (p = buf, n = res->len; n; p += r, n -= r) {
+        if ((r = read(fd, p, n)) <= 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    int i, j, k, r, fd, status;
+    pid_t pid;
+    sqids_t *sqids;
+    sqidsd_res_t res;
+    unsigned long long nums[SQIDSD_TEST_IDS][3];
+    char *req, *buf, *big, *p, *q, *exp, *err;
+    int32_t len;
+    size_t n;
+
+    k = 0;
+    sqids = sqids_new(NULL, 8, sqids_bl_list_all(NULL));
+
+    if (!(pid = fork())) {
+        execl("./sqidsd", "sqidsd", "-s", SQIDSD_TEST_PATH, "-j", "2", "-l",
+            "8", NULL);
+        _exit(127);
+    }
+
+    req = malloc(1 << 20);
+    buf = malloc(1 << 20);
+    fd = sqidsd_test_connect();
+
+    /* a batch of tuples encodes the way the library does */
+    for (i = 0, p = req + sizeof(sqidsd_req_t); i < SQIDSD_TEST_IDS; ++i) {
+        p = sqidsd_put_u32(p, i % 3 + 1);
+        for (j = 0; j <= i % 3; ++j) {
+            nums[i][j] = (unsigned long long)i * 0x9E3779B97F4A7C15ull >>
+                (j * 20);
+            p = sqidsd_put_u64(p, nums[i][j]);
+        }
+    }
+    p = sqidsd_test_req(req, p, 7, SQIDSD_OP_ENCODE, 0, SQIDSD_TEST_IDS);
+
+    r = fd >= 0 && write(fd, req, p - req) == p - req &&
+        sqidsd_test_res(fd, &res, buf) == 0 && res.seq == 7 && !res.status &&
+        res.cnt == SQIDSD_TEST_IDS;
+
+    for (i = 0, q = buf; r && i < SQIDSD_TEST_IDS; ++i) {
+        len = (int32_t)sqidsd_get_u32(q);
+        exp = sqids_encode(sqids, i % 3 + 1, nums[i]);
+        r = len == (int32_t)strlen(exp) && memcmp(q + 4, exp, len) == 0;
+        sqids_mem_free(exp);
+        q += 4 + len;
+    }
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqidsd encode of %d tuples\n"
+            "  expected: the ids sqids_encode produces\n",
+            __FILE__,
+            __LINE__,
+            SQIDSD_TEST_IDS);
+        sqidsd_failures[k++] = err;
+    }
+
+    /* and they decode back, with a bad id in the middle */
+    if (r) {
+        for (i = 0, q = buf, p = req + sizeof(sqidsd_req_t);
+            i < SQIDSD_TEST_IDS; ++i) {
+            len = (int32_t)sqidsd_get_u32(q);
+            if (i == SQIDSD_TEST_IDS / 2) {
+                p = sqidsd_put_u32(p, 3);
+                memcpy(p, "a-b", 3);
+                p += 3;
+            }
+
+            p = sqidsd_put_u32(p, len);
+            memcpy(p, q + 4, len);
+            p += len;
+            q += 4 + len;
+        }
+        p = sqidsd_test_req(req, p, 8, SQIDSD_OP_DECODE_CANONICAL, 0,
+            SQIDSD_TEST_IDS + 1);
+
+        r = write(fd, req, p - req) == p - req &&
+            sqidsd_test_res(fd, &res, buf) == 0 && res.seq == 8 &&
+            !res.status && res.cnt == SQIDSD_TEST_IDS + 1;
+
+        for (i = 0, q = buf; r && i < SQIDSD_TEST_IDS; ++i) {
+            if (i == SQIDSD_TEST_IDS / 2) {
+                r = (int32_t)sqidsd_get_u32(q) == -SQIDS_ERR_INVALID;
+                q += 4;
+            }
+
+            r = r && (int32_t)sqidsd_get_u32(q) == i % 3 + 1;
+            for (j = 0, q += 4; r && j <= i % 3; ++j, q += 8) {
+                r = sqidsd_get_u64(q) == nums[i][j];
+            }
+        }
+    }
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqidsd decode of %d ids and an invalid one\n"
+            "  expected: the encoded tuples, and SQIDS_ERR_INVALID\n",
+            __FILE__,
+            __LINE__,
+            SQIDSD_TEST_IDS);
+        sqidsd_failures[k++] = err;
+    }
+
+    /* pipelined requests come back in order, bad ones with a status */
+    p = req;
+    q = sqidsd_put_u32(p + sizeof(sqidsd_req_t), 1);
+    p = sqidsd_test_req(p, sqidsd_put_u64(q, 1), 1, SQIDSD_OP_ENCODE, 3, 1);
+    p = sqidsd_test_req(p, p + sizeof(sqidsd_req_t), 2, 9, 0, 0);
+    q = sqidsd_put_u32(p + sizeof(sqidsd_req_t), 2);
+    p = sqidsd_test_req(p, sqidsd_put_u64(q, 1), 3, SQIDSD_OP_ENCODE, 0, 1);
+    q = sqidsd_put_u32(p + sizeof(sqidsd_req_t), 1);
+    p = sqidsd_test_req(p, sqidsd_put_u64(q, 1), 4, SQIDSD_OP_ENCODE, 0, 1);
+
+    r = fd >= 0 && write(fd, req, p - req) == p - req;
+    r = r && sqidsd_test_res(fd, &res, buf) == 0 && res.seq == 1 &&
+        res.status == SQIDSD_ERR_CTX && !res.len;
+    r = r && sqidsd_test_res(fd, &res, buf) == 0 && res.seq == 2 &&
+        res.status == SQIDSD_ERR_OP;
+    r = r && sqidsd_test_res(fd, &res, buf) == 0 && res.seq == 3 &&
+        res.status == SQIDSD_ERR_PAYLOAD;
+    r = r && sqidsd_test_res(fd, &res, buf) == 0 && res.seq == 4 &&
+        !res.status && res.cnt == 1 && sqidsd_get_u32(buf) == 8;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqidsd pipelined requests\n"
+            "  expected: bad context, op and payload, then an id\n",
+            __FILE__,
+            __LINE__);
+        sqidsd_failures[k++] = err;
+    }
+
+    /* empty tuples padded to 8 characters add up past the frame limit */
+    n = SQIDSD_FRAME_MAX / (4 + 8) + 1;
+    r = fd >= 0 && (big = malloc(sizeof(sqidsd_req_t) + n * 4)) != NULL;
+    if (r) {
+        memset(big + sizeof(sqidsd_req_t), 0, n * 4);
+        p = sqidsd_test_req(big, big + sizeof(sqidsd_req_t) + n * 4, 5,
+            SQIDSD_OP_ENCODE, 0, n);
+        r = write(fd, big, p - big) == p - big &&
+            sqidsd_test_res(fd, &res, buf) == 0 && res.seq == 5 &&
+            res.status == SQIDSD_ERR_PAYLOAD && !res.len && !res.cnt;
+        free(big);
+    }
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqidsd response above SQIDSD_FRAME_MAX\n"
+            "  expected: SQIDSD_ERR_PAYLOAD\n",
+            __FILE__,
+            __LINE__);
+        sqidsd_failures[k++] = err;
+    }
+
+    /* a clean shutdown */
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    r = kill(pid, SIGTERM) == 0 && waitpid(pid, &status, 0) == pid &&
+        WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+        access(SQIDSD_TEST_PATH, F_OK) != 0;
+
+    if (r) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqidsd on SIGTERM\n"
+            "  expected: exit status 0, socket removed\n",
+            __FILE__,
+            __LINE__);
+        sqidsd_failures[k++] = err;
+    }
+
+    free(buf);
+    free(req);
+    sqids_free(sqids);
+
+    fputs("\n", stdout);
+
+    if (k) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqidsd_failures[i]) {
+            break;
+        }
+
+        fputs(sqidsd_failures[i], stderr);
+        free(sqidsd_failures[i]);
+    }
+
+    return k;
+}
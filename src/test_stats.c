@@ -0,0 +1,164 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "sqids.h"
+
+#ifndef lengthof
+#define lengthof(x) ((size_t)(sizeof(x) / sizeof(x[0])))
+#endif
+
+#define SQIDS_STATS_TEST_THREADS 8
+#define SQIDS_STATS_TEST_ENCODES 1000
+
+char *sqids_stats_failures[8] = {};
+
+sqids_t *sqids_stats_test_sqids;
+
+static void *
+sqids_stats_test_thread(void *arg)
+{
+    unsigned long long num;
+    char buf[32];
+
+    for (num = 0; num < SQIDS_STATS_TEST_ENCODES; ++num) {
+        sqids_encode_buf(sqids_stats_test_sqids, buf, 1, &num);
+    }
+
+    return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+    int i, j, cnt;
+    sqids_t *sqids;
+    sqids_bl_t *bl;
+    sqids_stats_t stats;
+    unsigned long long hits[4], nums[4];
+    pthread_t threads[SQIDS_STATS_TEST_THREADS];
+    char *enc, *err;
+
+    j = 0;
+
+    /* one retry through the second word */
+    bl = sqids_bl_new(sqids_bl_match);
+    sqids_bl_add_tail(bl, "xxxx");
+    sqids_bl_add_tail(bl, "86Rf07");
+    sqids = sqids_new(NULL, 0, bl);
+
+    if (sqids_stats_snapshot(sqids, &stats) == -1 &&
+        sqids_stats_enable(sqids) == 0) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_stats_enable(...)\n"
+            "  expected: counters off until enabled\n",
+            __FILE__,
+            __LINE__);
+        sqids_stats_failures[j++] = err;
+    }
+
+    enc = sqids_vencode(sqids, 3, 1ull, 2ull, 3ull);
+    sqids_decode(sqids, enc, nums, lengthof(nums));
+    sqids_decode(sqids, "!!", nums, lengthof(nums));
+    sqids_decode(sqids, "zzzzzzzzzzzzzzz", nums, lengthof(nums));
+
+    sqids_stats_snapshot(sqids, &stats);
+    cnt = sqids_stats_bl_hits(sqids, hits, lengthof(hits));
+
+    if (strcmp(enc, "se8ojk") == 0 && stats.encodes == 1 &&
+        stats.bytes == 6 && stats.retries[0] == 0 && stats.retries[1] == 1 &&
+        stats.decodes == 3 && stats.invalid == 1 && stats.overflows == 1 &&
+        cnt == 2 && hits[0] == 0 && hits[1] == 1) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_stats_snapshot(...)\n"
+            "  expected: 1 encode (6 bytes, 1 retry on word #1), 3 decodes "
+            "(1 invalid, 1 overflow)\n"
+            "       got: %llu encodes (%llu bytes, %llu retried), %llu "
+            "decodes (%llu invalid, %llu overflows), %d words\n",
+            __FILE__,
+            __LINE__,
+            stats.encodes,
+            stats.bytes,
+            stats.retries[1],
+            stats.decodes,
+            stats.invalid,
+            stats.overflows,
+            cnt);
+        sqids_stats_failures[j++] = err;
+    }
+
+    sqids_mem_free(enc);
+    sqids_free(sqids);
+
+    /* no counts are lost across threads */
+    sqids = sqids_new(NULL, 0, NULL);
+    sqids_stats_enable(sqids);
+    sqids_stats_test_sqids = sqids;
+
+    for (i = 0; i < SQIDS_STATS_TEST_THREADS; ++i) {
+        pthread_create(&threads[i], NULL, sqids_stats_test_thread, NULL);
+    }
+
+    for (i = 0; i < SQIDS_STATS_TEST_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    sqids_stats_snapshot(sqids, &stats);
+
+    if (stats.encodes == SQIDS_STATS_TEST_THREADS * SQIDS_STATS_TEST_ENCODES &&
+        stats.retries[0] == stats.encodes &&
+        sqids_stats_bl_hits(sqids, hits, lengthof(hits)) == 0) {
+        fputc('.', stdout);
+    } else {
+        fputc('F', stdout);
+
+        (void)asprintf(
+            &err,
+            "%s:%d: "
+            "sqids_stats_snapshot(...) from %d threads\n"
+            "  expected: %d encodes,\n"
+            "       got: %llu\n",
+            __FILE__,
+            __LINE__,
+            SQIDS_STATS_TEST_THREADS,
+            SQIDS_STATS_TEST_THREADS * SQIDS_STATS_TEST_ENCODES,
+            stats.encodes);
+        sqids_stats_failures[j++] = err;
+    }
+
+    sqids_free(sqids);
+
+    fputs("\n", stdout);
+
+    if (j) {
+        fputs("\n", stdout);
+    }
+
+    for (i = 0;; ++i) {
+        if (!sqids_stats_failures[i]) {
+            break;
+        }
+
+        fputs(sqids_stats_failures[i], stderr);
+        free(sqids_stats_failures[i]);
+    }
+
+    return j;
+}